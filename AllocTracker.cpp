@@ -0,0 +1,84 @@
+//-----------------------------------------------------------------------------
+//   AllocTracker.cpp
+//   Heap allocation counts per bridge method (debug builds with
+//   GSSWMM_ALLOC_TRACKING)
+//-----------------------------------------------------------------------------
+
+#include "include/AllocTracker.h"
+
+int AllocTracker::MethodFromID(int methodID) {
+    switch (methodID) {
+    case 0: return M_INITIALIZE;     // XF_INITIALIZE
+    case 1: return M_CALCULATE;      // XF_CALCULATE
+    case 2: return M_REP_VERSION;    // XF_REP_VERSION
+    case 3: return M_REP_ARGUMENTS;  // XF_REP_ARGUMENTS
+    case 99: return M_CLEANUP;       // XF_CLEANUP
+    default: return M_OTHER;
+    }
+}
+
+const char* AllocTracker::MethodName(int method) {
+    static const char* names[M_COUNT] = {
+        "XF_INITIALIZE", "XF_CALCULATE", "XF_REP_VERSION", "XF_REP_ARGUMENTS", "XF_CLEANUP", "other"
+    };
+    return (method >= 0 && method < M_COUNT) ? names[method] : "unknown";
+}
+
+#ifdef GSSWMM_ALLOC_TRACKING
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<int64_t> s_calls[AllocTracker::M_COUNT];
+static std::atomic<int64_t> s_allocs[AllocTracker::M_COUNT];
+static std::atomic<int64_t> s_bytes[AllocTracker::M_COUNT];
+static thread_local int t_method = -1;   // Scope in force on this thread, -1 = not counted
+
+AllocTracker::Scope::Scope(int method) : previous_(t_method) { t_method = method; }
+AllocTracker::Scope::~Scope() { t_method = previous_; }
+
+void AllocTracker::CountCall(int method) { s_calls[method].fetch_add(1, std::memory_order_relaxed); }
+
+AllocStats AllocTracker::Get(int method) {
+    AllocStats s;
+    s.calls = s_calls[method].load(std::memory_order_relaxed);
+    s.allocs = s_allocs[method].load(std::memory_order_relaxed);
+    s.bytes = s_bytes[method].load(std::memory_order_relaxed);
+    return s;
+}
+
+void AllocTracker::Reset() {
+    for (int m = 0; m < M_COUNT; m++) {
+        s_calls[m].store(0, std::memory_order_relaxed);
+        s_allocs[m].store(0, std::memory_order_relaxed);
+        s_bytes[m].store(0, std::memory_order_relaxed);
+    }
+}
+
+static void* CountedAlloc(size_t size) {
+    int m = t_method;
+    if (m >= 0) {
+        s_allocs[m].fetch_add(1, std::memory_order_relaxed);
+        s_bytes[m].fetch_add((int64_t)size, std::memory_order_relaxed);
+    }
+    return malloc(size ? size : 1);
+}
+
+//--- Global replacements (plain and array forms; aligned ones keep the default)
+
+void* operator new(size_t size) {
+    if (void* p = CountedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p); }
+
+#endif
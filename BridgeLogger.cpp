@@ -0,0 +1,189 @@
+//-----------------------------------------------------------------------------
+//   BridgeLogger.cpp
+//   Asynchronous ring-buffer logger for the GoldSim-SWMM bridge
+//-----------------------------------------------------------------------------
+
+#include "include/Platform.h"
+#include "include/BridgeLogger.h"
+#include <chrono>
+#include <cstring>
+
+#define WRITER_INTERVAL_MS 50      // max latency before queued records hit the file
+#define WRITER_WAKE_THRESHOLD 256  // producers nudge the writer at this backlog
+#define SHUTDOWN_WAIT_MS 1000      // destructor wait for the writer to exit
+
+BridgeLogger::BridgeLogger(const char* path, const char* header)
+    : path_(path), header_(header ? header : ""), slots_(new Slot[kCapacity]),
+      enqueue_pos_(0), dequeue_pos_(0), running_(false), stop_(false), writer_done_(true),
+      file_(NULL), truncate_on_open_(true), written_(0), dropped_(0), dropped_reported_(0) {
+    for (int i = 0; i < kCapacity; i++) {
+        slots_[i].seq.store((size_t)i, std::memory_order_relaxed);
+        slots_[i].len = 0;
+    }
+}
+
+BridgeLogger::~BridgeLogger() {
+    // Joining a thread from a DLL's static destructor can deadlock on the
+    // loader lock, so ask the writer to exit, wait briefly, and detach.
+    if (writer_.joinable()) {
+        stop_.store(true);
+        wake_.notify_one();
+        for (int waited = 0; !writer_done_.load() && waited < SHUTDOWN_WAIT_MS; waited++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        writer_.detach();
+    }
+    if (writer_done_.load()) {
+        std::lock_guard<std::mutex> lock(io_mutex_);
+        DrainLocked();
+        if (file_) { fclose(file_); file_ = NULL; }
+    }
+    delete[] slots_;
+}
+
+//-----------------------------------------------------------------------------
+// Ring buffer (bounded MPMC queue with per-slot sequence numbers)
+//-----------------------------------------------------------------------------
+
+bool BridgeLogger::TryPush(const char* text, int len) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot* slot = &slots_[pos & (kCapacity - 1)];
+        size_t seq = slot->seq.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                memcpy(slot->text, text, (size_t)len);
+                slot->len = len;
+                slot->seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // full
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool BridgeLogger::TryPop(Slot*& slot, size_t& pos) {
+    pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        slot = &slots_[pos & (kCapacity - 1)];
+        size_t seq = slot->seq.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return true;
+        } else if (diff < 0) {
+            return false;  // empty
+        } else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void BridgeLogger::Release(Slot* slot, size_t pos) {
+    slot->seq.store(pos + kCapacity, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// Producer side
+//-----------------------------------------------------------------------------
+
+void BridgeLogger::Write(const char* tag, const char* fmt, va_list ap) {
+    EnsureStarted();
+
+    char buf[kRecordSize];
+    SYSTEMTIME st; GetLocalTime(&st);
+    int n = snprintf(buf, sizeof(buf), "[%02d:%02d:%02d] [%s] ", st.wHour, st.wMinute, st.wSecond, tag);
+    if (n < 0) return;
+    int m = vsnprintf(buf + n, sizeof(buf) - n, fmt, ap);
+    if (m < 0) m = 0;
+    int len = n + m;
+    if (len > kRecordSize - 1) len = kRecordSize - 1;  // truncated: overwrite the terminator with '\n'
+    buf[len++] = '\n';
+
+    if (!TryPush(buf, len)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        wake_.notify_one();
+        return;
+    }
+    size_t backlog = enqueue_pos_.load(std::memory_order_relaxed) - dequeue_pos_.load(std::memory_order_relaxed);
+    if (backlog >= WRITER_WAKE_THRESHOLD) wake_.notify_one();
+}
+
+void BridgeLogger::EnsureStarted() {
+    if (running_.load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (running_.load()) return;
+    stop_.store(false);
+    writer_done_.store(false);
+    writer_ = std::thread(&BridgeLogger::WriterLoop, this);
+    running_.store(true, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// Consumer side
+//-----------------------------------------------------------------------------
+
+void BridgeLogger::OpenFileLocked() {
+    if (file_) return;
+    if (fopen_s(&file_, path_.c_str(), truncate_on_open_ ? "w" : "a") != 0) file_ = NULL;
+    if (file_ && truncate_on_open_ && !header_.empty()) fprintf(file_, "%s\n", header_.c_str());
+    truncate_on_open_ = false;
+}
+
+void BridgeLogger::ReportDropsLocked() {
+    unsigned long long dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped == dropped_reported_) return;
+    OpenFileLocked();
+    if (!file_) return;
+    SYSTEMTIME st; GetLocalTime(&st);
+    fprintf(file_, "[%02d:%02d:%02d] [ERROR] Log ring buffer full: %llu records dropped (%llu total)\n",
+            st.wHour, st.wMinute, st.wSecond, dropped - dropped_reported_, dropped);
+    dropped_reported_ = dropped;
+}
+
+int BridgeLogger::DrainLocked() {
+    int count = 0;
+    Slot* slot; size_t pos;
+    while (TryPop(slot, pos)) {
+        OpenFileLocked();
+        if (file_) fwrite(slot->text, 1, (size_t)slot->len, file_);
+        Release(slot, pos);
+        count++;
+    }
+    ReportDropsLocked();
+    if (count > 0) written_.fetch_add((unsigned long long)count, std::memory_order_relaxed);
+    return count;
+}
+
+void BridgeLogger::WriterLoop() {
+    std::unique_lock<std::mutex> lock(io_mutex_);
+    while (!stop_.load()) {
+        wake_.wait_for(lock, std::chrono::milliseconds(WRITER_INTERVAL_MS));
+        if (DrainLocked() > 0 && file_) fflush(file_);
+    }
+    DrainLocked();
+    if (file_) { fclose(file_); file_ = NULL; }
+    writer_done_.store(true);
+}
+
+void BridgeLogger::Flush() {
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    DrainLocked();
+    if (file_) fflush(file_);
+}
+
+void BridgeLogger::Shutdown() {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (!running_.load()) { Flush(); return; }
+    {
+        // Hold io_mutex_ while setting stop_ so the writer cannot miss the wakeup
+        std::lock_guard<std::mutex> io_lock(io_mutex_);
+        stop_.store(true);
+    }
+    wake_.notify_one();
+    writer_.join();
+    running_.store(false);
+}
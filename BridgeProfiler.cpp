@@ -0,0 +1,124 @@
+//-----------------------------------------------------------------------------
+//   BridgeProfiler.cpp
+//   Per-phase latency histograms for the GoldSim-SWMM bridge
+//-----------------------------------------------------------------------------
+
+#include "include/Platform.h"
+#include "include/BridgeProfiler.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#define SUB_BUCKET_BITS 5                      // 32 buckets per power of two
+#define SUB_BUCKETS (1 << SUB_BUCKET_BITS)
+#define LINEAR_LIMIT (2 * SUB_BUCKETS)         // values below this are exact
+
+static int HighestBit(uint64_t v) {
+    int bit = 0;
+    while (v >>= 1) bit++;
+    return bit;
+}
+
+LatencyHistogram::LatencyHistogram() { Reset(); }
+
+int LatencyHistogram::BucketIndex(uint64_t ns) {
+    if (ns < LINEAR_LIMIT) return (int)ns;
+    int shift = HighestBit(ns) - SUB_BUCKET_BITS;   // ns >> shift is in [32, 63]
+    return LINEAR_LIMIT + (shift - 1) * SUB_BUCKETS + (int)((ns >> shift) - SUB_BUCKETS);
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(int index) {
+    if (index < LINEAR_LIMIT) return (uint64_t)index;
+    int shift = (index - LINEAR_LIMIT) / SUB_BUCKETS + 1;
+    uint64_t sub = (uint64_t)((index - LINEAR_LIMIT) % SUB_BUCKETS + SUB_BUCKETS);
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t ns) {
+    buckets_[BucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t prev = max_.load(std::memory_order_relaxed);
+    while (ns > prev && !max_.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {}
+}
+
+void LatencyHistogram::Reset() {
+    for (int i = 0; i < kBucketCount; i++) buckets_[i].store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    total_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::GetPercentile(double q) const {
+    uint64_t count = GetCount();
+    if (count == 0) return 0;
+    uint64_t rank = (uint64_t)std::ceil(q * (double)count);
+    if (rank < 1) rank = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; i++) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            uint64_t bound = BucketUpperBound(i);
+            return bound < GetMax() ? bound : GetMax();
+        }
+    }
+    return GetMax();
+}
+
+uint64_t BridgeProfiler::Now() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* BridgeProfiler::PhaseName(int phase) {
+    static const char* names[PH_COUNT] = {
+        "mapping_load", "swmm_open", "swmm_start", "resolve", "input_apply",
+        "swmm_step", "output_gather", "logging", "calculate"
+    };
+    return (phase >= 0 && phase < PH_COUNT) ? names[phase] : "unknown";
+}
+
+void BridgeProfiler::Reset() {
+    for (int k = 0; k < PH_COUNT; k++) phases_[k].Reset();
+    realizations_ = 0;
+}
+
+/**
+ * @brief Write the run summary as JSON (times in microseconds unless noted)
+ * @note "swmm_ms" covers swmm_open, swmm_start and swmm_step; "bridge_ms"
+ *       covers the bridge's own phases (mapping, resolution, inputs, outputs,
+ *       logging). XF_CALCULATE as a whole is reported separately.
+ */
+bool BridgeProfiler::WriteSummary(const char* path) const {
+    FILE* f = NULL;
+    if (fopen_s(&f, path, "w") != 0 || !f) return false;
+
+    const int swmm_phases[] = { PH_SWMM_OPEN, PH_SWMM_START, PH_SWMM_STEP };
+    const int bridge_phases[] = { PH_MAPPING_LOAD, PH_RESOLVE, PH_INPUT_APPLY, PH_OUTPUT_GATHER, PH_LOGGING };
+    double swmm_ms = 0.0, bridge_ms = 0.0;
+    for (int k : swmm_phases) swmm_ms += phases_[k].GetTotal() / 1e6;
+    for (int k : bridge_phases) bridge_ms += phases_[k].GetTotal() / 1e6;
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"realizations\": %d,\n", realizations_);
+    fprintf(f, "  \"calculate_calls\": %llu,\n", (unsigned long long)phases_[PH_CALCULATE].GetCount());
+    fprintf(f, "  \"swmm_step_calls\": %llu,\n", (unsigned long long)phases_[PH_SWMM_STEP].GetCount());
+    fprintf(f, "  \"swmm_ms\": %.3f,\n", swmm_ms);
+    fprintf(f, "  \"bridge_ms\": %.3f,\n", bridge_ms);
+    fprintf(f, "  \"bridge_overhead_fraction\": %.4f,\n", (swmm_ms + bridge_ms) > 0.0 ? bridge_ms / (swmm_ms + bridge_ms) : 0.0);
+    fprintf(f, "  \"phases\": {\n");
+    for (int k = 0; k < PH_COUNT; k++) {
+        const LatencyHistogram& h = phases_[k];
+        uint64_t n = h.GetCount();
+        fprintf(f, "    \"%s\": {\"count\": %llu, \"total_ms\": %.3f, \"mean_us\": %.3f, "
+                   "\"p50_us\": %.3f, \"p99_us\": %.3f, \"max_us\": %.3f}%s\n",
+                PhaseName(k), (unsigned long long)n, h.GetTotal() / 1e6,
+                n ? h.GetTotal() / 1e3 / (double)n : 0.0,
+                h.GetPercentile(0.50) / 1e3, h.GetPercentile(0.99) / 1e3, h.GetMax() / 1e3,
+                k + 1 < PH_COUNT ? "," : "");
+    }
+    fprintf(f, "  }\n");
+    fprintf(f, "}\n");
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,172 @@
+//-----------------------------------------------------------------------------
+//   CallTrace.cpp
+//   Binary trace of SwmmGoldSimBridge calls, for headless replay
+//-----------------------------------------------------------------------------
+
+#include "include/Platform.h"
+#include "include/CallTrace.h"
+#include <cstring>
+
+static const char kMagic[4] = { 'G', 'S', 'C', 'T' };
+
+static size_t Padded(size_t bytes) { return (bytes + 7) & ~(size_t)7; }
+
+//=============================================================================
+// CallTraceWriter
+//=============================================================================
+
+CallTraceWriter::CallTraceWriter()
+    : file_(NULL), config_hash_(0), model_hash_(0), calls_(0), used_(0), failed_(false) {}
+
+CallTraceWriter::~CallTraceWriter() { Close(); }
+
+bool CallTraceWriter::Open(const char* path, uint64_t config_hash, uint64_t model_hash, int input_count,
+                           int output_count, std::string& error) {
+    Close();
+    if (fopen_s(&file_, path, "wb") != 0 || !file_) {
+        file_ = NULL;
+        error = std::string("Cannot open ") + path;
+        return false;
+    }
+    path_ = path;
+    config_hash_ = config_hash;
+    model_hash_ = model_hash;
+    calls_ = 0;
+    buffer_.resize(kBufferBytes);
+    used_ = 0;
+    failed_ = false;
+
+    CallTraceHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = CALL_TRACE_FORMAT_VERSION;
+    h.header_size = sizeof(CallTraceHeader);
+    h.record_header_size = sizeof(CallTraceRecord);
+    h.config_hash = config_hash;
+    h.model_hash = model_hash;
+    h.input_count = input_count;
+    h.output_count = output_count;
+    Append(&h, sizeof(h));
+    return true;
+}
+
+void CallTraceWriter::WriteBuffer() {
+    if (used_ > 0 && fwrite(buffer_.data(), 1, used_, file_) != used_) failed_ = true;
+    used_ = 0;
+}
+
+void CallTraceWriter::Append(const void* data, size_t bytes) {
+    if (used_ + bytes > buffer_.size()) WriteBuffer();
+    if (bytes > buffer_.size()) {
+        // Wider than the whole buffer: straight to the file
+        if (fwrite(data, 1, bytes, file_) != bytes) failed_ = true;
+        return;
+    }
+    memcpy(&buffer_[used_], data, bytes);
+    used_ += bytes;
+}
+
+void CallTraceWriter::Record(int method, int status, const double* inargs, int inputs, const double* outargs,
+                             int outputs, const char* message) {
+    if (!file_) return;
+    CallTraceRecord r;
+    memset(&r, 0, sizeof(r));
+    r.method = method;
+    r.status = status;
+    r.inputs = inargs ? inputs : 0;
+    r.outputs = outargs ? outputs : 0;
+    r.message_size = message ? (int32_t)strlen(message) : 0;
+    Append(&r, sizeof(r));
+    if (r.inputs > 0) Append(inargs, (size_t)r.inputs * sizeof(double));
+    if (r.outputs > 0) Append(outargs, (size_t)r.outputs * sizeof(double));
+    if (r.message_size > 0) {
+        static const char kZeros[8] = {};
+        Append(message, (size_t)r.message_size);
+        Append(kZeros, Padded((size_t)r.message_size) - (size_t)r.message_size);
+    }
+    calls_++;
+}
+
+bool CallTraceWriter::Flush(std::string& error) {
+    if (!file_) return true;
+    WriteBuffer();
+    if (fflush(file_) != 0) failed_ = true;
+    bool ok = !failed_;
+    if (!ok) error = std::string("Write to ") + path_ + " failed";
+    failed_ = false;
+    return ok;
+}
+
+void CallTraceWriter::Close() {
+    if (!file_) return;
+    WriteBuffer();
+    fclose(file_);
+    file_ = NULL;
+    path_.clear();
+}
+
+//=============================================================================
+// CallTraceReader
+//=============================================================================
+
+CallTraceReader::CallTraceReader() : truncated_(false) { memset(&header_, 0, sizeof(header_)); }
+
+void CallTraceReader::Close() {
+    file_.Close();
+    calls_.clear();
+    memset(&header_, 0, sizeof(header_));
+    truncated_ = false;
+}
+
+bool CallTraceReader::Open(const char* path, std::string& error) {
+    Close();
+    if (!file_.Open(path)) {
+        error = std::string("Cannot open ") + path;
+        return false;
+    }
+    const char* data = file_.GetData();
+    const size_t size = file_.GetSize();
+    const CallTraceHeader* h = (const CallTraceHeader*)data;
+    if (size < sizeof(CallTraceHeader) || memcmp(h->magic, kMagic, 4) != 0)
+        error = "Not a call trace";
+    else if (h->version != CALL_TRACE_FORMAT_VERSION || h->header_size != sizeof(CallTraceHeader) ||
+             h->record_header_size != sizeof(CallTraceRecord))
+        error = "Unsupported call trace format version";
+    else if (h->input_count < 0 || h->output_count < 0)
+        error = "Corrupt call trace header";
+    if (!error.empty()) {
+        error += std::string(" (") + path + ")";
+        file_.Close();
+        return false;
+    }
+    header_ = *h;
+
+    // Walk the calls; stop at the first one that is incomplete
+    size_t pos = sizeof(CallTraceHeader);
+    while (pos < size) {
+        const CallTraceRecord* r = (const CallTraceRecord*)(data + pos);
+        size_t body = pos + sizeof(CallTraceRecord);
+        if (body > size || r->inputs < 0 || r->outputs < 0 || r->message_size < 0) {
+            truncated_ = true;
+            break;
+        }
+        size_t values = ((size_t)r->inputs + (size_t)r->outputs) * sizeof(double);
+        size_t end = body + values + Padded((size_t)r->message_size);
+        if (end > size) {
+            truncated_ = true;
+            break;
+        }
+        Call c;
+        c.method = r->method;
+        c.status = r->status;
+        c.inargs = (const double*)(data + body);
+        c.inputs = r->inputs;
+        c.outargs = c.inargs + r->inputs;
+        c.outputs = r->outputs;
+        c.message = data + body + values;
+        c.message_size = r->message_size;
+        calls_.push_back(c);
+        pos = end;
+    }
+    return true;
+}
@@ -0,0 +1,60 @@
+//-----------------------------------------------------------------------------
+//   ForkServer.cpp
+//   Runs tasks in copy-on-write child processes of a prepared parent (POSIX)
+//-----------------------------------------------------------------------------
+
+#include "include/ForkServer.h"
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+ForkServer::ForkServer() : wall_seconds_(0.0) {}
+
+int ForkServer::Run(int count, int workers, TaskFunction task, void* context) {
+    exit_codes_.assign(count > 0 ? (size_t)count : 0, -1);
+    if (workers < 1) workers = 1;
+    auto t0 = std::chrono::steady_clock::now();
+
+    // Anything the parent still has buffered would otherwise be written once per child
+    fflush(NULL);
+
+    std::map<pid_t, int> running;   // child -> task
+    int next = 0, failed = 0;
+    while (next < count || !running.empty()) {
+        while (next < count && (int)running.size() < workers) {
+            pid_t pid = fork();
+            if (pid == 0) _exit(task(next, context));
+            if (pid < 0) {
+                failed++;           // exit code stays -1
+            } else {
+                running[pid] = next;
+            }
+            next++;
+        }
+        if (running.empty()) continue;
+
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) break;         // no children left to wait for
+        auto it = running.find(pid);
+        if (it == running.end()) continue;
+        int code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        exit_codes_[it->second] = code;
+        if (code != 0) failed++;
+        running.erase(it);
+    }
+    wall_seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return failed;
+}
+
+void* ForkServer::SharedAlloc(size_t bytes) {
+    void* p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    return p == MAP_FAILED ? NULL : p;
+}
+
+void ForkServer::SharedFree(void* p, size_t bytes) {
+    if (p) munmap(p, bytes);
+}
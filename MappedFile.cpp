@@ -0,0 +1,70 @@
+//-----------------------------------------------------------------------------
+//   MappedFile.cpp
+//   Read-only memory mapping of a whole file
+//-----------------------------------------------------------------------------
+
+#include "include/Platform.h"
+#include "include/MappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : view_(NULL), size_(0) {}
+
+MappedFile::~MappedFile() { Close(); }
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const char* path) {
+    Close();
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER len;
+    if (GetFileSizeEx(file, &len) && len.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            view_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);   // the view keeps the mapping alive
+        }
+        if (view_) size_ = (size_t)len.QuadPart;
+    }
+    CloseHandle(file);
+    return view_ != NULL;
+}
+
+void MappedFile::Close() {
+    if (view_) UnmapViewOfFile(view_);
+    view_ = NULL;
+    size_ = 0;
+}
+
+#else
+
+bool MappedFile::Open(const char* path) {
+    Close();
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED) {
+            view_ = view;
+            size_ = (size_t)st.st_size;
+        }
+    }
+    close(fd);   // the mapping stays valid
+    return view_ != NULL;
+}
+
+void MappedFile::Close() {
+    if (view_) munmap(view_, size_);
+    view_ = NULL;
+    size_ = 0;
+}
+
+#endif
@@ -4,152 +4,427 @@
 //-----------------------------------------------------------------------------
 
 #include "include/MappingLoader.h"
+#include <algorithm>
 #include <fstream>
-#include <sstream>
+#include <cstdlib>
+#include <cstring>
 #include <cctype>
 
-static std::string trim(const std::string& str) {
-    size_t start = 0, end = str.length();
-    while (start < end && std::isspace((unsigned char)str[start])) start++;
-    while (end > start && std::isspace((unsigned char)str[end - 1])) end--;
-    return str.substr(start, end - start);
-}
+//-----------------------------------------------------------------------------
+// Single-pass JSON reader
+//
+// Walks the file buffer once, front to back. Keys and values are handed out
+// as views into the buffer; the only copies made are the strings stored in
+// the mapping (short names fit the std::string small-buffer, so most entries
+// allocate nothing). Values the loader does not know are skipped, including
+// nested objects/arrays and strings containing brackets or escapes.
+//-----------------------------------------------------------------------------
 
-static std::string extractString(const std::string& val) {
-    std::string t = trim(val);
-    if (t.length() >= 2 && t[0] == '"' && t[t.length() - 1] == '"')
-        return t.substr(1, t.length() - 2);
-    return t;
-}
+namespace {
 
-static int extractInt(const std::string& val) {
-    return std::atoi(trim(val).c_str());
-}
+// Non-owning view of part of the file buffer
+struct Slice {
+    const char* p;
+    size_t n;
+    Slice() : p(NULL), n(0) {}
+    bool Is(const char* lit) const { return strncmp(p, lit, n) == 0 && lit[n] == '\0'; }
+};
 
-static std::string findValue(const std::string& json, const std::string& key, std::string& error) {
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    if (keyPos == std::string::npos) { error = "Missing: " + key; return ""; }
-    
-    size_t colonPos = json.find(':', keyPos);
-    if (colonPos == std::string::npos) { error = "Invalid JSON for: " + key; return ""; }
-    
-    size_t valueStart = colonPos + 1;
-    while (valueStart < json.length() && std::isspace((unsigned char)json[valueStart])) valueStart++;
-    if (valueStart >= json.length()) { error = "No value for: " + key; return ""; }
-    
-    size_t valueEnd = valueStart;
-    if (json[valueStart] == '"') {
-        valueEnd = valueStart + 1;
-        while (valueEnd < json.length() && json[valueEnd] != '"') {
-            if (json[valueEnd] == '\\') valueEnd++;
-            valueEnd++;
+class JsonReader {
+public:
+    JsonReader(const char* begin, const char* end) : begin_(begin), p_(begin), end_(end) {}
+
+    bool Ok() const { return error_.empty(); }
+    const std::string& Error() const { return error_; }
+
+    bool Fail(const std::string& what) {
+        if (error_.empty()) {
+            int line = 1;
+            for (const char* c = begin_; c < p_; c++) if (*c == '\n') line++;
+            error_ = "Malformed JSON at line " + std::to_string(line) + ": " + what;
+        }
+        p_ = end_;   // stop all further reads
+        return false;
+    }
+
+    void SkipSpace() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) p_++;
+    }
+
+    bool Consume(char c) {
+        SkipSpace();
+        if (p_ < end_ && *p_ == c) { p_++; return true; }
+        return false;
+    }
+
+    bool Expect(char c) {
+        return Consume(c) || Fail(std::string("expected '") + c + "'");
+    }
+
+    bool AtEnd() { SkipSpace(); return p_ >= end_; }
+
+    /**
+     * @brief Advance to the next member of an object whose '{' was consumed
+     * @return true with the key read and the reader at the value; false at
+     *         the closing '}' or on error (check Ok())
+     */
+    bool NextMember(bool& first, Slice& key) {
+        if (Consume('}')) return false;
+        if (!first && !Expect(',')) return false;
+        first = false;
+        bool escaped;
+        return ReadRawString(key, escaped) && Expect(':');
+    }
+
+    /**
+     * @brief Advance to the next element of an array whose '[' was consumed
+     * @return true with the reader at the element; false at ']' or on error
+     */
+    bool NextElement(bool& first) {
+        if (Consume(']')) return false;
+        if (!first && !Expect(',')) return false;
+        first = false;
+        return true;
+    }
+
+    // String value (unescaped) or literal text (number, true, false, null)
+    bool ReadText(std::string& out) {
+        SkipSpace();
+        Slice s;
+        if (p_ < end_ && *p_ == '"') {
+            bool escaped;
+            if (!ReadRawString(s, escaped)) return false;
+            if (escaped) return Unescape(s, out);
+        } else if (!ReadLiteral(s)) {
+            return false;
         }
-        if (valueEnd < json.length()) valueEnd++;
-    } else if (json[valueStart] == '[') {
-        int depth = 1;
-        valueEnd = valueStart + 1;
-        while (valueEnd < json.length() && depth > 0) {
-            if (json[valueEnd] == '[') depth++;
-            else if (json[valueEnd] == ']') depth--;
-            valueEnd++;
+        out.assign(s.p, s.n);
+        return true;
+    }
+
+    // Integer value; like atoi, any fraction or exponent is ignored
+    bool ReadInt(int& out) {
+        Slice s;
+        if (!ReadLiteral(s)) return false;
+        const char* c = s.p;
+        const char* e = s.p + s.n;
+        bool neg = (c < e && *c == '-');
+        if (neg || (c < e && *c == '+')) c++;
+        if (c >= e || *c < '0' || *c > '9') return Fail("expected an integer");
+        long v = 0;
+        while (c < e && *c >= '0' && *c <= '9' && v < 100000000L) v = v * 10 + (*c++ - '0');
+        out = (int)(neg ? -v : v);
+        return true;
+    }
+
+    // Skip any value, however deeply nested
+    bool SkipValue() {
+        int depth = 0;
+        do {
+            SkipSpace();
+            if (p_ >= end_) return Fail("unexpected end of file");
+            char c = *p_;
+            if (c == '"') {
+                Slice s;
+                bool escaped;
+                if (!ReadRawString(s, escaped)) return false;
+            } else if (c == '{' || c == '[') {
+                depth++;
+                p_++;
+            } else if (depth > 0 && (c == '}' || c == ']')) {
+                depth--;
+                p_++;
+            } else if (depth > 0 && (c == ',' || c == ':')) {
+                p_++;
+            } else {
+                Slice s;
+                if (!ReadLiteral(s)) return false;
+            }
+        } while (depth > 0);
+        return true;
+    }
+
+private:
+    // Contents of a quoted string, escapes left in place
+    bool ReadRawString(Slice& s, bool& escaped) {
+        SkipSpace();
+        if (p_ >= end_ || *p_ != '"') return Fail("expected a string");
+        const char* start = ++p_;
+        escaped = false;
+        while (p_ < end_ && *p_ != '"') {
+            if (*p_ == '\\') { escaped = true; p_++; }
+            p_++;
         }
-    } else {
-        while (valueEnd < json.length() && json[valueEnd] != ',' && json[valueEnd] != '}' && json[valueEnd] != ']')
-            valueEnd++;
+        if (p_ >= end_) return Fail("unterminated string");
+        s.p = start;
+        s.n = (size_t)(p_ - start);
+        p_++;
+        return true;
+    }
+
+    bool ReadLiteral(Slice& s) {
+        SkipSpace();
+        const char* start = p_;
+        while (p_ < end_ && (isalnum((unsigned char)*p_) || *p_ == '-' || *p_ == '+' || *p_ == '.')) p_++;
+        if (p_ == start) return Fail("expected a value");
+        s.p = start;
+        s.n = (size_t)(p_ - start);
+        return true;
     }
-    return json.substr(valueStart, valueEnd - valueStart);
+
+    static int HexDigit(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    static bool ReadHex4(const char* c, const char* e, unsigned& cp) {
+        if (e - c < 4) return false;
+        cp = 0;
+        for (int i = 0; i < 4; i++) {
+            int d = HexDigit(c[i]);
+            if (d < 0) return false;
+            cp = cp * 16 + (unsigned)d;
+        }
+        return true;
+    }
+
+    static void AppendUtf8(std::string& out, unsigned cp) {
+        if (cp < 0x80) {
+            out += (char)cp;
+        } else if (cp < 0x800) {
+            out += (char)(0xC0 | (cp >> 6));
+            out += (char)(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += (char)(0xE0 | (cp >> 12));
+            out += (char)(0x80 | ((cp >> 6) & 0x3F));
+            out += (char)(0x80 | (cp & 0x3F));
+        } else {
+            out += (char)(0xF0 | (cp >> 18));
+            out += (char)(0x80 | ((cp >> 12) & 0x3F));
+            out += (char)(0x80 | ((cp >> 6) & 0x3F));
+            out += (char)(0x80 | (cp & 0x3F));
+        }
+    }
+
+    bool Unescape(const Slice& s, std::string& out) {
+        out.clear();
+        const char* c = s.p;
+        const char* e = s.p + s.n;
+        while (c < e) {
+            if (*c != '\\') { out += *c++; continue; }
+            if (++c >= e) return Fail("bad escape");
+            char k = *c++;
+            switch (k) {
+            case '"': case '\\': case '/': out += k; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                unsigned cp, lo;
+                if (!ReadHex4(c, e, cp)) return Fail("bad \\u escape");
+                c += 4;
+                if (cp >= 0xD800 && cp < 0xDC00 && e - c >= 6 && c[0] == '\\' && c[1] == 'u' &&
+                    ReadHex4(c + 2, e, lo) && lo >= 0xDC00 && lo < 0xE000) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    c += 6;
+                }
+                AppendUtf8(out, cp);
+                break;
+            }
+            default:
+                return Fail(std::string("bad escape '\\") + k + "'");
+            }
+        }
+        return true;
+    }
+
+    const char* begin_;
+    const char* p_;
+    const char* end_;
+    std::string error_;
+};
+
+// Required per-entry fields
+enum {
+    FIELD_INDEX = 1, FIELD_NAME = 2, FIELD_OBJECT_TYPE = 4, FIELD_PROPERTY = 8,
+    FIELDS_REQUIRED = 15
+};
+
+// Per-entry optional fields; false if the key is not one of them
+bool parseOptionalField(JsonReader&, MappingLoader::InputMapping&, const Slice&) { return false; }
+bool parseOptionalField(JsonReader& r, MappingLoader::OutputMapping& item, const Slice& key) {
+    if (key.Is("aggregation")) { r.ReadText(item.aggregation); return true; }
+    return false;
 }
 
 template<typename T>
-static bool parseArray(const std::string& arrayJson, std::vector<T>& items, std::string& error) {
-    items.clear();
-    size_t pos = 0;
-    while (pos < arrayJson.length()) {
-        size_t objStart = arrayJson.find('{', pos);
-        if (objStart == std::string::npos) break;
-        
-        int depth = 1;
-        size_t objEnd = objStart + 1;
-        while (objEnd < arrayJson.length() && depth > 0) {
-            if (arrayJson[objEnd] == '{') depth++;
-            else if (arrayJson[objEnd] == '}') depth--;
-            objEnd++;
-        }
-        if (depth != 0) { error = "Malformed JSON"; return false; }
-        
-        std::string objJson = arrayJson.substr(objStart, objEnd - objStart);
-        T item;
-        std::string err;
-        
-        item.interface_index = extractInt(findValue(objJson, "index", err));
-        if (!err.empty()) { error = err; return false; }
-        
-        item.name = extractString(findValue(objJson, "name", err));
-        if (!err.empty()) { error = err; return false; }
-        
-        item.object_type = extractString(findValue(objJson, "object_type", err));
-        if (!err.empty()) { error = err; return false; }
-        
-        item.property = extractString(findValue(objJson, "property", err));
-        if (!err.empty()) { error = err; return false; }
-        
-        item.swmm_index = -1;
-        items.push_back(item);
-        pos = objEnd;
+bool parseEntry(JsonReader& r, T& item, const char* arrayName, size_t pos, std::string& error) {
+    if (!r.Expect('{')) return false;
+    int seen = 0;
+    bool first = true;
+    Slice key;
+    while (r.NextMember(first, key)) {
+        if (key.Is("index")) { r.ReadInt(item.interface_index); seen |= FIELD_INDEX; }
+        else if (key.Is("name")) { r.ReadText(item.name); seen |= FIELD_NAME; }
+        else if (key.Is("object_type")) { r.ReadText(item.object_type); seen |= FIELD_OBJECT_TYPE; }
+        else if (key.Is("property")) { r.ReadText(item.property); seen |= FIELD_PROPERTY; }
+        else if (!parseOptionalField(r, item, key)) r.SkipValue();
     }
+    if (!r.Ok()) return false;
+    if (seen != FIELDS_REQUIRED) {
+        const char* missing = !(seen & FIELD_INDEX) ? "index" : !(seen & FIELD_NAME) ? "name"
+                            : !(seen & FIELD_OBJECT_TYPE) ? "object_type" : "property";
+        error = std::string("Missing: ") + missing + " (" + arrayName + "[" + std::to_string(pos) + "])";
+        return false;
+    }
+    item.swmm_index = -1;
     return true;
 }
 
-MappingLoader::MappingLoader() : logging_level_("INFO") {}
+template<typename T>
+bool parseArray(JsonReader& r, std::vector<T>& items, const char* arrayName, std::string& error) {
+    items.clear();
+    if (!r.Expect('[')) return false;
+    bool first = true;
+    while (r.NextElement(first)) {
+        items.emplace_back();
+        if (!parseEntry(r, items.back(), arrayName, items.size() - 1, error)) return false;
+    }
+    return r.Ok();
+}
+
+}  // namespace
+
+MappingLoader::MappingLoader()
+    : logging_level_("INFO"), coupling_mode_("STEP"), elapsed_time_units_("SECONDS"), pipelined_stepping_(false),
+      hotstart_spinup_days_(0.0), profiling_(false), plan_cache_(true), output_policy_("FULL"),
+      report_file_("model.rpt"), output_file_("model.out"), series_decimation_(1), recycle_project_(false) {}
 MappingLoader::~MappingLoader() {}
 
 bool MappingLoader::LoadFromFile(const std::string& path, std::string& error) {
     inputs_.clear();
     outputs_.clear();
+    hash_.clear();
     logging_level_ = "INFO";  // Default
+    coupling_mode_ = "STEP";
+    elapsed_time_units_ = "SECONDS";
+    pipelined_stepping_ = false;
+    hotstart_spinup_days_ = 0.0;
+    profiling_ = false;
+    plan_cache_ = true;
+    output_policy_ = "FULL";
+    report_file_ = "model.rpt";
+    output_file_ = "model.out";
+    series_file_.clear();
+    series_decimation_ = 1;
+    recycle_project_ = false;
+    call_trace_.clear();
+    timeline_file_.clear();
     
-    std::ifstream file(path);
+    std::ifstream file(path, std::ios::binary);
     if (!file.is_open()) {
         error = "File not found: " + path + "\nRun: python generate_mapping.py model.inp";
         return false;
     }
     
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string json = buffer.str();
+    // Read the whole file with one allocation
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    std::string json(size > 0 ? (size_t)size : 0, '\0');
+    if (size > 0) file.read(&json[0], size);
     file.close();
     
     if (json.empty()) { error = "Empty file: " + path; return false; }
     
-    std::string t = trim(json);
-    if (t.empty() || t[0] != '{' || t[t.length() - 1] != '}') {
+    JsonReader r(json.data(), json.data() + json.size());
+    if (!r.Consume('{')) {
         error = "Invalid JSON in: " + path;
         return false;
     }
     
-    // Parse version
-    std::string version = extractString(findValue(json, "version", error));
-    if (!error.empty()) return false;
-    if (version != "1.0") { error = "Unsupported version: " + version; return false; }
+    // Even a compact entry takes about 50 bytes of JSON, which bounds a bogus count
+    auto reserveCount = [&json](const std::string& count) {
+        return std::min((size_t)std::max(0, std::atoi(count.c_str())), json.size() / 48);
+    };
     
-    // Parse inputs
-    std::string inputsStr = findValue(json, "inputs", error);
+    bool haveVersion = false, haveInputs = false, haveOutputs = false;
+    std::string version, inputCount, outputCount, text;
+    bool first = true;
+    Slice key;
+    while (r.NextMember(first, key)) {
+        if (key.Is("version")) {
+            haveVersion = r.ReadText(version);
+        } else if (key.Is("inputs")) {
+            if (!parseArray(r, inputs_, "inputs", error)) break;
+            haveInputs = true;
+        } else if (key.Is("outputs")) {
+            if (!parseArray(r, outputs_, "outputs", error)) break;
+            haveOutputs = true;
+        } else if (key.Is("input_count")) {
+            // generate_mapping.py writes the counts before the arrays
+            if (r.ReadText(inputCount)) inputs_.reserve(reserveCount(inputCount));
+        } else if (key.Is("output_count")) {
+            if (r.ReadText(outputCount)) outputs_.reserve(reserveCount(outputCount));
+        } else if (key.Is("inp_file_hash")) {
+            r.ReadText(hash_);
+        } else if (key.Is("logging_level")) {
+            r.ReadText(logging_level_);
+        } else if (key.Is("coupling_mode")) {
+            r.ReadText(coupling_mode_);
+        } else if (key.Is("elapsed_time_units")) {
+            r.ReadText(elapsed_time_units_);
+        } else if (key.Is("pipelined_stepping")) {
+            if (r.ReadText(text)) pipelined_stepping_ = (text == "true");
+        } else if (key.Is("hotstart_spinup_days")) {
+            if (r.ReadText(text)) hotstart_spinup_days_ = std::atof(text.c_str());
+        } else if (key.Is("profiling")) {
+            if (r.ReadText(text)) profiling_ = (text == "true");
+        } else if (key.Is("plan_cache")) {
+            if (r.ReadText(text)) plan_cache_ = (text != "false");
+        } else if (key.Is("output_policy")) {
+            r.ReadText(output_policy_);
+        } else if (key.Is("report_file")) {
+            r.ReadText(report_file_);
+        } else if (key.Is("output_file")) {
+            r.ReadText(output_file_);
+        } else if (key.Is("series_file")) {
+            r.ReadText(series_file_);
+        } else if (key.Is("series_decimation")) {
+            if (r.ReadText(text)) series_decimation_ = std::atoi(text.c_str());
+        } else if (key.Is("recycle_project")) {
+            if (r.ReadText(text)) recycle_project_ = (text == "true");
+        } else if (key.Is("call_trace")) {
+            r.ReadText(call_trace_);
+        } else if (key.Is("timeline_file")) {
+            r.ReadText(timeline_file_);
+        } else {
+            r.SkipValue();
+        }
+    }
     if (!error.empty()) return false;
-    if (!parseArray(inputsStr, inputs_, error)) return false;
+    if (r.Ok() && !r.AtEnd()) r.Fail("unexpected text after the closing '}'");
+    if (!r.Ok()) { error = r.Error() + " (" + path + ")"; return false; }
     
-    // Parse outputs
-    std::string outputsStr = findValue(json, "outputs", error);
-    if (!error.empty()) return false;
-    if (!parseArray(outputsStr, outputs_, error)) return false;
+    if (!haveVersion) { error = "Missing: version"; return false; }
+    if (version != "1.0") { error = "Unsupported version: " + version; return false; }
+    if (!haveInputs) { error = "Missing: inputs"; return false; }
+    if (!haveOutputs) { error = "Missing: outputs"; return false; }
     
-    // Parse logging_level (optional)
-    std::string loggingStr = findValue(json, "logging_level", error);
-    if (error.empty()) {
-        logging_level_ = extractString(loggingStr);
-    } else {
-        logging_level_ = "INFO";  // Default if not specified
-        error.clear();  // Clear error since it's optional
+    // Counts written by generate_mapping.py (optional, checked when present)
+    if (!inputCount.empty() && std::atoi(inputCount.c_str()) != (int)inputs_.size()) {
+        error = "Input count mismatch: input_count is " + inputCount + " but " +
+                std::to_string(inputs_.size()) + " inputs are listed";
+        return false;
+    }
+    if (!outputCount.empty() && std::atoi(outputCount.c_str()) != (int)outputs_.size()) {
+        error = "Output count mismatch: output_count is " + outputCount + " but " +
+                std::to_string(outputs_.size()) + " outputs are listed";
+        return false;
     }
     
     return true;
@@ -157,6 +432,21 @@ bool MappingLoader::LoadFromFile(const std::string& path, std::string& error) {
 
 int MappingLoader::GetInputCount() const { return (int)inputs_.size(); }
 int MappingLoader::GetOutputCount() const { return (int)outputs_.size(); }
+const std::string& MappingLoader::GetHash() const { return hash_; }
 const std::vector<MappingLoader::InputMapping>& MappingLoader::GetInputs() const { return inputs_; }
 const std::vector<MappingLoader::OutputMapping>& MappingLoader::GetOutputs() const { return outputs_; }
 const std::string& MappingLoader::GetLoggingLevel() const { return logging_level_; }
+const std::string& MappingLoader::GetCouplingMode() const { return coupling_mode_; }
+const std::string& MappingLoader::GetElapsedTimeUnits() const { return elapsed_time_units_; }
+bool MappingLoader::GetPipelinedStepping() const { return pipelined_stepping_; }
+double MappingLoader::GetHotstartSpinupDays() const { return hotstart_spinup_days_; }
+bool MappingLoader::GetProfiling() const { return profiling_; }
+bool MappingLoader::GetPlanCache() const { return plan_cache_; }
+const std::string& MappingLoader::GetOutputPolicy() const { return output_policy_; }
+const std::string& MappingLoader::GetReportFile() const { return report_file_; }
+const std::string& MappingLoader::GetOutputFile() const { return output_file_; }
+const std::string& MappingLoader::GetSeriesFile() const { return series_file_; }
+int MappingLoader::GetSeriesDecimation() const { return series_decimation_; }
+bool MappingLoader::GetRecycleProject() const { return recycle_project_; }
+const std::string& MappingLoader::GetCallTrace() const { return call_trace_; }
+const std::string& MappingLoader::GetTimelineFile() const { return timeline_file_; }
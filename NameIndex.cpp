@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+//   NameIndex.cpp
+//   Open-addressing hash table from SWMM element name to index
+//-----------------------------------------------------------------------------
+
+#include "include/NameIndex.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+static const size_t kMinSlots = 16;
+
+// SWMM compares IDs without regard to case (ASCII only)
+static inline unsigned char Upper(char c) {
+    return (c >= 'a' && c <= 'z') ? (unsigned char)(c - 'a' + 'A') : (unsigned char)c;
+}
+
+static bool SameName(const char* stored, const char* s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (Upper(stored[i]) != Upper(s[i])) return false;
+    }
+    return stored[n] == '\0';
+}
+
+NameIndex::NameIndex() : count_(0) {
+    Clear();
+}
+
+void NameIndex::Clear() {
+    Slot empty = { 0, -1, -1 };
+    slots_.assign(kMinSlots, empty);
+    names_.clear();
+    count_ = 0;
+}
+
+uint32_t NameIndex::Hash(const char* s, size_t n) {
+    uint32_t h = 2166136261u;   // FNV-1a over upper-cased bytes
+    for (size_t i = 0; i < n; i++) h = (h ^ Upper(s[i])) * 16777619u;
+    return h;
+}
+
+int NameIndex::FindSlot(const char* s, size_t n, uint32_t h) const {
+    // The slot holding the name, or the empty slot where it would go
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = h & mask;; i = (i + 1) & mask) {
+        const Slot& slot = slots_[i];
+        if (slot.offset < 0) return (int)i;
+        if (slot.hash == h && SameName(&names_[slot.offset], s, n)) return (int)i;
+    }
+}
+
+void NameIndex::Reserve(int count) {
+    size_t want = kMinSlots;
+    while (want < (size_t)count * 2) want *= 2;
+    if (want > slots_.size()) {
+        std::vector<Slot> old;
+        old.swap(slots_);
+        Slot empty = { 0, -1, -1 };
+        slots_.assign(want, empty);
+        const size_t mask = want - 1;
+        for (const Slot& slot : old) {
+            if (slot.offset < 0) continue;
+            size_t i = slot.hash & mask;
+            while (slots_[i].offset >= 0) i = (i + 1) & mask;
+            slots_[i] = slot;
+        }
+    }
+    names_.reserve((size_t)count * 16);
+}
+
+void NameIndex::Grow() {
+    Reserve((int)slots_.size());   // doubles the table
+}
+
+bool NameIndex::Add(const char* name, int index) {
+    if ((size_t)(count_ + 1) * 2 > slots_.size()) Grow();
+    size_t n = strlen(name);
+    uint32_t h = Hash(name, n);
+    int i = FindSlot(name, n, h);
+    if (slots_[i].offset >= 0) return false;
+    slots_[i].hash = h;
+    slots_[i].offset = (int32_t)names_.size();
+    slots_[i].index = index;
+    names_.insert(names_.end(), name, name + n + 1);
+    count_++;
+    return true;
+}
+
+int NameIndex::Find(const std::string& name) const {
+    if (count_ == 0) return -1;
+    const Slot& slot = slots_[FindSlot(name.data(), name.size(), Hash(name.data(), name.size()))];
+    return slot.offset < 0 ? -1 : slot.index;
+}
+
+std::string NameIndex::Suggest(const std::string& name) const {
+    // Allow about one edit per three characters
+    const int limit = std::max(1, (int)name.size() / 3);
+    const int m = (int)name.size();
+    std::vector<int> prev(m + 1), cur(m + 1);
+    int best = limit + 1;
+    const char* best_name = NULL;
+
+    // Candidates in insertion (SWMM index) order, so ties go to the lower index
+    for (size_t pos = 0; pos < names_.size(); pos += strlen(&names_[pos]) + 1) {
+        const char* cand = &names_[pos];
+        const int n = (int)strlen(cand);
+        if (std::abs(n - m) >= best) continue;
+
+        // Levenshtein distance, abandoned once a whole row exceeds the best so far
+        for (int j = 0; j <= m; j++) prev[j] = j;
+        int row_min = 0;
+        for (int i = 1; i <= n && row_min < best; i++) {
+            cur[0] = i;
+            row_min = i;
+            for (int j = 1; j <= m; j++) {
+                int cost = (Upper(cand[i - 1]) == Upper(name[j - 1])) ? 0 : 1;
+                cur[j] = std::min(std::min(prev[j] + 1, cur[j - 1] + 1), prev[j - 1] + cost);
+                row_min = std::min(row_min, cur[j]);
+            }
+            prev.swap(cur);
+        }
+        if (row_min < best && prev[m] < best) {
+            best = prev[m];
+            best_name = cand;
+        }
+    }
+    return best_name ? std::string(best_name) : std::string();
+}
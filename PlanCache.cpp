@@ -0,0 +1,156 @@
+//-----------------------------------------------------------------------------
+//   PlanCache.cpp
+//   Binary cache of the resolved mapping, reused while the model and
+//   mapping files are unchanged
+//-----------------------------------------------------------------------------
+
+#include "include/Platform.h"
+#include "include/PlanCache.h"
+#include <cstdio>
+#include <cstring>
+
+static const char kMagic[4] = { 'G', 'S', 'P', 'L' };
+
+struct PlanHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t record_size;
+    uint64_t config_hash;      // SwmmGoldSimBridge.json contents
+    uint64_t model_hash;       // model.inp contents
+    PlanSettings settings;
+    int32_t input_count;
+    int32_t output_count;
+};
+
+//--- Hashing ----------------------------------------------------------------
+
+static const uint64_t kFnvOffset = 14695981039346656037ULL;
+static const uint64_t kFnvPrime = 1099511628211ULL;
+
+// FNV-1a over 64-bit words, folded so high bits reach the low bits.
+// Only used to detect a changed file, not as a cryptographic digest.
+static uint64_t HashBytes(uint64_t h, const unsigned char* p, size_t n) {
+    for (; n >= 8; p += 8, n -= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = (h ^ w) * kFnvPrime;
+        h ^= h >> 32;
+    }
+    for (; n > 0; p++, n--) h = (h ^ *p) * kFnvPrime;
+    return h;
+}
+
+bool PlanCache::HashFile(const char* path, uint64_t& hash) {
+    FILE* f = NULL;
+    if (fopen_s(&f, path, "rb") != 0 || !f) return false;
+    // On the stack: XF_INITIALIZE hashes model.inp in every realization
+    // A multiple of 8 bytes, so words never straddle reads.
+    uint64_t buf[2048];
+    uint64_t h = kFnvOffset, total = 0;
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        h = HashBytes(h, (const unsigned char*)buf, n);
+        total += n;
+    }
+    bool ok = !ferror(f);
+    fclose(f);
+    hash = HashBytes(h, (const unsigned char*)&total, sizeof(total));
+    return ok;
+}
+
+//--- Replacing the plan ----------------------------------------------------
+
+#ifdef _WIN32
+
+static bool ReplaceWith(const char* from, const char* to) {
+    return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
+#else
+
+static bool ReplaceWith(const char* from, const char* to) {
+    return rename(from, to) == 0;
+}
+
+#endif
+
+//--- PlanCache --------------------------------------------------------------
+
+PlanCache::PlanCache() {}
+
+PlanCache::~PlanCache() {}
+
+void PlanCache::Close() { file_.Close(); }
+
+bool PlanCache::Load(const char* path, uint64_t config_hash, uint64_t model_hash, std::string& reason) {
+    if (!file_.Open(path)) {
+        reason = "no plan file";
+        return false;
+    }
+    const size_t size = file_.GetSize();
+    const PlanHeader* h = (const PlanHeader*)file_.GetData();
+    if (size < sizeof(PlanHeader) || memcmp(h->magic, kMagic, sizeof(kMagic)) != 0)
+        reason = "not a plan file";
+    else if (h->version != kFormatVersion || h->header_size != sizeof(PlanHeader) ||
+             h->record_size != sizeof(PlanRecord))
+        reason = "written by a different bridge version";
+    else if (h->config_hash != config_hash)
+        reason = "mapping file changed";
+    else if (h->model_hash != model_hash)
+        reason = "model file changed";
+    else if (h->input_count < 0 || h->output_count < 0 ||
+             size != sizeof(PlanHeader) + ((size_t)h->input_count + (size_t)h->output_count) * sizeof(PlanRecord))
+        reason = "truncated plan file";
+    else
+        return true;
+    Close();
+    return false;
+}
+
+bool PlanCache::Save(const char* path, uint64_t config_hash, uint64_t model_hash,
+                     const PlanSettings& settings,
+                     const std::vector<PlanRecord>& inputs,
+                     const std::vector<PlanRecord>& outputs,
+                     std::string& error) {
+    PlanHeader h;
+    memset(&h, 0, sizeof(h));   // padding is written too
+    memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kFormatVersion;
+    h.header_size = sizeof(PlanHeader);
+    h.record_size = sizeof(PlanRecord);
+    h.config_hash = config_hash;
+    h.model_hash = model_hash;
+    h.settings = settings;
+    h.input_count = (int32_t)inputs.size();
+    h.output_count = (int32_t)outputs.size();
+
+    std::string tmp = std::string(path) + ".tmp";
+    FILE* f = NULL;
+    if (fopen_s(&f, tmp.c_str(), "wb") != 0 || !f) {
+        error = "Cannot create " + tmp;
+        return false;
+    }
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    if (ok && !inputs.empty()) ok = fwrite(inputs.data(), sizeof(PlanRecord), inputs.size(), f) == inputs.size();
+    if (ok && !outputs.empty()) ok = fwrite(outputs.data(), sizeof(PlanRecord), outputs.size(), f) == outputs.size();
+    ok = (fclose(f) == 0) && ok;
+    if (!ok || !ReplaceWith(tmp.c_str(), path)) {
+        remove(tmp.c_str());
+        error = std::string(ok ? "Cannot replace " : "Cannot write ") + path;
+        return false;
+    }
+    return true;
+}
+
+const PlanSettings& PlanCache::GetSettings() const { return ((const PlanHeader*)file_.GetData())->settings; }
+int PlanCache::GetInputCount() const { return ((const PlanHeader*)file_.GetData())->input_count; }
+int PlanCache::GetOutputCount() const { return ((const PlanHeader*)file_.GetData())->output_count; }
+
+const PlanRecord* PlanCache::GetInputs() const {
+    return (const PlanRecord*)(file_.GetData() + sizeof(PlanHeader));
+}
+
+const PlanRecord* PlanCache::GetOutputs() const {
+    return GetInputs() + GetInputCount();
+}
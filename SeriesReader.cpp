@@ -0,0 +1,85 @@
+//-----------------------------------------------------------------------------
+//   SeriesReader.cpp
+//   Zero-copy reader for files written by SeriesRecorder
+//-----------------------------------------------------------------------------
+
+#include "include/SeriesReader.h"
+#include <cstring>
+
+SeriesReader::SeriesReader() : input_count_(0), output_count_(0), decimation_(1), truncated_(false) {}
+
+void SeriesReader::Close() {
+    file_.Close();
+    segments_.clear();
+    input_count_ = output_count_ = 0;
+    decimation_ = 1;
+    truncated_ = false;
+}
+
+bool SeriesReader::Open(const char* path, std::string& error) {
+    Close();
+    if (!file_.Open(path)) {
+        error = std::string("Cannot open ") + path;
+        return false;
+    }
+    const char* data = file_.GetData();
+    const size_t size = file_.GetSize();
+    const SeriesFileHeader* h = (const SeriesFileHeader*)data;
+    if (size < sizeof(SeriesFileHeader) || memcmp(h->magic, "GSTS", 4) != 0)
+        error = "Not a series file";
+    else if (h->version != SERIES_FORMAT_VERSION || h->header_size != sizeof(SeriesFileHeader) ||
+             h->chunk_header_size != sizeof(SeriesChunkHeader))
+        error = "Unsupported series format version";
+    else if (h->input_count < 0 || h->output_count < 0 || h->column_count != 1 + h->input_count + h->output_count ||
+             h->chunk_rows <= 0 || h->decimation <= 0)
+        error = "Corrupt series header";
+    if (!error.empty()) {
+        error += std::string(" (") + path + ")";
+        file_.Close();
+        return false;
+    }
+    input_count_ = h->input_count;
+    output_count_ = h->output_count;
+    decimation_ = h->decimation;
+
+    // Walk the chunks; stop at the first one that is incomplete
+    size_t pos = sizeof(SeriesFileHeader);
+    while (pos < size) {
+        const SeriesChunkHeader* c = (const SeriesChunkHeader*)(data + pos);
+        size_t body = pos + sizeof(SeriesChunkHeader);
+        if (body > size || memcmp(c->magic, "GSCK", 4) != 0 || c->realization < 0 ||
+            c->rows < 0 || c->rows > h->chunk_rows ||
+            (size - body) / sizeof(double) / h->column_count < (size_t)c->rows) {
+            truncated_ = true;
+            break;
+        }
+        if ((size_t)c->realization >= segments_.size()) segments_.resize((size_t)c->realization + 1);
+        if (c->rows > 0) segments_[c->realization].push_back({ body, c->rows, c->first_step });
+        pos = body + (size_t)c->rows * h->column_count * sizeof(double);
+    }
+    return true;
+}
+
+int64_t SeriesReader::GetRowCount(int realization) const {
+    int64_t rows = 0;
+    if (realization < 0 || realization >= GetRealizationCount()) return 0;
+    for (const Chunk& c : segments_[realization]) rows += c.rows;
+    return rows;
+}
+
+void SeriesReader::GetColumn(int realization, int column, std::vector<Span>& spans) const {
+    spans.clear();
+    if (realization < 0 || realization >= GetRealizationCount() || column < 0 || column >= GetColumnCount()) return;
+    for (const Chunk& c : segments_[realization]) {
+        const double* values = (const double*)(file_.GetData() + c.offset) + (size_t)column * c.rows;
+        spans.push_back({ values, c.rows, c.first_step });
+    }
+}
+
+void SeriesReader::ReadColumn(int realization, int column, std::vector<double>& values) const {
+    std::vector<Span> spans;
+    GetColumn(realization, column, spans);
+    values.clear();
+    values.reserve((size_t)GetRowCount(realization));
+    for (const Span& s : spans) values.insert(values.end(), s.values, s.values + s.rows);
+}
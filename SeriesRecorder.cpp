@@ -0,0 +1,157 @@
+//-----------------------------------------------------------------------------
+//   SeriesRecorder.cpp
+//   Columnar time-series file of bridge inputs and outputs
+//-----------------------------------------------------------------------------
+
+#include "include/Platform.h"
+#include "include/SeriesRecorder.h"
+#include <cstring>
+
+static const char kFileMagic[4] = { 'G', 'S', 'T', 'S' };
+static const char kChunkMagic[4] = { 'G', 'S', 'C', 'K' };
+
+SeriesRecorder::SeriesRecorder()
+    : file_(NULL), active_(false), input_count_(-1), output_count_(-1), column_count_(0), decimation_(1), chunk_rows_(0),
+      realization_(-1), step_(0), rows_(0), current_(-1), free_count_(0), queue_head_(0), queue_count_(0),
+      stop_(false), failed_(false) {}
+
+SeriesRecorder::~SeriesRecorder() {
+    // XF_CLEANUP ends every segment. Joining from a DLL's static destructor can
+    // deadlock on the loader lock, so a writer still waiting here is abandoned.
+    if (writer_.joinable()) writer_.detach();
+}
+
+bool SeriesRecorder::Begin(const char* path, int input_count, int output_count, int decimation, std::string& error) {
+    if (active_) End(error);
+
+    // A new file on first use or when the layout changes, otherwise append
+    if (decimation < 1) decimation = 1;
+    bool create = (realization_ < 0 || path_ != path || input_count != input_count_ ||
+                   output_count != output_count_ || decimation != decimation_);
+    if (fopen_s(&file_, path, create ? "wb" : "ab") != 0 || !file_) {
+        file_ = NULL;
+        error = std::string("Cannot open ") + path;
+        return false;
+    }
+    path_ = path;
+    input_count_ = input_count;
+    output_count_ = output_count;
+    column_count_ = 1 + input_count + output_count;
+    decimation_ = decimation;
+    if (create) {
+        chunk_rows_ = kChunkBytes / (int)sizeof(double) / column_count_;
+        if (chunk_rows_ < kMinChunkRows) chunk_rows_ = kMinChunkRows;
+        if (chunk_rows_ > kMaxChunkRows) chunk_rows_ = kMaxChunkRows;
+    }
+    failed_ = false;
+    if (create) {
+        SeriesFileHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, kFileMagic, sizeof(kFileMagic));
+        h.version = SERIES_FORMAT_VERSION;
+        h.header_size = sizeof(SeriesFileHeader);
+        h.chunk_header_size = sizeof(SeriesChunkHeader);
+        h.input_count = input_count;
+        h.output_count = output_count;
+        h.column_count = column_count_;
+        h.chunk_rows = chunk_rows_;
+        h.decimation = decimation_;
+        failed_ = fwrite(&h, sizeof(h), 1, file_) != 1;
+        realization_ = -1;
+    }
+
+    buffers_.resize((size_t)kBufferCount * column_count_ * chunk_rows_);
+    for (int i = 0; i < kBufferCount; i++) free_[i] = i;
+    free_count_ = kBufferCount;
+    queue_head_ = queue_count_ = 0;
+    current_ = -1;
+    stop_ = false;
+    realization_++;
+    step_ = 0;
+    rows_ = 0;
+    writer_ = std::thread(&SeriesRecorder::WriterLoop, this);
+    active_ = true;
+    return true;
+}
+
+void SeriesRecorder::AcquireBuffer(int64_t first_step) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    freed_.wait(lock, [this] { return free_count_ > 0; });
+    current_ = free_[--free_count_];
+    SeriesChunkHeader& c = chunks_[current_];
+    memset(&c, 0, sizeof(c));
+    memcpy(c.magic, kChunkMagic, sizeof(kChunkMagic));
+    c.realization = realization_;
+    c.first_step = first_step;
+}
+
+void SeriesRecorder::Submit() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_[(queue_head_ + queue_count_) % kBufferCount] = current_;
+        queue_count_++;
+    }
+    queued_.notify_one();
+    current_ = -1;
+}
+
+void SeriesRecorder::Record(double elapsed, const double* inputs, const double* outputs) {
+    if (!active_) return;
+    const int64_t step = step_++;
+    if (step % decimation_ != 0) return;
+    if (current_ < 0) AcquireBuffer(step);
+
+    // Column c of the current chunk starts at c * chunk_rows_
+    SeriesChunkHeader& c = chunks_[current_];
+    const size_t stride = (size_t)chunk_rows_;
+    double* col = Buffer(current_) + c.rows;
+    col[0] = elapsed;
+    col += stride;
+    for (int i = 0; i < input_count_; i++, col += stride) *col = inputs[i];
+    for (int i = 0; i < output_count_; i++, col += stride) *col = outputs[i];
+    rows_++;
+    if (++c.rows == chunk_rows_) Submit();
+}
+
+void SeriesRecorder::WriterLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        queued_.wait(lock, [this] { return queue_count_ > 0 || stop_; });
+        if (queue_count_ == 0) break;   // stopping with nothing left
+        int b = queue_[queue_head_];
+        queue_head_ = (queue_head_ + 1) % kBufferCount;
+        queue_count_--;
+        lock.unlock();
+
+        // One column block at a time: the tail of a partial chunk is not written
+        const SeriesChunkHeader& c = chunks_[b];
+        bool ok = fwrite(&c, sizeof(c), 1, file_) == 1;
+        const double* data = Buffer(b);
+        for (int col = 0; ok && col < column_count_ && c.rows > 0; col++)
+            ok = fwrite(data + (size_t)col * chunk_rows_, sizeof(double), (size_t)c.rows, file_) == (size_t)c.rows;
+
+        lock.lock();
+        if (!ok) failed_ = true;
+        free_[free_count_++] = b;
+        freed_.notify_one();
+    }
+}
+
+bool SeriesRecorder::End(std::string& error) {
+    if (!active_) return true;
+    // A realization that recorded nothing still gets an empty chunk, so it shows up as a segment
+    if (current_ < 0 && rows_ == 0) AcquireBuffer(0);
+    if (current_ >= 0) Submit();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    queued_.notify_one();
+    writer_.join();
+    active_ = false;
+    bool ok = !failed_;
+    if (fclose(file_) != 0) ok = false;
+    file_ = NULL;
+    if (!ok) error = "Cannot write " + path_;
+    return ok;
+}
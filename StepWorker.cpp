@@ -0,0 +1,82 @@
+//-----------------------------------------------------------------------------
+//   StepWorker.cpp
+//   Single-job worker thread for look-ahead SWMM stepping
+//-----------------------------------------------------------------------------
+
+#include "include/StepWorker.h"
+#include <chrono>
+
+StepWorker::StepWorker()
+    : job_(NULL), busy_(false), stop_(false), result_(0), last_wait_ms_(0.0) {}
+
+StepWorker::~StepWorker() {
+    // Cleanup normally stops the worker; a thread still running here would be
+    // joined under the DLL loader lock, so let it go instead.
+    if (thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        job_ready_.notify_one();
+        thread_.detach();
+    }
+}
+
+void StepWorker::Start() {
+    if (thread_.joinable()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = NULL;
+    busy_ = false;
+    stop_ = false;
+    result_ = 0;
+    thread_ = std::thread(&StepWorker::Loop, this);
+}
+
+void StepWorker::Stop() {
+    if (!thread_.joinable()) return;
+    Wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    job_ready_.notify_one();
+    thread_.join();
+}
+
+void StepWorker::Submit(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = job;
+        busy_ = true;
+    }
+    job_ready_.notify_one();
+}
+
+bool StepWorker::IsBusy() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return busy_;
+}
+
+int StepWorker::Wait() {
+    auto t0 = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    job_done_.wait(lock, [this] { return !busy_; });
+    last_wait_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return result_;
+}
+
+void StepWorker::Loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        job_ready_.wait(lock, [this] { return stop_ || job_ != NULL; });
+        if (job_ == NULL) break;  // stop requested with nothing queued
+        Job job = job_;
+        job_ = NULL;
+        lock.unlock();
+        int result = job();
+        lock.lock();
+        result_ = result;
+        busy_ = false;
+        job_done_.notify_all();
+    }
+}
@@ -3,31 +3,43 @@
 //   GoldSim-SWMM Bridge DLL v5.0 (config-driven)
 //-----------------------------------------------------------------------------
 
-#include <windows.h>
+#include "include/Platform.h"
 #include <string>
 #include <vector>
+#include <map>
+#include <unordered_map>
+#include <cmath>
 #include "include/swmm5.h"
 #include "include/MappingLoader.h"
+#include "include/BridgeLogger.h"
+#include "include/StepWorker.h"
+#include "include/BridgeProfiler.h"
+#include "include/PlanCache.h"
+#include "include/NameIndex.h"
+#include "include/SeriesRecorder.h"
+#include "include/CallTrace.h"
+#include "include/TimelineTracer.h"
+#include "include/AllocTracker.h"
 
 #define DLL_VERSION 5.212
 #define CONFIG_FILE "SwmmGoldSimBridge.json"
+#define MODEL_FILE "model.inp"
+#define PLAN_FILE "SwmmGoldSimBridge.plan"
+#define PROFILE_FILE "bridge_profile.json"
 #define PROPERTY_SKIP -1
+#define SYNC_TOLERANCE_DAYS (0.5 / 86400.0)  // half a second
 
 // Logging: 0=OFF, 1=ERROR, 2=INFO, 3=DEBUG
 static int s_log_level = 2;  // Default to INFO, can be overridden by JSON
+static BridgeLogger s_logger("bridge_debug.log", "GSswmm Bridge v5.212 (with LID API)");
+static BridgeProfiler s_profiler;  // enabled by "profiling": true
 
 static void Log(int level, const char* fmt, ...) {
     if (level > s_log_level) return;
-    static bool first = true;
-    FILE* f = NULL;
-    if (fopen_s(&f, "bridge_debug.log", first ? "w" : "a") == 0 && f) {
-        if (first) { fprintf(f, "GSswmm Bridge v5.212 (with LID API)\n"); first = false; }
-        SYSTEMTIME st; GetLocalTime(&st);
-        const char* tag = (level == 1) ? "ERROR" : (level == 2) ? "INFO " : "DEBUG";
-        fprintf(f, "[%02d:%02d:%02d] [%s] ", st.wHour, st.wMinute, st.wSecond, tag);
-        va_list ap; va_start(ap, fmt); vfprintf(f, fmt, ap); va_end(ap);
-        fprintf(f, "\n"); fclose(f);
-    }
+    uint64_t t0 = s_profiler.Start();
+    const char* tag = (level == 1) ? "ERROR" : (level == 2) ? "INFO " : "DEBUG";
+    va_list ap; va_start(ap, fmt); s_logger.Write(tag, fmt, ap); va_end(ap);
+    s_profiler.Stop(PH_LOGGING, t0);
 }
 
 // GoldSim API
@@ -40,36 +52,152 @@ static void Log(int level, const char* fmt, ...) {
 #define XF_FAILURE      1
 #define XF_FAILURE_WITH_MSG -1
 
+// Output accessor kinds. The execution plan stores outputs grouped in this order.
+enum OutputAccessor {
+    ACC_VALUE = 0,              // swmm_getValue(prop, idx)
+    ACC_LID_STORAGE_VOLUME,     // swmm_getLidUStorageVolume(subcatch, lid)
+    ACC_LID_SURFACE_OUTFLOW,    // swmm_getLidUSurfaceOutflow(subcatch, lid)
+    ACC_LID_SURFACE_INFLOW,     // swmm_getLidUSurfaceInflow(subcatch, lid)
+    ACC_LID_DRAIN_FLOW,         // swmm_getLidUDrainFlow(subcatch, lid)
+    ACC_COUNT
+};
+
+// How an output summarizes the SWMM routing steps inside one GoldSim step
+enum OutputAggregation {
+    AGG_INSTANTANEOUS = 0,      // value at the end of the GoldSim step
+    AGG_MEAN,                   // time-weighted mean over the step
+    AGG_MAX,
+    AGG_MIN,
+    AGG_INTEGRAL                // sum of value * routing step (seconds)
+};
+
 struct Resolved { 
     int iface_idx;   // GoldSim interface index
+    int obj_type;    // swmm_Object of the element (swmm_SUBCATCH for LID)
     int prop_enum;   // SWMM property enum (or -1 for LID)
     int swmm_idx;    // Subcatchment index (for LID) or element index
     int lid_idx;     // LID unit index (only for LID outputs, -1 otherwise)
     bool is_lid;     // True if this is an LID output
-    std::string lid_property;  // LID property name (e.g., "STORAGE_VOLUME", "SURFACE_OUTFLOW")
+    int accessor;    // OutputAccessor used to read this output
+    int aggregation; // OutputAggregation (outputs only)
     
     // Constructor for regular outputs (backward compatibility)
-    Resolved(int iface, int prop, int swmm) 
-        : iface_idx(iface), prop_enum(prop), swmm_idx(swmm), lid_idx(-1), is_lid(false), lid_property("") {}
+    Resolved(int iface, int obj, int prop, int swmm) 
+        : iface_idx(iface), obj_type(obj), prop_enum(prop), swmm_idx(swmm), lid_idx(-1), is_lid(false), accessor(ACC_VALUE),
+          aggregation(AGG_INSTANTANEOUS) {}
     
     // Static factory method for LID outputs
-    static Resolved CreateLidOutput(int iface, int subcatch, int lid, const std::string& property) {
-        Resolved r(iface, -1, subcatch);
+    static Resolved CreateLidOutput(int iface, int subcatch, int lid, int accessor) {
+        Resolved r(iface, swmm_SUBCATCH, -1, subcatch);
         r.lid_idx = lid;
         r.is_lid = true;
-        r.lid_property = property;
+        r.accessor = accessor;
         return r;
     }
 };
 
+// One prebound call in the execution plan: outargs[slot] = get(arg0, arg1),
+// or for inputs swmm_setValue(arg0, arg1, pending[slot])
+struct PlanEntry {
+    int slot;   // GoldSim interface index
+    int arg0;   // SWMM property enum, or subcatchment index for LID accessors
+    int arg1;   // element index, or LID unit index for LID accessors
+    int unit;   // row in the batched LID buffers (LID accessors only)
+};
+
+// Mapping compiled at XF_INITIALIZE so XF_CALCULATE does no string work
+struct ExecutionPlan {
+    std::vector<PlanEntry> outputs;   // grouped by OutputAccessor
+    int begin[ACC_COUNT + 1];         // outputs[begin[k], begin[k+1]) use accessor k
+    std::vector<PlanEntry> inputs;    // settable inputs (PROPERTY_SKIP removed)
+    int elapsed_slot;                 // interface index of the ElapsedTime input, or -1
+
+    // Latest reading of every output, in plan order. ACC_VALUE is group 0, so
+    // swmm_getValues writes its results straight into the front of this buffer.
+    std::vector<double> sample;
+
+    // Intra-step aggregation: one contiguous block of four arrays in plan order,
+    // [sum | compensation | max | min], updated for every output after each
+    // routing step with a branch-free pass. The mode is applied once per XF_CALCULATE.
+    bool aggregating;                 // any output uses a mode other than INSTANTANEOUS
+    std::vector<int> agg_mode;        // OutputAggregation, in plan order
+    std::vector<double> acc;
+    double agg_seconds;               // routing time accumulated since the last reset
+    int agg_steps;
+
+    // Structure-of-arrays copies for swmm_getValues / swmm_setValues
+    std::vector<int> value_props;     // ACC_VALUE group, in plan order
+    std::vector<int> value_index;
+    std::vector<int> input_props;     // inputs, in plan order
+    std::vector<int> input_index;
+    std::vector<double> input_buf;
+
+    // Distinct LID units referenced by outputs, queried with one swmm_getLidUStates call
+    std::vector<int> lid_subcatch;
+    std::vector<int> lid_index;
+    std::vector<double> lid_values;   // LID_FIELD_COUNT blocks of lid_subcatch.size() values
+};
+
+// Field blocks in ExecutionPlan::lid_values, in accessor order
+#define LID_FIELD_COUNT (ACC_COUNT - ACC_LID_STORAGE_VOLUME)
+#define LID_FIELD(acc) ((acc) - ACC_LID_STORAGE_VOLUME)
+
+// Optional swmm5.dll exports, bound at XF_INITIALIZE (NULL with an older DLL)
+static decltype(&swmm_getLidUStates) s_getLidUStates = NULL;
+static decltype(&swmm_getValues) s_getValues = NULL;
+static decltype(&swmm_setValues) s_setValues = NULL;
+static decltype(&swmm_stride) s_stride = NULL;
+static decltype(&swmm_getStateSize) s_getStateSize = NULL;
+static decltype(&swmm_saveState) s_saveState = NULL;
+static decltype(&swmm_loadState) s_loadState = NULL;
+
+// Time coupling: STEP runs one swmm_step per XF_CALCULATE; SYNC advances SWMM
+// to the GoldSim ElapsedTime input, taking as many routing steps as needed
+enum CouplingMode { COUPLE_STEP = 0, COUPLE_SYNC = 1 };
+
+// Which elements SWMM writes to the report and binary output files:
+// FULL leaves model.inp's [REPORT] settings alone, MAPPED reports only the
+// elements in the mapping, NONE reports no elements and saves no results
+enum OutputPolicy { OUTPUT_NONE = 0, OUTPUT_MAPPED = 1, OUTPUT_FULL = 2 };
+
 // State
 static MappingLoader s_mapping;
 static bool s_mapping_loaded = false;
 static std::vector<Resolved> s_inputs, s_outputs;
+static ExecutionPlan s_plan;
 static bool s_swmm_running = false;
 static char s_error_buf[256];
 static bool s_first_calculate = true;
 static std::vector<double> s_pending_inputs;
+static int s_coupling_mode = COUPLE_STEP;
+static double s_elapsed_to_days = 1.0 / 86400.0;  // ElapsedTime input units -> days
+static double s_swmm_elapsed = 0.0;               // SWMM elapsed time (days) after the last step
+static bool s_pipelined = false;                  // look-ahead stepping on s_worker (STEP coupling only)
+static StepWorker s_worker;
+static double s_spinup_days = 0.0;                // hot-start spin-up before GoldSim time 0
+static double s_elapsed_offset = 0.0;             // SWMM elapsed days at GoldSim time 0
+static std::vector<char> s_snapshot;              // state at the end of spin-up, kept across realizations
+static double s_snapshot_date = 0.0;              // SWMM date/time of s_snapshot
+static double s_snapshot_spinup_days = 0.0;       // spin-up length s_snapshot was taken after
+static uint64_t s_snapshot_model_hash = 0;        // MODEL_FILE contents s_snapshot was taken from
+static int s_input_count = 0, s_output_count = 0; // interface sizes reported to GoldSim
+static bool s_resolved = false;                   // s_inputs/s_outputs hold the resolved mapping
+static uint64_t s_config_hash = 0, s_model_hash = 0;  // file contents the mapping was loaded from
+static bool s_hashed = false;                     // both hashes are valid
+static bool s_plan_cache = false;                 // write PLAN_FILE after the next resolution
+static int s_output_policy = OUTPUT_FULL;
+static std::string s_report_file = "model.rpt";   // swmm_open report and binary output files
+static std::string s_output_file = "model.out";
+static SeriesRecorder s_recorder;                 // "series_file": one segment per realization
+static std::string s_series_file;
+static int s_series_decimation = 1;
+static bool s_recycle = false;                    // "recycle_project": swmm_end only between realizations
+static CallTraceWriter s_trace;                   // "call_trace": every call, for GSswmmReplay
+static std::string s_call_trace;
+static TimelineTracer s_timeline;                 // "timeline_file": spans attached to s_profiler
+static std::string s_timeline_file;
+static bool s_project_open = false;               // swmm_open succeeded and swmm_close has not been called
+static bool s_plan_compiled = false;              // s_plan matches s_inputs/s_outputs
 
 static void SetError(double* outargs, int* status, const char* msg) {
     strncpy_s(s_error_buf, sizeof(s_error_buf), msg, _TRUNCATE);
@@ -83,32 +211,120 @@ static void HandleSwmmError(double* outargs, int* status) {
     *status = XF_FAILURE_WITH_MSG;
 }
 
-static int ObjTypeToSwmm(const std::string& ot) {
-    if (ot == "SYSTEM") return swmm_SYSTEM;
-    if (ot == "GAGE") return swmm_GAGE;
-    if (ot == "SUBCATCH") return swmm_SUBCATCH;
-    if (ot == "NODE" || ot == "STORAGE" || ot == "OUTFALL" || ot == "JUNCTION" || ot == "DIVIDER") return swmm_NODE;
-    if (ot == "LINK" || ot == "PUMP" || ot == "ORIFICE" || ot == "WEIR" || ot == "CONDUIT" || ot == "OUTLET") return swmm_LINK;
-    return -1;
+// Supported (object_type, property) pairs for inputs ('I') and outputs ('O')
+struct PropertyEntry {
+    char dir;
+    const char* object_type;
+    const char* property;
+    int obj;    // swmm_Object
+    int prop;   // SWMM property enum, or PROPERTY_SKIP
+};
+
+static constexpr PropertyEntry kProperties[] = {
+    { 'I', "SYSTEM",   "ELAPSEDTIME", swmm_SYSTEM,   PROPERTY_SKIP },
+    { 'I', "GAGE",     "RAINFALL",    swmm_GAGE,     swmm_GAGE_RAINFALL },
+    { 'I', "PUMP",     "SETTING",     swmm_LINK,     swmm_LINK_SETTING },
+    { 'I', "ORIFICE",  "SETTING",     swmm_LINK,     swmm_LINK_SETTING },
+    { 'I', "WEIR",     "SETTING",     swmm_LINK,     swmm_LINK_SETTING },
+    { 'I', "LINK",     "SETTING",     swmm_LINK,     swmm_LINK_SETTING },
+    { 'I', "NODE",     "LATFLOW",     swmm_NODE,     swmm_NODE_LATFLOW },
+    { 'O', "STORAGE",  "VOLUME",      swmm_NODE,     swmm_NODE_VOLUME },
+    { 'O', "NODE",     "VOLUME",      swmm_NODE,     swmm_NODE_VOLUME },
+    { 'O', "STORAGE",  "DEPTH",       swmm_NODE,     swmm_NODE_DEPTH },
+    { 'O', "NODE",     "DEPTH",       swmm_NODE,     swmm_NODE_DEPTH },
+    { 'O', "JUNCTION", "DEPTH",       swmm_NODE,     swmm_NODE_DEPTH },
+    { 'O', "OUTFALL",  "DEPTH",       swmm_NODE,     swmm_NODE_DEPTH },
+    { 'O', "LINK",     "FLOW",        swmm_LINK,     swmm_LINK_FLOW },
+    { 'O', "PUMP",     "FLOW",        swmm_LINK,     swmm_LINK_FLOW },
+    { 'O', "ORIFICE",  "FLOW",        swmm_LINK,     swmm_LINK_FLOW },
+    { 'O', "WEIR",     "FLOW",        swmm_LINK,     swmm_LINK_FLOW },
+    { 'O', "CONDUIT",  "FLOW",        swmm_LINK,     swmm_LINK_FLOW },
+    { 'O', "OUTLET",   "FLOW",        swmm_LINK,     swmm_LINK_FLOW },
+    { 'O', "OUTFALL",  "FLOW",        swmm_NODE,     swmm_NODE_INFLOW },
+    { 'O', "NODE",     "FLOW",        swmm_NODE,     swmm_NODE_INFLOW },
+    { 'O', "NODE",     "INFLOW",      swmm_NODE,     swmm_NODE_INFLOW },
+    { 'O', "STORAGE",  "INFLOW",      swmm_NODE,     swmm_NODE_INFLOW },
+    { 'O', "JUNCTION", "INFLOW",      swmm_NODE,     swmm_NODE_INFLOW },
+    { 'O', "OUTFALL",  "INFLOW",      swmm_NODE,     swmm_NODE_INFLOW },
+    { 'O', "SUBCATCH", "RUNOFF",      swmm_SUBCATCH, swmm_SUBCATCH_RUNOFF },
+};
+static constexpr int kPropertyCount = (int)(sizeof(kProperties) / sizeof(kProperties[0]));
+
+// Perfect hash of "dir object_type/property": FNV-1a with a seed chosen so the
+// entries above land in distinct slots. If an entry is added and the
+// static_assert below fails, search for a new seed.
+#define PROPERTY_SLOT_BITS 6
+#define PROPERTY_SLOTS (1 << PROPERTY_SLOT_BITS)
+static constexpr uint32_t kPropertySeed = 0x811c9df1u;
+
+static constexpr uint32_t PropertyHashStep(uint32_t h, const char* s, size_t n) {
+    for (size_t i = 0; i < n; i++) h = (h ^ (unsigned char)s[i]) * 16777619u;
+    return h;
 }
 
-static int InputPropToEnum(const std::string& ot, const std::string& prop) {
-    if (ot == "SYSTEM" && prop == "ELAPSEDTIME") return PROPERTY_SKIP;
-    if (ot == "GAGE" && prop == "RAINFALL") return swmm_GAGE_RAINFALL;
-    if ((ot == "PUMP" || ot == "ORIFICE" || ot == "WEIR" || ot == "LINK") && prop == "SETTING") return swmm_LINK_SETTING;
-    if (ot == "NODE" && prop == "LATFLOW") return swmm_NODE_LATFLOW;
-    return -1;
+static constexpr size_t Length(const char* s) {
+    size_t n = 0;
+    while (s[n]) n++;
+    return n;
+}
+
+static constexpr int PropertySlot(char dir, const char* ot, size_t ot_len, const char* prop, size_t prop_len) {
+    uint32_t h = (kPropertySeed ^ (unsigned char)dir) * 16777619u;
+    h = PropertyHashStep(h, ot, ot_len);
+    h = (h ^ (unsigned char)'/') * 16777619u;
+    h = PropertyHashStep(h, prop, prop_len);
+    return (int)(h >> (32 - PROPERTY_SLOT_BITS));
 }
 
-static int OutputPropToEnum(const std::string& ot, const std::string& prop) {
-    if (prop == "VOLUME" && (ot == "STORAGE" || ot == "NODE")) return swmm_NODE_VOLUME;
-    if (prop == "DEPTH" && (ot == "STORAGE" || ot == "NODE" || ot == "JUNCTION" || ot == "OUTFALL")) return swmm_NODE_DEPTH;
-    if (prop == "FLOW") {
-        if (ot == "LINK" || ot == "PUMP" || ot == "ORIFICE" || ot == "WEIR" || ot == "CONDUIT" || ot == "OUTLET") return swmm_LINK_FLOW;
-        if (ot == "OUTFALL" || ot == "NODE") return swmm_NODE_INFLOW;
+struct PropertySlots {
+    signed char entry[PROPERTY_SLOTS];   // index into kProperties, or -1
+    bool perfect;
+};
+
+static constexpr PropertySlots BuildPropertySlots() {
+    PropertySlots t = {};
+    t.perfect = true;
+    for (int i = 0; i < PROPERTY_SLOTS; i++) t.entry[i] = -1;
+    for (int i = 0; i < kPropertyCount; i++) {
+        const PropertyEntry& e = kProperties[i];
+        int slot = PropertySlot(e.dir, e.object_type, Length(e.object_type), e.property, Length(e.property));
+        if (t.entry[slot] >= 0) t.perfect = false;
+        t.entry[slot] = (signed char)i;
     }
-    if (prop == "INFLOW" && (ot == "NODE" || ot == "STORAGE" || ot == "JUNCTION" || ot == "OUTFALL")) return swmm_NODE_INFLOW;
-    if (ot == "SUBCATCH" && prop == "RUNOFF") return swmm_SUBCATCH_RUNOFF;
+    return t;
+}
+
+static constexpr PropertySlots kPropertySlots = BuildPropertySlots();
+static_assert(kPropertySlots.perfect, "kProperties collide in the perfect hash; choose another kPropertySeed");
+
+/**
+ * @brief Look up a supported (object_type, property) pair
+ * @param dir 'I' for inputs, 'O' for outputs
+ * @return The table entry, or NULL if the pair is not supported
+ * @note One hash and one string comparison instead of the if-chains per entry
+ */
+static const PropertyEntry* LookupProperty(char dir, const std::string& ot, const std::string& prop) {
+    int slot = PropertySlot(dir, ot.data(), ot.size(), prop.data(), prop.size());
+    int i = kPropertySlots.entry[slot];
+    if (i < 0) return NULL;
+    const PropertyEntry& e = kProperties[i];
+    return (e.dir == dir && ot == e.object_type && prop == e.property) ? &e : NULL;
+}
+
+static int AggregationFromString(const std::string& agg) {
+    if (agg == "INSTANTANEOUS") return AGG_INSTANTANEOUS;
+    if (agg == "MEAN") return AGG_MEAN;
+    if (agg == "MAX") return AGG_MAX;
+    if (agg == "MIN") return AGG_MIN;
+    if (agg == "INTEGRAL") return AGG_INTEGRAL;
+    return -1;
+}
+
+static int LidPropToAccessor(const std::string& prop) {
+    if (prop == "STORAGE_VOLUME") return ACC_LID_STORAGE_VOLUME;
+    if (prop == "SURFACE_OUTFLOW") return ACC_LID_SURFACE_OUTFLOW;
+    if (prop == "SURFACE_INFLOW") return ACC_LID_SURFACE_INFLOW;
+    if (prop == "DRAIN_FLOW") return ACC_LID_DRAIN_FLOW;
     return -1;
 }
 
@@ -133,40 +349,579 @@ static bool ParseCompositeID(const std::string& name,
     return true;
 }
 
+#define LID_NOT_FOUND -1
+#define LID_DUPLICATE -2   // control name appears more than once in the subcatchment
+
+// LID units by control name for each subcatchment enumerated so far, shared
+// by all outputs during one resolution
+struct LidNameIndex {
+    struct Units {
+        int count;                                   // swmm_getLidUCount result (< 0: invalid subcatchment)
+        std::unordered_map<std::string, int> by_name;  // unit index, or LID_DUPLICATE
+    };
+    std::unordered_map<int, Units> subcatch;
+};
+
 /**
  * @brief Resolve LID unit index by name within a subcatchment
+ * @param index Name index, filled for subcatch_idx on first use
  * @param subcatch_idx Zero-based subcatchment index
  * @param lid_name LID control name to search for
- * @return LID unit index (>= 0) if found, -1 if not found
- * @note Enumerates all LID units in the subcatchment using swmm_getLidUCount()
- * @note Matches LID control name using swmm_getLidUName()
+ * @param lid_count Set to the number of LID units in the subcatchment
+ * @return LID unit index (>= 0), LID_NOT_FOUND, or LID_DUPLICATE if the name is ambiguous
+ * @note Each subcatchment is enumerated once with swmm_getLidUName, so
+ *       resolution costs one DLL call per LID unit rather than per unit and output
+ */
+static int ResolveLidIndex(LidNameIndex& index, int subcatch_idx, const std::string& lid_name, int& lid_count) {
+    auto found = index.subcatch.find(subcatch_idx);
+    if (found == index.subcatch.end()) {
+        LidNameIndex::Units& units = index.subcatch[subcatch_idx];
+        units.count = swmm_getLidUCount(subcatch_idx);
+        if (units.count < 0)
+            Log(1, "ResolveLidIndex: swmm_getLidUCount returned %d for subcatch_idx=%d", units.count, subcatch_idx);
+        else
+            Log(2, "Indexing %d LID units in subcatch_idx=%d", units.count, subcatch_idx);
+
+        char name_buf[64];
+        for (int i = 0; i < units.count; i++) {
+            name_buf[0] = '\0';
+            swmm_getLidUName(subcatch_idx, i, name_buf, sizeof(name_buf));
+            Log(3, "  LID[%d]: '%s'", i, name_buf);
+            auto ins = units.by_name.insert(std::make_pair(std::string(name_buf), i));
+            if (!ins.second) ins.first->second = LID_DUPLICATE;
+        }
+        found = index.subcatch.find(subcatch_idx);
+    }
+
+    const LidNameIndex::Units& units = found->second;
+    lid_count = units.count;
+    auto unit = units.by_name.find(lid_name);
+    if (unit == units.by_name.end()) {
+        Log(1, "ResolveLidIndex: No match found for '%s'", lid_name.c_str());
+        return LID_NOT_FOUND;
+    }
+    return unit->second;
+}
+
+// Element names of each object type, enumerated once per resolution and
+// shared by all inputs and outputs
+struct ElementIndex {
+    NameIndex names[swmm_LINK + 1];
+    bool built[swmm_LINK + 1] = { false, false, false, false };
+};
+
+/**
+ * @brief Resolve an element name to its SWMM index
+ * @return Element index, or -1 if the model has no such element
+ * @note The first lookup for an object type enumerates every element of that
+ *       type with swmm_getCount/swmm_getName. A name the index does not hold
+ *       is passed to swmm_getIndex, which also covers an engine whose
+ *       swmm_getName returns nothing.
  */
-static int ResolveLidIndex(int subcatch_idx, const std::string& lid_name) {
-    int lid_count = swmm_getLidUCount(subcatch_idx);
-    if (lid_count < 0) {
-        Log(1, "ResolveLidIndex: swmm_getLidUCount returned %d for subcatch_idx=%d", lid_count, subcatch_idx);
-        return -1;  // Invalid subcatchment index
+static int FindElement(ElementIndex& index, int obj, const std::string& name) {
+    NameIndex& names = index.names[obj];
+    if (!index.built[obj]) {
+        index.built[obj] = true;
+        int count = swmm_getCount(obj);
+        if (count < 0) count = 0;
+        names.Reserve(count);
+        char name_buf[64];   // SWMM IDs are at most 63 characters
+        for (int i = 0; i < count; i++) {
+            name_buf[0] = '\0';
+            swmm_getName(obj, i, name_buf, sizeof(name_buf));
+            if (name_buf[0]) names.Add(name_buf, i);
+        }
+        Log(2, "Indexed %d names of object type %d", names.GetCount(), obj);
     }
-    
-    Log(2, "ResolveLidIndex: Searching for '%s' among %d LID units in subcatch_idx=%d", lid_name.c_str(), lid_count, subcatch_idx);
-    
-    char name_buf[64];
-    for (int i = 0; i < lid_count; i++) {
-        swmm_getLidUName(subcatch_idx, i, name_buf, sizeof(name_buf));
-        Log(2, "  LID[%d]: '%s'", i, name_buf);
-        if (lid_name == name_buf) {
-            Log(2, "  Match found at index %d", i);
-            return i;  // Found matching LID unit
+    int idx = names.Find(name);
+    return idx >= 0 ? idx : swmm_getIndex(obj, name.c_str());
+}
+
+/**
+ * @brief Format a name-not-found error into s_error_buf, with the closest
+ *        model name of the same type when one is near enough to be a typo
+ */
+static void ElementNotFound(const ElementIndex& index, int obj, const char* what,
+                            const std::string& id, const std::string& name) {
+    std::string guess = index.names[obj].Suggest(name);
+    if (guess.empty()) sprintf_s(s_error_buf, "%s: %s", what, id.c_str());
+    else sprintf_s(s_error_buf, "%s: %s (did you mean '%s'?)", what, id.c_str(), guess.c_str());
+}
+
+/**
+ * @brief Compile the resolved inputs/outputs into the execution plan
+ * @note Outputs are grouped by accessor with a stable counting sort, so each
+ *       group keeps mapping order and GatherOutputs runs one loop per accessor
+ */
+static void CompilePlan() {
+    int counts[ACC_COUNT] = { 0 };
+    for (const auto& r : s_outputs) counts[r.accessor]++;
+    s_plan.begin[0] = 0;
+    for (int k = 0; k < ACC_COUNT; k++) s_plan.begin[k + 1] = s_plan.begin[k] + counts[k];
+
+    int next[ACC_COUNT];
+    for (int k = 0; k < ACC_COUNT; k++) next[k] = s_plan.begin[k];
+    s_plan.outputs.resize(s_outputs.size());
+    s_plan.agg_mode.resize(s_outputs.size());
+    s_plan.aggregating = false;
+    s_plan.lid_subcatch.clear();
+    s_plan.lid_index.clear();
+    std::map<std::pair<int, int>, int> units;
+    for (const auto& r : s_outputs) {
+        s_plan.agg_mode[next[r.accessor]] = r.aggregation;
+        if (r.aggregation != AGG_INSTANTANEOUS) s_plan.aggregating = true;
+        PlanEntry& e = s_plan.outputs[next[r.accessor]++];
+        e.slot = r.iface_idx;
+        e.arg0 = r.is_lid ? r.swmm_idx : r.prop_enum;
+        e.arg1 = r.is_lid ? r.lid_idx : r.swmm_idx;
+        e.unit = -1;
+        if (!r.is_lid) continue;
+
+        // Outputs of the same unit share one row of the batched buffers
+        auto found = units.insert(std::make_pair(std::make_pair(r.swmm_idx, r.lid_idx), (int)units.size()));
+        e.unit = found.first->second;
+        if (found.second) {
+            s_plan.lid_subcatch.push_back(r.swmm_idx);
+            s_plan.lid_index.push_back(r.lid_idx);
         }
     }
-    
-    Log(1, "ResolveLidIndex: No match found for '%s'", lid_name.c_str());
-    return -1;  // Not found
+    s_plan.lid_values.assign(s_plan.lid_subcatch.size() * LID_FIELD_COUNT, 0.0);
+
+    s_plan.value_props.clear();
+    s_plan.value_index.clear();
+    for (int i = s_plan.begin[ACC_VALUE]; i < s_plan.begin[ACC_VALUE + 1]; i++) {
+        s_plan.value_props.push_back(s_plan.outputs[i].arg0);
+        s_plan.value_index.push_back(s_plan.outputs[i].arg1);
+    }
+    s_plan.sample.assign(s_plan.outputs.size(), 0.0);
+    s_plan.acc.assign(s_plan.outputs.size() * 4, 0.0);
+    s_plan.agg_seconds = 0.0;
+    s_plan.agg_steps = 0;
+
+    s_plan.inputs.clear();
+    s_plan.input_props.clear();
+    s_plan.input_index.clear();
+    s_plan.elapsed_slot = -1;
+    for (const auto& r : s_inputs) {
+        if (r.prop_enum == PROPERTY_SKIP) { s_plan.elapsed_slot = r.iface_idx; continue; }
+        PlanEntry e = { r.iface_idx, r.prop_enum, r.swmm_idx, -1 };
+        s_plan.inputs.push_back(e);
+        s_plan.input_props.push_back(r.prop_enum);
+        s_plan.input_index.push_back(r.swmm_idx);
+    }
+    s_plan.input_buf.assign(s_plan.inputs.size(), 0.0);
+    Log(2, "Execution plan: %zu inputs, %zu outputs (value=%d, lid storage=%d, outflow=%d, inflow=%d, drain=%d)",
+        s_plan.inputs.size(), s_plan.outputs.size(), counts[ACC_VALUE], counts[ACC_LID_STORAGE_VOLUME],
+        counts[ACC_LID_SURFACE_OUTFLOW], counts[ACC_LID_SURFACE_INFLOW], counts[ACC_LID_DRAIN_FLOW]);
+    Log(2, "LID units in plan: %zu (%s)", s_plan.lid_subcatch.size(),
+        s_getLidUStates ? "batched swmm_getLidUStates" : "per-unit getters");
+    Log(2, "Value access: %s", (s_getValues && s_setValues) ? "batched swmm_getValues/swmm_setValues" : "per-element swmm_getValue/swmm_setValue");
+    if (s_plan.aggregating)
+        Log(2, "Output aggregation active: outputs are sampled after every routing step");
+}
+
+/**
+ * @brief Bind optional exports that only newer swmm5.dll builds provide
+ * @note Looked up at run time so the bridge still loads against an older DLL
+ */
+static void BindOptionalExports() {
+#ifdef _WIN32
+    HMODULE h = GetModuleHandleA("swmm5.dll");
+#else
+    HMODULE h = PlatformModuleFromAddress((const void*)&swmm_open);
+#endif
+    s_getLidUStates = h ? (decltype(&swmm_getLidUStates))GetProcAddress(h, "swmm_getLidUStates") : NULL;
+    s_getValues = h ? (decltype(&swmm_getValues))GetProcAddress(h, "swmm_getValues") : NULL;
+    s_setValues = h ? (decltype(&swmm_setValues))GetProcAddress(h, "swmm_setValues") : NULL;
+    s_stride = h ? (decltype(&swmm_stride))GetProcAddress(h, "swmm_stride") : NULL;
+    s_getStateSize = h ? (decltype(&swmm_getStateSize))GetProcAddress(h, "swmm_getStateSize") : NULL;
+    s_saveState = h ? (decltype(&swmm_saveState))GetProcAddress(h, "swmm_saveState") : NULL;
+    s_loadState = h ? (decltype(&swmm_loadState))GetProcAddress(h, "swmm_loadState") : NULL;
+}
+
+/**
+ * @brief Read all LID outputs with a single swmm_getLidUStates call
+ * @return false if the call failed; the caller then uses the per-unit getters
+ */
+static bool SampleLidBatched() {
+    const int n = (int)s_plan.lid_subcatch.size();
+    const PlanEntry* e = s_plan.outputs.data();
+    const int* b = s_plan.begin;
+    double* field[LID_FIELD_COUNT];
+    for (int f = 0; f < LID_FIELD_COUNT; f++) {
+        int k = f + ACC_LID_STORAGE_VOLUME;
+        field[f] = (b[k + 1] > b[k]) ? s_plan.lid_values.data() + (size_t)f * n : NULL;
+    }
+    int err = s_getLidUStates(n, s_plan.lid_subcatch.data(), s_plan.lid_index.data(),
+                              field[LID_FIELD(ACC_LID_STORAGE_VOLUME)], field[LID_FIELD(ACC_LID_SURFACE_INFLOW)],
+                              field[LID_FIELD(ACC_LID_SURFACE_OUTFLOW)], field[LID_FIELD(ACC_LID_DRAIN_FLOW)],
+                              NULL, NULL);
+    if (err != 0) {
+        Log(1, "swmm_getLidUStates failed with error %d, using per-unit getters", err);
+        return false;
+    }
+    double* x = s_plan.sample.data();
+    for (int k = ACC_LID_STORAGE_VOLUME; k < ACC_COUNT; k++) {
+        const double* v = field[LID_FIELD(k)];
+        for (int i = b[k]; i < b[k + 1]; i++)
+            x[i] = v[e[i].unit];
+    }
+    return true;
+}
+
+/**
+ * @brief Read every output's current SWMM value into s_plan.sample (plan order)
+ */
+static void SampleOutputs() {
+    uint64_t t0 = s_profiler.Start();
+    const PlanEntry* e = s_plan.outputs.data();
+    const int* b = s_plan.begin;
+    double* x = s_plan.sample.data();
+    const int nvalues = b[ACC_VALUE + 1] - b[ACC_VALUE];
+    if (!(nvalues > 0 && s_getValues &&
+          s_getValues(s_plan.value_props.data(), s_plan.value_index.data(), nvalues, x + b[ACC_VALUE]) == 0)) {
+        for (int i = b[ACC_VALUE]; i < b[ACC_VALUE + 1]; i++)
+            x[i] = swmm_getValue(e[i].arg0, e[i].arg1);
+    }
+
+    bool has_lid = b[ACC_COUNT] > b[ACC_LID_STORAGE_VOLUME];
+    if (has_lid && !(s_getLidUStates && SampleLidBatched())) {
+        for (int i = b[ACC_LID_STORAGE_VOLUME]; i < b[ACC_LID_STORAGE_VOLUME + 1]; i++)
+            x[i] = swmm_getLidUStorageVolume(e[i].arg0, e[i].arg1);
+        for (int i = b[ACC_LID_SURFACE_OUTFLOW]; i < b[ACC_LID_SURFACE_OUTFLOW + 1]; i++)
+            x[i] = swmm_getLidUSurfaceOutflow(e[i].arg0, e[i].arg1);
+        for (int i = b[ACC_LID_SURFACE_INFLOW]; i < b[ACC_LID_SURFACE_INFLOW + 1]; i++)
+            x[i] = swmm_getLidUSurfaceInflow(e[i].arg0, e[i].arg1);
+        for (int i = b[ACC_LID_DRAIN_FLOW]; i < b[ACC_LID_DRAIN_FLOW + 1]; i++)
+            x[i] = swmm_getLidUDrainFlow(e[i].arg0, e[i].arg1);
+    }
+    s_profiler.Stop(PH_OUTPUT_GATHER, t0);
+}
+
+static void ResetAccumulators() {
+    const size_t n = s_plan.sample.size();
+    double* acc = s_plan.acc.data();
+    for (size_t i = 0; i < 2 * n; i++) acc[i] = 0.0;              // sum, compensation
+    for (size_t i = 2 * n; i < 3 * n; i++) acc[i] = -HUGE_VAL;    // max
+    for (size_t i = 3 * n; i < 4 * n; i++) acc[i] = HUGE_VAL;     // min
+    s_plan.agg_seconds = 0.0;
+    s_plan.agg_steps = 0;
+}
+
+/**
+ * @brief Fold one routing step into the aggregation accumulators
+ * @param elapsed SWMM elapsed time (days) returned by the step just taken
+ * @note Must be called before s_swmm_elapsed is advanced. Each sample is
+ *       weighted by the routing step that produced it; sums use Kahan
+ *       compensation so long GoldSim steps do not lose small increments.
+ */
+static void AccumulateStep(double elapsed) {
+    if (!s_plan.aggregating) return;
+    SampleOutputs();
+    double dt = (elapsed - s_swmm_elapsed) * 86400.0;
+    if (dt < 0.0) dt = 0.0;
+
+    const int n = (int)s_plan.sample.size();
+    const double* x = s_plan.sample.data();
+    double* sum = s_plan.acc.data();
+    double* comp = sum + n;
+    double* hi = comp + n;
+    double* lo = hi + n;
+    for (int i = 0; i < n; i++) {
+        double y = x[i] * dt - comp[i];
+        double t = sum[i] + y;
+        comp[i] = (t - sum[i]) - y;
+        sum[i] = t;
+        hi[i] = x[i] > hi[i] ? x[i] : hi[i];
+        lo[i] = x[i] < lo[i] ? x[i] : lo[i];
+    }
+    s_plan.agg_seconds += dt;
+    s_plan.agg_steps++;
+}
+
+/**
+ * @brief Take the end-of-step sample that PublishOutputs reports
+ * @note When aggregating, the sample taken after the last routing step already
+ *       is the end-of-step value, so SWMM is only read again if no step was taken
+ */
+static void SampleStepOutputs() {
+    if (!s_plan.aggregating || s_plan.agg_steps == 0) SampleOutputs();
+}
+
+/**
+ * @brief Write the outputs for this XF_CALCULATE to GoldSim
+ * @note Without any routing step since the last reset (first call, or SWMM
+ *       already at the target time) every mode reports the current value,
+ *       except INTEGRAL which reports 0.
+ */
+static void PublishOutputs(double* outargs) {
+    const PlanEntry* e = s_plan.outputs.data();
+    const int n = (int)s_plan.outputs.size();
+    const double* x = s_plan.sample.data();
+    if (!s_plan.aggregating || s_plan.agg_steps == 0) {
+        for (int i = 0; i < n; i++)
+            outargs[e[i].slot] = (s_plan.aggregating && s_plan.agg_mode[i] == AGG_INTEGRAL) ? 0.0 : x[i];
+    } else {
+        const double* sum = s_plan.acc.data();
+        const double* hi = sum + 2 * n;
+        const double* lo = sum + 3 * n;
+        const double seconds = s_plan.agg_seconds;
+        for (int i = 0; i < n; i++) {
+            double v;
+            switch (s_plan.agg_mode[i]) {
+            case AGG_MEAN:     v = (seconds > 0.0) ? sum[i] / seconds : x[i]; break;
+            case AGG_MAX:      v = hi[i]; break;
+            case AGG_MIN:      v = lo[i]; break;
+            case AGG_INTEGRAL: v = sum[i]; break;
+            default:           v = x[i]; break;
+            }
+            outargs[e[i].slot] = v;
+        }
+    }
+
+    // Per-output trace kept out of the loops above
+    if (s_log_level >= 3) {
+        for (int k = 0; k < ACC_COUNT; k++)
+            for (int i = s_plan.begin[k]; i < s_plan.begin[k + 1]; i++)
+                Log(3, "  Output[%d]: accessor=%d, args=(%d, %d), aggregation=%d, value=%.6f",
+                    e[i].slot, k, e[i].arg0, e[i].arg1, s_plan.agg_mode[i], outargs[e[i].slot]);
+    }
+}
+
+static void ApplyInputs() {
+    for (const auto& e : s_plan.inputs)
+        Log(2, "  Setting input[%d]: prop=%d, idx=%d, value=%.4f", e.slot, e.arg0, e.arg1, s_pending_inputs[e.slot]);
+
+    uint64_t t0 = s_profiler.Start();
+    const int n = (int)s_plan.inputs.size();
+    bool batched = false;
+    if (n > 0 && s_setValues) {
+        double* v = s_plan.input_buf.data();
+        for (int i = 0; i < n; i++) v[i] = s_pending_inputs[s_plan.inputs[i].slot];
+        batched = s_setValues(s_plan.input_props.data(), s_plan.input_index.data(), n, v) == 0;
+    }
+    if (!batched) {
+        for (const auto& e : s_plan.inputs)
+            swmm_setValue(e.arg0, e.arg1, s_pending_inputs[e.slot]);
+    }
+    s_profiler.Stop(PH_INPUT_APPLY, t0);
+}
+
+/**
+ * @brief Advance SWMM to a target elapsed time (SYNC coupling)
+ * @param target_days GoldSim elapsed time converted to days
+ * @return 0 on success, < 0 on SWMM error, > 0 if the simulation ended
+ * @note Uses swmm_stride when swmm5.dll exports it, otherwise repeated
+ *       swmm_step calls. Output aggregation needs every routing step, so it
+ *       forces the swmm_step loop. SWMM keeps its own routing step, so it may
+ *       end up slightly past the target; it does not step if already there.
+ */
+static int StepToTime(double target_days) {
+    if (target_days <= s_swmm_elapsed + SYNC_TOLERANCE_DAYS) {
+        Log(2, "SWMM at %.6f days is already at target %.6f days, not stepping", s_swmm_elapsed, target_days);
+        return 0;
+    }
+
+    double elapsed = 0.0;
+    int ec = 0;
+    if (s_stride && !s_plan.aggregating) {
+        int stride = (int)((target_days - s_swmm_elapsed) * 86400.0 + 0.5);
+        Log(2, "Calling swmm_stride(%d s) to reach %.6f days", stride, target_days);
+        uint64_t t0 = s_profiler.Start();
+        ec = s_stride(stride, &elapsed);
+        s_profiler.Stop(PH_SWMM_STEP, t0);
+        if (ec == 0 && elapsed <= 0.0) ec = 1;  // elapsed == 0 marks the end of the simulation
+        if (ec == 0) s_swmm_elapsed = elapsed;
+    } else {
+        int steps = 0;
+        while (s_swmm_elapsed < target_days - SYNC_TOLERANCE_DAYS) {
+            uint64_t t0 = s_profiler.Start();
+            ec = swmm_step(&elapsed);
+            s_profiler.Stop(PH_SWMM_STEP, t0);
+            if (ec == 0 && elapsed <= 0.0) ec = 1;
+            if (ec != 0) break;
+            AccumulateStep(elapsed);
+            s_swmm_elapsed = elapsed;
+            steps++;
+        }
+        Log(2, "Took %d swmm_step calls to reach %.6f days (target %.6f)", steps, s_swmm_elapsed, target_days);
+    }
+    return ec;
+}
+
+/**
+ * @brief Take one swmm_step (STEP coupling)
+ * @return swmm_step error code: 0 on success, < 0 on error, > 0 at the end
+ */
+static int StepOnce() {
+    Log(2, "Calling swmm_step");
+    double elapsed;
+    uint64_t t0 = s_profiler.Start();
+    int ec = swmm_step(&elapsed);
+    s_profiler.Stop(PH_SWMM_STEP, t0);
+    Log(2, "swmm_step returned: %d, elapsed=%.6f days (%.2f minutes)", ec, elapsed, elapsed * 1440.0);
+    if (ec == 0) {
+        AccumulateStep(elapsed);
+        s_swmm_elapsed = elapsed;
+    }
+    return ec;
+}
+
+/**
+ * @brief Look-ahead job run on s_worker between XF_CALCULATE calls
+ * @note Same sequence as the synchronous path: apply the stored inputs, step,
+ *       and take the end-of-step sample. The calling thread waits for it
+ *       before touching SWMM again, so SWMM is never called concurrently.
+ */
+static int LookAheadStep() {
+    AllocTracker::Scope alloc_scope(AllocTracker::M_CALCULATE);   // part of the XF_CALCULATE that submitted it
+    ApplyInputs();
+    if (s_plan.aggregating) ResetAccumulators();
+    int ec = StepOnce();
+    if (ec == 0) SampleStepOutputs();
+    return ec;
+}
+
+static void StoreInputs(const double* inargs) {
+    for (const auto& e : s_plan.inputs) {
+        s_pending_inputs[e.slot] = inargs[e.slot];
+        Log(2, "  Stored input[%d] for next step: value=%.4f", e.slot, inargs[e.slot]);
+    }
+}
+
+static PlanRecord ToRecord(const Resolved& r) {
+    PlanRecord p = { r.iface_idx, r.obj_type, r.prop_enum, r.swmm_idx, r.lid_idx, r.accessor, r.aggregation };
+    return p;
+}
+
+static Resolved FromRecord(const PlanRecord& p) {
+    Resolved r(p.iface_idx, p.obj_type, p.prop_enum, p.swmm_idx);
+    r.lid_idx = p.lid_idx;
+    r.is_lid = (p.accessor != ACC_VALUE);
+    r.accessor = p.accessor;
+    r.aggregation = p.aggregation;
+    return r;
+}
+
+static bool ValidRecord(const PlanRecord& p) {
+    return ((p.obj_type >= swmm_GAGE && p.obj_type <= swmm_LINK) || p.obj_type == swmm_SYSTEM) &&
+           p.accessor >= 0 && p.accessor < ACC_COUNT && p.aggregation >= AGG_INSTANTANEOUS && p.aggregation <= AGG_INTEGRAL;
+}
+
+/**
+ * @brief Take the settings and resolved mapping from PLAN_FILE
+ * @param reason Why the plan was not used, on a miss
+ * @return true on a hit: s_inputs/s_outputs are resolved and the JSON is not parsed
+ * @note Hashes CONFIG_FILE and MODEL_FILE; a plan written for other contents
+ *       is ignored and replaced after the next resolution
+ */
+static bool LoadCachedPlan(std::string& reason) {
+    s_hashed = PlanCache::HashFile(CONFIG_FILE, s_config_hash) && PlanCache::HashFile(MODEL_FILE, s_model_hash);
+    if (!s_hashed) {
+        reason = "cannot read " CONFIG_FILE " or " MODEL_FILE;
+        return false;
+    }
+    PlanCache cache;
+    if (!cache.Load(PLAN_FILE, s_config_hash, s_model_hash, reason)) return false;
+    if (cache.GetSettings().recycle_project && cache.GetSettings().output_policy != OUTPUT_NONE) {
+        reason = "recycle_project without output_policy NONE";   // rejected by the JSON checks
+        return false;
+    }
+
+    // Inputs and outputs are contiguous in the file
+    const PlanRecord* rec = cache.GetInputs();
+    const int n = cache.GetInputCount() + cache.GetOutputCount();
+    for (int i = 0; i < n; i++) {
+        if (!ValidRecord(rec[i])) {
+            reason = "invalid record";
+            return false;
+        }
+    }
+    s_inputs.clear();
+    s_outputs.clear();
+    for (int i = 0; i < n; i++)
+        (i < cache.GetInputCount() ? s_inputs : s_outputs).push_back(FromRecord(rec[i]));
+    s_input_count = (int)s_inputs.size();
+    s_output_count = (int)s_outputs.size();
+    s_resolved = true;
+    s_plan_compiled = false;
+
+    const PlanSettings& ps = cache.GetSettings();
+    s_log_level = ps.log_level;
+    s_profiler.SetEnabled(ps.profiling != 0);
+    s_profiler.SetTimeline(ps.timeline_file[0] ? &s_timeline : NULL);
+    s_coupling_mode = ps.coupling_mode;
+    s_elapsed_to_days = ps.elapsed_to_days;
+    s_pipelined = (ps.pipelined != 0);
+    s_spinup_days = ps.spinup_days;
+    s_output_policy = ps.output_policy;
+    s_report_file = ps.report_file;
+    s_output_file = ps.output_file;
+    s_series_file = ps.series_file;
+    s_series_decimation = ps.series_decimation;
+    s_recycle = (ps.recycle_project != 0);
+    s_call_trace = ps.call_trace;
+    s_timeline_file = ps.timeline_file;
+    s_plan_cache = false;
+    return true;
+}
+
+/**
+ * @brief Write the resolved mapping and settings to PLAN_FILE
+ * @note A write failure is logged and otherwise ignored; the next session
+ *       simply resolves the names again
+ */
+static void SavePlan() {
+    PlanSettings ps = {};
+    ps.log_level = s_log_level;
+    ps.coupling_mode = s_coupling_mode;
+    ps.pipelined = s_pipelined ? 1 : 0;
+    ps.profiling = s_profiler.IsEnabled() ? 1 : 0;
+    ps.elapsed_to_days = s_elapsed_to_days;
+    ps.spinup_days = s_spinup_days;
+    ps.output_policy = s_output_policy;
+    strncpy_s(ps.report_file, sizeof(ps.report_file), s_report_file.c_str(), _TRUNCATE);
+    strncpy_s(ps.output_file, sizeof(ps.output_file), s_output_file.c_str(), _TRUNCATE);
+    ps.series_decimation = s_series_decimation;
+    strncpy_s(ps.series_file, sizeof(ps.series_file), s_series_file.c_str(), _TRUNCATE);
+    ps.recycle_project = s_recycle ? 1 : 0;
+    strncpy_s(ps.call_trace, sizeof(ps.call_trace), s_call_trace.c_str(), _TRUNCATE);
+    strncpy_s(ps.timeline_file, sizeof(ps.timeline_file), s_timeline_file.c_str(), _TRUNCATE);
+    std::vector<PlanRecord> in, out;
+    for (const auto& r : s_inputs) in.push_back(ToRecord(r));
+    for (const auto& r : s_outputs) out.push_back(ToRecord(r));
+    std::string err;
+    if (PlanCache::Save(PLAN_FILE, s_config_hash, s_model_hash, ps, in, out, err))
+        Log(2, "Wrote compiled plan %s (%zu inputs, %zu outputs)", PLAN_FILE, in.size(), out.size());
+    else
+        Log(1, "Could not write plan cache: %s", err.c_str());
+}
+
+/**
+ * @brief Drop the hot-start snapshot so the next realization spins up again
+ */
+static void DiscardSnapshot() {
+    if (s_snapshot.empty()) return;
+    Log(2, "Discarding hot-start snapshot (%zu bytes)", s_snapshot.size());
+    s_snapshot.clear();
+    s_snapshot.shrink_to_fit();
 }
 
 static bool LoadMapping(double* outargs, int* status) {
     if (s_mapping_loaded) return true;
+    DiscardSnapshot();   // taken under the previous mapping's model and spin-up
     std::string err;
+    uint64_t t0 = BridgeProfiler::Now();  // enabled state is only known after loading
+    std::string miss;
+    if (LoadCachedPlan(miss)) {
+        if (s_profiler.IsEnabled()) s_profiler.Record(PH_MAPPING_LOAD, BridgeProfiler::Now() - t0);
+        Log(2, "Loaded compiled plan %s: %d inputs, %d outputs (log level %d, %s coupling)", PLAN_FILE,
+            s_input_count, s_output_count, s_log_level, s_coupling_mode == COUPLE_SYNC ? "SYNC" : "STEP");
+        s_mapping_loaded = true;
+        return true;
+    }
+    s_resolved = false;
+    s_plan_compiled = false;
     if (!s_mapping.LoadFromFile(CONFIG_FILE, err)) {
         Log(1, "Mapping load failed: %s", err.c_str());
         SetError(outargs, status, "Mapping file not found. Run: python generate_mapping.py model.inp");
@@ -181,25 +936,443 @@ static bool LoadMapping(double* outargs, int* status) {
     else if (level == "OFF" || level == "NONE") s_log_level = 0;
     
     Log(2, "Log level set to: %s (%d)", level.c_str(), s_log_level);
+
+    s_profiler.SetEnabled(s_mapping.GetProfiling());
+    if (s_profiler.IsEnabled()) {
+        s_profiler.Record(PH_MAPPING_LOAD, BridgeProfiler::Now() - t0);
+        Log(2, "Profiling enabled: summary written to %s at XF_CLEANUP", PROFILE_FILE);
+    }
+    
+    // Time coupling from JSON
+    const std::string& mode = s_mapping.GetCouplingMode();
+    const std::string& units = s_mapping.GetElapsedTimeUnits();
+    if (mode == "STEP") s_coupling_mode = COUPLE_STEP;
+    else if (mode == "SYNC") s_coupling_mode = COUPLE_SYNC;
+    else {
+        sprintf_s(s_error_buf, "Unknown coupling_mode: %s (expected STEP or SYNC)", mode.c_str());
+        Log(1, "%s", s_error_buf);
+        SetError(outargs, status, s_error_buf);
+        return false;
+    }
+    if (units == "SECONDS") s_elapsed_to_days = 1.0 / 86400.0;
+    else if (units == "MINUTES") s_elapsed_to_days = 1.0 / 1440.0;
+    else if (units == "HOURS") s_elapsed_to_days = 1.0 / 24.0;
+    else if (units == "DAYS") s_elapsed_to_days = 1.0;
+    else {
+        sprintf_s(s_error_buf, "Unknown elapsed_time_units: %s", units.c_str());
+        Log(1, "%s", s_error_buf);
+        SetError(outargs, status, s_error_buf);
+        return false;
+    }
+    Log(2, "Coupling mode: %s (ElapsedTime in %s)", mode.c_str(), units.c_str());
+    s_pipelined = s_mapping.GetPipelinedStepping();
+    if (s_pipelined && s_coupling_mode != COUPLE_STEP) {
+        // The SYNC target time is only known when the next call arrives
+        sprintf_s(s_error_buf, "pipelined_stepping requires coupling_mode STEP");
+        Log(1, "%s", s_error_buf);
+        SetError(outargs, status, s_error_buf);
+        return false;
+    }
+    Log(2, "Pipelined stepping: %s", s_pipelined ? "ON" : "OFF");
+    s_spinup_days = s_mapping.GetHotstartSpinupDays();
+    if (s_spinup_days > 0.0) Log(2, "Hot-start spin-up: %.4f days", s_spinup_days);
+
+    const std::string& policy = s_mapping.GetOutputPolicy();
+    if (policy == "FULL") s_output_policy = OUTPUT_FULL;
+    else if (policy == "MAPPED") s_output_policy = OUTPUT_MAPPED;
+    else if (policy == "NONE") s_output_policy = OUTPUT_NONE;
+    else {
+        sprintf_s(s_error_buf, "Unknown output_policy: %s (expected FULL, MAPPED or NONE)", policy.c_str());
+        Log(1, "%s", s_error_buf);
+        SetError(outargs, status, s_error_buf);
+        return false;
+    }
+    s_report_file = s_mapping.GetReportFile();
+    s_output_file = s_mapping.GetOutputFile();
+    if (s_report_file.empty() || s_report_file.size() >= PLAN_PATH_SIZE || s_output_file.size() >= PLAN_PATH_SIZE) {
+        sprintf_s(s_error_buf, "report_file must be set and report_file/output_file shorter than %d characters",
+                  PLAN_PATH_SIZE);
+        Log(1, "%s", s_error_buf);
+        SetError(outargs, status, s_error_buf);
+        return false;
+    }
+    Log(2, "Output policy: %s (report %s, output %s)", policy.c_str(), s_report_file.c_str(),
+        s_output_file.empty() ? "(scratch file)" : s_output_file.c_str());
+
+    s_series_file = s_mapping.GetSeriesFile();
+    s_series_decimation = s_mapping.GetSeriesDecimation();
+    if (s_series_file.size() >= PLAN_PATH_SIZE || s_series_decimation < 1) {
+        sprintf_s(s_error_buf, "series_file must be shorter than %d characters and series_decimation at least 1",
+                  PLAN_PATH_SIZE);
+        Log(1, "%s", s_error_buf);
+        SetError(outargs, status, s_error_buf);
+        return false;
+    }
+    if (!s_series_file.empty())
+        Log(2, "Recording series to %s (every %d calls)", s_series_file.c_str(), s_series_decimation);
+    s_recycle = s_mapping.GetRecycleProject();
+    if (s_recycle && s_output_policy != OUTPUT_NONE) {
+        // swmm_start(1) on a recycled project appends a run to an output file swmm_end already finalized
+        sprintf_s(s_error_buf, "recycle_project requires output_policy NONE (use series_file for per-realization results)");
+        Log(1, "%s", s_error_buf);
+        SetError(outargs, status, s_error_buf);
+        return false;
+    }
+    if (s_recycle) Log(2, "Project recycling: ON (model parsed once, swmm_end/swmm_start between realizations)");
+    s_call_trace = s_mapping.GetCallTrace();
+    s_timeline_file = s_mapping.GetTimelineFile();
+    if (s_call_trace.size() >= PLAN_PATH_SIZE || s_timeline_file.size() >= PLAN_PATH_SIZE) {
+        sprintf_s(s_error_buf, "call_trace and timeline_file must be shorter than %d characters", PLAN_PATH_SIZE);
+        Log(1, "%s", s_error_buf);
+        SetError(outargs, status, s_error_buf);
+        return false;
+    }
+    if (!s_call_trace.empty()) Log(2, "Recording bridge calls to %s", s_call_trace.c_str());
+    s_profiler.SetTimeline(s_timeline_file.empty() ? NULL : &s_timeline);
+    if (!s_timeline_file.empty()) Log(2, "Timeline spans written to %s at XF_CLEANUP", s_timeline_file.c_str());
+    s_input_count = s_mapping.GetInputCount();
+    s_output_count = s_mapping.GetOutputCount();
+    s_plan_cache = s_mapping.GetPlanCache() && s_hashed;
+    if (s_plan_cache) Log(2, "Plan cache miss (%s): names will be resolved and %s written", miss.c_str(), PLAN_FILE);
+    else Log(2, "Plan cache: OFF");
     s_mapping_loaded = true;
     return true;
 }
 
+/**
+ * @brief Close a project left open by recycling (model edited, start failed, or module unloaded)
+ */
+static void CloseProject() {
+    if (!s_project_open) return;
+    swmm_close();
+    s_project_open = false;
+}
+
+/**
+ * @brief End the running realization
+ * @note With recycling only swmm_end is called: the project stays open and
+ *       the next XF_INITIALIZE restarts it. A failed swmm_end closes the
+ *       project anyway. s_plan and its buffers are kept either way, since
+ *       they only change when names are resolved again.
+ */
 static void Cleanup(int* status, double* outargs) {
     if (!s_swmm_running) return;
     
+    s_worker.Stop();  // a look-ahead step may still be running
     int e = swmm_end();
-    int c = swmm_close();
+    int c = 0;
+    if (!s_recycle || e != 0) {
+        c = swmm_close();
+        s_project_open = false;
+    }
     s_swmm_running = false;
     s_first_calculate = true;
-    s_inputs.clear();
-    s_outputs.clear();
-    s_pending_inputs.clear();
+    if (s_recorder.IsActive()) {
+        std::string err;
+        uint64_t t_flush = s_profiler.Start();
+        bool recorded = s_recorder.End(err);
+        s_profiler.Span("series_flush", t_flush);
+        if (recorded)
+            Log(2, "Recorded %lld rows of realization %d to %s", (long long)s_recorder.GetRowCount(),
+                s_recorder.GetRealization(), s_series_file.c_str());
+        else
+            Log(1, "Series recording failed: %s", err.c_str());
+    }
     if (e != 0 && *status == XF_SUCCESS) HandleSwmmError(outargs, status);
     else if (c != 0 && *status == XF_SUCCESS) HandleSwmmError(outargs, status);
 }
 
-extern "C" void __declspec(dllexport) SwmmGoldSimBridge(int methodID, int* status, double* inargs, double* outargs) {
+/**
+ * @brief Closes the project when the module is unloaded (FreeLibrary, dlclose or process exit)
+ * @note Recycling keeps the project open after the last XF_CLEANUP, and GoldSim may unload
+ *       the DLL mid-realization; either way SWMM's report and output files are released here.
+ *       Declared after s_worker, so it is destroyed first.
+ */
+static struct ProjectCloser {
+    ~ProjectCloser() {
+        if (s_swmm_running) {
+            s_worker.Stop();
+            swmm_end();
+            s_swmm_running = false;
+        }
+        CloseProject();
+    }
+} s_project_closer;
+
+/**
+ * @brief Run the hot-start spin-up and capture the snapshot (first realization)
+ * @return false on error (status and message already set)
+ * @note SWMM runs on its own inputs (rain gages, time series) during spin-up;
+ *       GoldSim inputs are applied from time 0. Without the state API the
+ *       spin-up is simply repeated in every realization.
+ */
+static bool RunSpinup(double* outargs, int* status) {
+    Log(2, "Hot-start spin-up: advancing SWMM %.4f days before GoldSim time 0", s_spinup_days);
+    int ec = StepToTime(s_spinup_days);
+    if (ec < 0) {
+        Log(1, "swmm_step failed during spin-up with error: %d", ec);
+        HandleSwmmError(outargs, status);
+        Cleanup(status, outargs);
+        return false;
+    }
+    if (ec > 0) {
+        sprintf_s(s_error_buf, "Simulation ended during the %.4f day hot-start spin-up", s_spinup_days);
+        Log(1, "%s", s_error_buf);
+        Cleanup(status, outargs); SetError(outargs, status, s_error_buf);
+        return false;
+    }
+    if (s_plan.aggregating) ResetAccumulators();
+    s_elapsed_offset = s_swmm_elapsed;
+
+    if (!(s_getStateSize && s_saveState && s_loadState)) {
+        Log(1, "swmm5.dll has no state snapshot API; spin-up will be repeated every realization");
+        return true;
+    }
+    int size = s_getStateSize();
+    if (size > 0) {
+        s_snapshot.resize((size_t)size);
+        int n = s_saveState(s_snapshot.data(), size, &s_snapshot_date);
+        if (n > 0) s_snapshot.resize((size_t)n);
+        else s_snapshot.clear();
+    }
+    if (s_snapshot.empty()) {
+        Log(1, "swmm_saveState failed; spin-up will be repeated every realization");
+        return true;
+    }
+    s_snapshot_spinup_days = s_spinup_days;
+    s_snapshot_model_hash = s_model_hash;
+    Log(2, "Captured hot-start snapshot: %zu bytes at date %.6f (elapsed %.6f days)",
+        s_snapshot.size(), s_snapshot_date, s_swmm_elapsed);
+    return true;
+}
+
+/**
+ * @brief Resolve every mapped input and output to SWMM indices (s_inputs, s_outputs)
+ * @return false on error (status and message already set)
+ */
+static bool ResolveMapping(double* outargs, int* status) {
+    ElementIndex elements;
+
+    // Resolve inputs
+    Log(2, "Resolving %d inputs", s_mapping.GetInputCount());
+    s_inputs.clear();
+    for (const auto& inp : s_mapping.GetInputs()) {
+        Log(3, "  Input[%d]: %s (%s/%s)", inp.interface_index, inp.name.c_str(), inp.object_type.c_str(), inp.property.c_str());
+        const PropertyEntry* pe = LookupProperty('I', inp.object_type, inp.property);
+        if (!pe) {
+            sprintf_s(s_error_buf, "Unknown input: %s/%s", inp.object_type.c_str(), inp.property.c_str());
+            Log(1, "%s", s_error_buf);
+            Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return false;
+        }
+        
+        // PROPERTY_SKIP (SYSTEM/ELAPSEDTIME) has no element
+        int idx = (pe->obj == swmm_SYSTEM) ? 0 : FindElement(elements, pe->obj, inp.name);
+        if (idx < 0) {
+            ElementNotFound(elements, pe->obj, "Element not found", inp.name, inp.name);
+            Log(1, "%s", s_error_buf);
+            Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return false;
+        }
+        Log(3, "    Resolved: obj=%d, prop=%d, idx=%d", pe->obj, pe->prop, idx);
+        s_inputs.push_back({ inp.interface_index, pe->obj, pe->prop, idx });
+    }
+
+    // Resolve outputs
+    Log(2, "Resolving %d outputs", s_mapping.GetOutputCount());
+    s_outputs.clear();
+    LidNameIndex lid_names;
+    for (const auto& out : s_mapping.GetOutputs()) {
+        Log(3, "  Output[%d]: %s (%s/%s)", out.interface_index, out.name.c_str(), out.object_type.c_str(), out.property.c_str());
+        int aggregation = AggregationFromString(out.aggregation);
+        if (aggregation < 0) {
+            sprintf_s(s_error_buf, "Unknown aggregation: %s (%s)", out.aggregation.c_str(), out.name.c_str());
+            Log(1, "%s", s_error_buf);
+            Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return false;
+        }
+        
+        // Check if this is an LID output (either by object_type or composite ID)
+        std::string subcatch_name, lid_name;
+        bool is_lid_output = (out.object_type == "LID") || ParseCompositeID(out.name, subcatch_name, lid_name);
+        
+        if (is_lid_output) {
+            // This is an LID output
+            // If object_type is "LID" but name isn't composite, parse it now
+            if (out.object_type == "LID" && subcatch_name.empty()) {
+                if (!ParseCompositeID(out.name, subcatch_name, lid_name)) {
+                    sprintf_s(s_error_buf, "LID output must use composite ID format 'Subcatchment/LIDControl': %s", out.name.c_str());
+                    Log(1, "%s", s_error_buf);
+                    Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return false;
+                }
+            }
+            
+            Log(3, "    Detected LID output: subcatch='%s', lid='%s'", subcatch_name.c_str(), lid_name.c_str());
+            
+            // Resolve subcatchment index
+            int subcatch_idx = FindElement(elements, swmm_SUBCATCH, subcatch_name);
+            if (subcatch_idx < 0) {
+                ElementNotFound(elements, swmm_SUBCATCH, "Subcatchment not found in composite ID", out.name, subcatch_name);
+                Log(1, "%s", s_error_buf);
+                Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return false;
+            }
+            
+            // Resolve LID unit index
+            int lid_count = 0;
+            int lid_idx = ResolveLidIndex(lid_names, subcatch_idx, lid_name, lid_count);
+            if (lid_idx == LID_DUPLICATE) {
+                sprintf_s(s_error_buf, "Duplicate LID control '%s' in subcatchment '%s': composite ID is ambiguous (%s)",
+                          lid_name.c_str(), subcatch_name.c_str(), out.name.c_str());
+                Log(1, "%s", s_error_buf);
+                Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return false;
+            }
+            if (lid_idx < 0) {
+                sprintf_s(s_error_buf, "LID unit not found in composite ID: %s (subcatch has %d LID units)", out.name.c_str(), lid_count);
+                Log(1, "%s", s_error_buf);
+                Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return false;
+            }
+            
+            int accessor = LidPropToAccessor(out.property);
+            if (accessor < 0) {
+                sprintf_s(s_error_buf, "Unknown LID property: %s (%s)", out.property.c_str(), out.name.c_str());
+                Log(1, "%s", s_error_buf);
+                Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return false;
+            }
+            
+            Log(3, "    Resolved LID: subcatch_idx=%d, lid_idx=%d, property=%s", subcatch_idx, lid_idx, out.property.c_str());
+            s_outputs.push_back(Resolved::CreateLidOutput(out.interface_index, subcatch_idx, lid_idx, accessor));
+        } else {
+            // Regular (non-LID) output - use existing logic
+            const PropertyEntry* pe = LookupProperty('O', out.object_type, out.property);
+            if (!pe) {
+                sprintf_s(s_error_buf, "Unknown output: %s/%s", out.object_type.c_str(), out.property.c_str());
+                Log(1, "%s", s_error_buf);
+                Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return false;
+            }
+            int idx = FindElement(elements, pe->obj, out.name);
+            if (idx < 0) {
+                ElementNotFound(elements, pe->obj, "Element not found", out.name, out.name);
+                Log(1, "%s", s_error_buf);
+                Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return false;
+            }
+            Log(3, "    Resolved: obj=%d, prop=%d, idx=%d", pe->obj, pe->prop, idx);
+            s_outputs.push_back(Resolved(out.interface_index, pe->obj, pe->prop, idx));
+        }
+        s_outputs.back().aggregation = aggregation;
+    }
+    return true;
+}
+
+/**
+ * @brief Restrict the elements SWMM reports to what s_output_policy asks for
+ * @note Report flags are only honoured between swmm_open and swmm_start.
+ *       System-wide results are always written.
+ */
+static void ApplyOutputPolicy() {
+    if (s_output_policy == OUTPUT_FULL) return;
+    static const int kRptFlag[] = { -1, swmm_SUBCATCH_RPTFLAG, swmm_NODE_RPTFLAG, swmm_LINK_RPTFLAG };
+    int cleared = 0;
+    for (int obj = swmm_SUBCATCH; obj <= swmm_LINK; obj++) {
+        int n = swmm_getCount(obj);
+        for (int i = 0; i < n; i++) swmm_setValue(kRptFlag[obj], i, 0.0);
+        cleared += n;
+    }
+    if (s_output_policy == OUTPUT_NONE) {
+        Log(2, "Output policy NONE: reporting disabled for %d elements", cleared);
+        return;
+    }
+
+    // The element each entry reads or writes (LID outputs: the subcatchment)
+    int reported = 0;
+    for (const auto* list : { &s_inputs, &s_outputs }) {
+        for (const auto& r : *list) {
+            if (r.obj_type < swmm_SUBCATCH || r.obj_type > swmm_LINK) continue;   // gages and SYSTEM have no report flag
+            swmm_setValue(kRptFlag[r.obj_type], r.swmm_idx, 1.0);
+            reported++;
+        }
+    }
+    Log(2, "Output policy MAPPED: reporting %d mapped entries of %d elements", reported, cleared);
+}
+
+/**
+ * @brief Append the call just made to the "call_trace" file
+ * @note The file is recreated when the mapping or model changes; a failure
+ *       to open or write it is logged and otherwise ignored
+ */
+static void TraceCall(int methodID, int status, const double* inargs, const double* outargs) {
+    if (s_call_trace.empty()) {
+        if (s_trace.IsOpen()) s_trace.Close();
+        return;
+    }
+    if (!s_trace.IsOpen() || s_trace.GetPath() != s_call_trace || s_trace.GetConfigHash() != s_config_hash ||
+        s_trace.GetModelHash() != s_model_hash) {
+        std::string err;
+        if (!s_trace.Open(s_call_trace.c_str(), s_config_hash, s_model_hash, s_input_count, s_output_count, err)) {
+            Log(1, "Call trace disabled: %s", err.c_str());
+            s_call_trace.clear();
+            return;
+        }
+    }
+
+    // Only what the bridge read and wrote: INITIALIZE ignores inargs, and a
+    // CALCULATE that ended the simulation leaves outargs untouched
+    int inputs = 0, outputs = 0;
+    const char* message = NULL;
+    if (methodID == XF_CALCULATE) inputs = s_input_count;
+    if (status == XF_FAILURE_WITH_MSG) message = (const char*)*(const ULONG_PTR*)outargs;
+    else if (status == XF_SUCCESS) {
+        if (methodID == XF_REP_VERSION) outputs = 1;
+        else if (methodID == XF_REP_ARGUMENTS) outputs = 2;
+        else if (methodID == XF_CALCULATE && s_swmm_running) outputs = s_output_count;
+    }
+    s_trace.Record(methodID, status, inargs, inputs, outargs, outputs, message);
+    if (methodID == XF_CLEANUP) {
+        std::string err;
+        uint64_t t_flush = s_profiler.Start();
+        bool flushed = s_trace.Flush(err);
+        s_profiler.Span("call_trace_flush", t_flush);
+        if (flushed)
+            Log(2, "Call trace: %lld calls in %s", (long long)s_trace.GetCallCount(), s_call_trace.c_str());
+        else
+            Log(1, "Call trace: %s", err.c_str());
+    }
+}
+
+static const char* MethodName(int methodID) {
+    switch (methodID) {
+    case XF_INITIALIZE: return "XF_INITIALIZE";
+    case XF_CALCULATE: return "XF_CALCULATE";
+    case XF_REP_VERSION: return "XF_REP_VERSION";
+    case XF_REP_ARGUMENTS: return "XF_REP_ARGUMENTS";
+    case XF_CLEANUP: return "XF_CLEANUP";
+    default: return "unknown method";
+    }
+}
+
+/**
+ * @brief Append the spans buffered since the last XF_CLEANUP to "timeline_file"
+ * @note Runs after the logger has shut down, so a failure restarts it briefly
+ */
+static void WriteTimeline() {
+    std::string err;
+    if (!s_timeline.Write(s_timeline_file.c_str(), err)) {
+        Log(1, "Timeline not written: %s", err.c_str());
+        s_logger.Shutdown();
+    }
+}
+
+/**
+ * @brief Log the heap allocations counted per method since the DLL was loaded
+ * @note Only built with GSSWMM_ALLOC_TRACKING; the counts include this call so far
+ */
+static void LogAllocations() {
+    for (int m = 0; m < AllocTracker::M_COUNT; m++) {
+        AllocStats a = AllocTracker::Get(m);
+        if (a.calls == 0) continue;
+        Log(2, "Allocations in %s: %lld calls, %lld allocations (%.2f per call), %lld bytes",
+            AllocTracker::MethodName(m), (long long)a.calls, (long long)a.allocs, (double)a.allocs / a.calls,
+            (long long)a.bytes);
+    }
+}
+
+static void Dispatch(int methodID, int* status, double* inargs, double* outargs) {
     *status = XF_SUCCESS;
     Log(2, "=== Method called: %d ===", methodID);
 
@@ -216,9 +1389,9 @@ extern "C" void __declspec(dllexport) SwmmGoldSimBridge(int methodID, int* statu
             Log(1, "XF_REP_ARGUMENTS: LoadMapping failed");
             break;
         }
-        outargs[0] = (double)s_mapping.GetInputCount();
-        outargs[1] = (double)s_mapping.GetOutputCount();
-        Log(2, "REP_ARGUMENTS: %d inputs, %d outputs", s_mapping.GetInputCount(), s_mapping.GetOutputCount());
+        outargs[0] = (double)s_input_count;
+        outargs[1] = (double)s_output_count;
+        Log(2, "REP_ARGUMENTS: %d inputs, %d outputs", s_input_count, s_output_count);
         break;
 
     case XF_INITIALIZE:
@@ -233,126 +1406,127 @@ extern "C" void __declspec(dllexport) SwmmGoldSimBridge(int methodID, int* statu
                 }
             }
             
+            // A model edited since the mapping was loaded invalidates the resolved indices
+            // and any project kept open by recycling
+            uint64_t model_hash;
+            if (s_mapping_loaded &&
+                !(s_hashed && PlanCache::HashFile(MODEL_FILE, model_hash) && model_hash == s_model_hash)) {
+                Log(2, "%s changed since the mapping was loaded; reloading", MODEL_FILE);
+                s_mapping_loaded = false;
+                s_resolved = false;
+                s_plan_compiled = false;
+                DiscardSnapshot();
+                CloseProject();
+            }
+
             if (!LoadMapping(outargs, status)) {
                 Log(1, "XF_INITIALIZE: LoadMapping failed");
                 break;
             }
             Log(2, "Mapping loaded successfully");
 
-            // Open SWMM
-            Log(2, "Opening SWMM model: model.inp");
-            int open_err = swmm_open("model.inp", "model.rpt", "model.out");
-            if (open_err != 0) { 
-                Log(1, "swmm_open failed with error: %d", open_err);
-                HandleSwmmError(outargs, status); 
-                break; 
+            BindOptionalExports();
+            if (s_project_open && !s_recycle) CloseProject();
+
+            // Open SWMM, unless recycling kept the previous realization's project open
+            bool resolved_now = false;
+            if (s_project_open) {
+                Log(2, "Recycling open SWMM project (no swmm_open, no name resolution)");
+            } else {
+                Log(2, "Opening SWMM model: %s", MODEL_FILE);
+                uint64_t t_open = s_profiler.Start();
+                int open_err = swmm_open(MODEL_FILE, s_report_file.c_str(), s_output_file.c_str());
+                s_profiler.Stop(PH_SWMM_OPEN, t_open);
+                if (open_err != 0) { 
+                    Log(1, "swmm_open failed with error: %d", open_err);
+                    HandleSwmmError(outargs, status); 
+                    break; 
+                }
+                Log(2, "swmm_open succeeded");
+
+                // Names are resolved once per process, or not at all on a plan cache hit.
+                // This happens before swmm_start so the report flags can still be set.
+                resolved_now = !s_resolved;
+                if (resolved_now) {
+                    uint64_t t_resolve = s_profiler.Start();
+                    bool resolved = ResolveMapping(outargs, status);
+                    s_profiler.Stop(PH_RESOLVE, t_resolve);
+                    if (!resolved) {
+                        swmm_close();
+                        break;
+                    }
+                    s_resolved = true;
+                } else {
+                    Log(2, "Reusing resolved mapping: %zu inputs, %zu outputs", s_inputs.size(), s_outputs.size());
+                }
+                ApplyOutputPolicy();
+                s_project_open = true;
             }
-            Log(2, "swmm_open succeeded");
             
+            // Later realizations start at the end of the spin-up, if it was taken from this
+            // model with this spin-up length
+            bool restore = !s_snapshot.empty();
+            if (restore && !(s_snapshot_spinup_days == s_spinup_days && s_hashed &&
+                             s_snapshot_model_hash == s_model_hash)) {
+                Log(2, "Hot-start snapshot does not match the model or spin-up length; spinning up again");
+                DiscardSnapshot();
+                restore = false;
+            }
+            if (restore) {
+                Log(2, "Moving start date to hot-start snapshot date %.6f", s_snapshot_date);
+                swmm_setValue(swmm_STARTDATE, 0, s_snapshot_date);
+            }
+
             Log(2, "Starting SWMM simulation");
-            int start_err = swmm_start(1);
+            uint64_t t_start = s_profiler.Start();
+            int start_err = swmm_start(s_output_policy == OUTPUT_NONE ? 0 : 1);
             if (start_err != 0) { 
                 Log(1, "swmm_start failed with error: %d", start_err);
-                swmm_close(); 
+                CloseProject(); 
                 HandleSwmmError(outargs, status); 
                 break; 
             }
             Log(2, "swmm_start succeeded");
 
-            // Resolve inputs
-            Log(2, "Resolving %d inputs", s_mapping.GetInputCount());
-            s_inputs.clear();
-            for (const auto& inp : s_mapping.GetInputs()) {
-                Log(2, "  Input[%d]: %s (%s/%s)", inp.interface_index, inp.name.c_str(), inp.object_type.c_str(), inp.property.c_str());
-                int obj = ObjTypeToSwmm(inp.object_type);
-                int prop = InputPropToEnum(inp.object_type, inp.property);
-                
-                // PROPERTY_SKIP is valid (for SYSTEM/ELAPSEDTIME)
-                if (obj < 0 || (prop < 0 && prop != PROPERTY_SKIP)) {
-                    sprintf_s(s_error_buf, "Unknown input: %s/%s", inp.object_type.c_str(), inp.property.c_str());
-                    Log(1, "%s", s_error_buf);
-                    Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return;
-                }
-                
-                int idx = (inp.object_type == "SYSTEM") ? 0 : swmm_getIndex((swmm_Object)obj, inp.name.c_str());
-                if (inp.object_type != "SYSTEM" && idx < 0) {
-                    sprintf_s(s_error_buf, "Element not found: %s", inp.name.c_str());
-                    Log(1, "%s", s_error_buf);
-                    Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return;
+            if (restore) {
+                int load_err = s_loadState(s_snapshot.data(), (int)s_snapshot.size());
+                if (load_err != 0) {
+                    Log(1, "swmm_loadState failed with error: %d", load_err);
+                    HandleSwmmError(outargs, status);
+                    swmm_end();
+                    CloseProject();
+                    break;
                 }
-                Log(2, "    Resolved: obj=%d, prop=%d, idx=%d", obj, prop, idx);
-                s_inputs.push_back({ inp.interface_index, prop, idx });
+                Log(2, "Restored hot-start snapshot (%zu bytes)", s_snapshot.size());
             }
-
-            // Resolve outputs
-            Log(2, "Resolving %d outputs", s_mapping.GetOutputCount());
-            s_outputs.clear();
-            for (const auto& out : s_mapping.GetOutputs()) {
-                Log(2, "  Output[%d]: %s (%s/%s)", out.interface_index, out.name.c_str(), out.object_type.c_str(), out.property.c_str());
-                
-                // Check if this is an LID output (either by object_type or composite ID)
-                std::string subcatch_name, lid_name;
-                bool is_lid_output = (out.object_type == "LID") || ParseCompositeID(out.name, subcatch_name, lid_name);
-                
-                if (is_lid_output) {
-                    // This is an LID output
-                    // If object_type is "LID" but name isn't composite, parse it now
-                    if (out.object_type == "LID" && subcatch_name.empty()) {
-                        if (!ParseCompositeID(out.name, subcatch_name, lid_name)) {
-                            sprintf_s(s_error_buf, "LID output must use composite ID format 'Subcatchment/LIDControl': %s", out.name.c_str());
-                            Log(1, "%s", s_error_buf);
-                            Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return;
-                        }
-                    }
-                    
-                    Log(2, "    Detected LID output: subcatch='%s', lid='%s'", subcatch_name.c_str(), lid_name.c_str());
-                    
-                    // Resolve subcatchment index
-                    int subcatch_idx = swmm_getIndex(swmm_SUBCATCH, subcatch_name.c_str());
-                    if (subcatch_idx < 0) {
-                        sprintf_s(s_error_buf, "Subcatchment not found in composite ID: %s", out.name.c_str());
-                        Log(1, "%s", s_error_buf);
-                        Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return;
-                    }
-                    
-                    // Debug: Check LID count for this subcatchment
-                    int lid_count = swmm_getLidUCount(subcatch_idx);
-                    Log(2, "    Subcatchment '%s' (idx=%d) has %d LID units", subcatch_name.c_str(), subcatch_idx, lid_count);
-                    
-                    // Resolve LID unit index
-                    int lid_idx = ResolveLidIndex(subcatch_idx, lid_name);
-                    if (lid_idx < 0) {
-                        sprintf_s(s_error_buf, "LID unit not found in composite ID: %s (subcatch has %d LID units)", out.name.c_str(), lid_count);
-                        Log(1, "%s", s_error_buf);
-                        Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return;
-                    }
-                    
-                    Log(2, "    Resolved LID: subcatch_idx=%d, lid_idx=%d, property=%s", subcatch_idx, lid_idx, out.property.c_str());
-                    s_outputs.push_back(Resolved::CreateLidOutput(out.interface_index, subcatch_idx, lid_idx, out.property));
-                } else {
-                    // Regular (non-LID) output - use existing logic
-                    int obj = ObjTypeToSwmm(out.object_type);
-                    int prop = OutputPropToEnum(out.object_type, out.property);
-                    if (obj < 0 || prop < 0) {
-                        sprintf_s(s_error_buf, "Unknown output: %s/%s", out.object_type.c_str(), out.property.c_str());
-                        Log(1, "%s", s_error_buf);
-                        Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return;
-                    }
-                    int idx = swmm_getIndex((swmm_Object)obj, out.name.c_str());
-                    if (idx < 0) {
-                        sprintf_s(s_error_buf, "Element not found: %s", out.name.c_str());
-                        Log(1, "%s", s_error_buf);
-                        Cleanup(status, outargs); SetError(outargs, status, s_error_buf); return;
-                    }
-                    Log(2, "    Resolved: obj=%d, prop=%d, idx=%d", obj, prop, idx);
-                    s_outputs.push_back(Resolved(out.interface_index, prop, idx));
-                }
+            s_profiler.Stop(PH_SWMM_START, t_start);
+            if (s_plan_compiled) {
+                // Same indices as last realization: keep the plan and its buffers
+                if (s_plan.aggregating) ResetAccumulators();
+            } else {
+                CompilePlan();
+                s_plan_compiled = true;
             }
-
+            if (s_coupling_mode == COUPLE_SYNC && s_plan.elapsed_slot < 0) {
+                sprintf_s(s_error_buf, "coupling_mode SYNC requires a SYSTEM/ELAPSEDTIME input");
+                Log(1, "%s", s_error_buf);
+                swmm_end(); CloseProject(); SetError(outargs, status, s_error_buf); break;
+            }
+            if (resolved_now && s_plan_cache) SavePlan();
+            s_swmm_elapsed = 0.0;
+            s_elapsed_offset = 0.0;
             s_swmm_running = true;
             s_first_calculate = true;
-            s_pending_inputs.clear();
-            s_pending_inputs.resize(s_mapping.GetInputCount(), 0.0);
+            s_pending_inputs.assign(s_input_count, 0.0);
+            if (s_spinup_days > 0.0 && !restore && !RunSpinup(outargs, status)) break;
+            s_profiler.CountRealization();
+            if (s_pipelined) s_worker.Start();
+            if (!s_series_file.empty()) {
+                // A recording problem is logged but does not stop the simulation
+                std::string err;
+                if (!s_recorder.Begin(s_series_file.c_str(), s_input_count, s_output_count, s_series_decimation, err))
+                    Log(1, "Series recording disabled for this realization: %s", err.c_str());
+            }
             Log(2, "INITIALIZE complete: %zu inputs, %zu outputs resolved", s_inputs.size(), s_outputs.size());
         }
         break;
@@ -360,131 +1534,72 @@ extern "C" void __declspec(dllexport) SwmmGoldSimBridge(int methodID, int* statu
     case XF_CALCULATE:
         {
             Log(2, "XF_CALCULATE called");
+            uint64_t t_calc = s_profiler.Start();
             if (!s_swmm_running) { 
                 Log(1, "XF_CALCULATE called but SWMM not running!");
                 *status = XF_FAILURE; 
                 break; 
             }
 
-            // On first call, we need to get initial outputs before any stepping
+            bool sampled = false;
             if (s_first_calculate) {
+                // On first call, report initial outputs before any stepping
                 Log(2, "First calculate - getting initial outputs and storing inputs for next step");
-                
-                // Get initial outputs (before any stepping)
-                Log(2, "Getting %zu initial outputs", s_outputs.size());
-                for (const auto& r : s_outputs) {
-                    double val;
-                    if (r.is_lid) {
-                        // LID output - use appropriate API based on property
-                        if (r.lid_property == "STORAGE_VOLUME") {
-                            val = swmm_getLidUStorageVolume(r.swmm_idx, r.lid_idx);
-                            Log(3, "  Output[%d]: LID storage volume, subcatch_idx=%d, lid_idx=%d, value=%.6f", 
-                                r.iface_idx, r.swmm_idx, r.lid_idx, val);
-                        } else if (r.lid_property == "SURFACE_OUTFLOW") {
-                            val = swmm_getLidUSurfaceOutflow(r.swmm_idx, r.lid_idx);
-                            Log(3, "  Output[%d]: LID surface outflow, subcatch_idx=%d, lid_idx=%d, value=%.6f", 
-                                r.iface_idx, r.swmm_idx, r.lid_idx, val);
-                        } else if (r.lid_property == "SURFACE_INFLOW") {
-                            val = swmm_getLidUSurfaceInflow(r.swmm_idx, r.lid_idx);
-                            Log(3, "  Output[%d]: LID surface inflow, subcatch_idx=%d, lid_idx=%d, value=%.6f", 
-                                r.iface_idx, r.swmm_idx, r.lid_idx, val);
-                        } else if (r.lid_property == "DRAIN_FLOW") {
-                            val = swmm_getLidUDrainFlow(r.swmm_idx, r.lid_idx);
-                            Log(3, "  Output[%d]: LID drain flow, subcatch_idx=%d, lid_idx=%d, value=%.6f", 
-                                r.iface_idx, r.swmm_idx, r.lid_idx, val);
-                        } else {
-                            Log(1, "Unknown LID property: %s", r.lid_property.c_str());
-                            val = 0.0;
-                        }
-                    } else {
-                        // Regular output - use existing API
-                        val = swmm_getValue(r.prop_enum, r.swmm_idx);
-                        Log(3, "  Output[%d]: prop=%d, idx=%d, value=%.6f", r.iface_idx, r.prop_enum, r.swmm_idx, val);
-                    }
-                    outargs[r.iface_idx] = val;
+                s_first_calculate = false;
+            } else if (s_pipelined) {
+                // The look-ahead step submitted by the previous call already
+                // applied its inputs, stepped, and sampled the outputs
+                uint64_t t_wait = s_profiler.Start();
+                int ec = s_worker.Wait();
+                s_profiler.Span("lookahead_wait", t_wait);
+                sampled = true;
+                Log(2, "Look-ahead step ready: returned %d, waited %.3f ms", ec, s_worker.GetLastWaitMs());
+                if (ec < 0) { 
+                    Log(1, "swmm_step failed with error: %d", ec);
+                    HandleSwmmError(outargs, status); 
+                    break; 
                 }
-                
-                // Store the inputs for the next timestep
-                for (const auto& r : s_inputs) {
-                    s_pending_inputs[r.iface_idx] = inargs[r.iface_idx];
-                    Log(2, "  Stored input[%d] for next step: value=%.4f", r.iface_idx, inargs[r.iface_idx]);
+                if (ec > 0) { 
+                    Log(2, "Simulation ended normally");
+                    Cleanup(status, outargs); 
+                    break; 
                 }
-                
-                s_first_calculate = false;
-                Log(2, "XF_CALCULATE complete (first call)");
-                break;
-            }
+            } else {
+                // Subsequent calls: apply the PREVIOUS inputs, step, then get outputs
+                // This ensures outputs correspond to the same time period as the inputs
+                Log(2, "Applying %zu inputs from previous timestep", s_plan.inputs.size());
+                ApplyInputs();
+                if (s_plan.aggregating) ResetAccumulators();
 
-            // For subsequent calls: apply the PREVIOUS inputs, step, then get outputs
-            // This ensures outputs correspond to the same time period as the inputs
-            
-            // Apply the inputs that were provided in the PREVIOUS call
-            Log(2, "Applying %zu inputs from previous timestep", s_inputs.size());
-            for (const auto& r : s_inputs) {
-                if (r.prop_enum != PROPERTY_SKIP) {
-                    Log(2, "  Setting input[%d]: prop=%d, idx=%d, value=%.4f", r.iface_idx, r.prop_enum, r.swmm_idx, s_pending_inputs[r.iface_idx]);
-                    swmm_setValue(r.prop_enum, r.swmm_idx, s_pending_inputs[r.iface_idx]);
-                } else {
-                    Log(2, "  Skipping input[%d] (PROPERTY_SKIP), value=%.4f", r.iface_idx, s_pending_inputs[r.iface_idx]);
+                int ec;
+                if (s_coupling_mode == COUPLE_SYNC)
+                    ec = StepToTime(s_elapsed_offset + inargs[s_plan.elapsed_slot] * s_elapsed_to_days);
+                else
+                    ec = StepOnce();
+                
+                if (ec < 0) { 
+                    Log(1, "swmm_step failed with error: %d", ec);
+                    HandleSwmmError(outargs, status); 
+                    break; 
                 }
-            }
-
-            // Step SWMM forward - may need multiple internal steps
-            Log(2, "Calling swmm_step");
-            double elapsed;
-            int ec = swmm_step(&elapsed);
-            Log(2, "swmm_step returned: %d, elapsed=%.6f days (%.2f minutes)", ec, elapsed, elapsed * 1440.0);
-            
-            if (ec < 0) { 
-                Log(1, "swmm_step failed with error: %d", ec);
-                HandleSwmmError(outargs, status); 
-                break; 
-            }
-            if (ec > 0) { 
-                Log(2, "Simulation ended normally");
-                Cleanup(status, outargs); 
-                break; 
-            }
-
-            // Get outputs for the timestep we just completed
-            Log(2, "Getting %zu outputs", s_outputs.size());
-            for (const auto& r : s_outputs) {
-                double val;
-                if (r.is_lid) {
-                    // LID output - use appropriate API based on property
-                    if (r.lid_property == "STORAGE_VOLUME") {
-                        val = swmm_getLidUStorageVolume(r.swmm_idx, r.lid_idx);
-                        Log(3, "  Output[%d]: LID storage volume, subcatch_idx=%d, lid_idx=%d, value=%.6f", 
-                            r.iface_idx, r.swmm_idx, r.lid_idx, val);
-                    } else if (r.lid_property == "SURFACE_OUTFLOW") {
-                        val = swmm_getLidUSurfaceOutflow(r.swmm_idx, r.lid_idx);
-                        Log(3, "  Output[%d]: LID surface outflow, subcatch_idx=%d, lid_idx=%d, value=%.6f", 
-                            r.iface_idx, r.swmm_idx, r.lid_idx, val);
-                    } else if (r.lid_property == "SURFACE_INFLOW") {
-                        val = swmm_getLidUSurfaceInflow(r.swmm_idx, r.lid_idx);
-                        Log(3, "  Output[%d]: LID surface inflow, subcatch_idx=%d, lid_idx=%d, value=%.6f", 
-                            r.iface_idx, r.swmm_idx, r.lid_idx, val);
-                    } else if (r.lid_property == "DRAIN_FLOW") {
-                        val = swmm_getLidUDrainFlow(r.swmm_idx, r.lid_idx);
-                        Log(3, "  Output[%d]: LID drain flow, subcatch_idx=%d, lid_idx=%d, value=%.6f", 
-                            r.iface_idx, r.swmm_idx, r.lid_idx, val);
-                    } else {
-                        Log(1, "Unknown LID property: %s", r.lid_property.c_str());
-                        val = 0.0;
-                    }
-                } else {
-                    // Regular output - use existing API
-                    val = swmm_getValue(r.prop_enum, r.swmm_idx);
-                    Log(3, "  Output[%d]: prop=%d, idx=%d, value=%.6f", r.iface_idx, r.prop_enum, r.swmm_idx, val);
+                if (ec > 0) { 
+                    Log(2, "Simulation ended normally");
+                    Cleanup(status, outargs); 
+                    break; 
                 }
-                outargs[r.iface_idx] = val;
             }
+
+            Log(2, "Getting %zu outputs", s_plan.outputs.size());
+            if (!sampled) SampleStepOutputs();
+            PublishOutputs(outargs);
+            if (s_recorder.IsActive()) s_recorder.Record(s_swmm_elapsed - s_elapsed_offset, inargs, outargs);
             
             // Store the NEW inputs for the next timestep
-            for (const auto& r : s_inputs) {
-                s_pending_inputs[r.iface_idx] = inargs[r.iface_idx];
-                Log(2, "  Stored input[%d] for next step: value=%.4f", r.iface_idx, inargs[r.iface_idx]);
-            }
+            StoreInputs(inargs);
+
+            // Pipelined: start the next step now so it overlaps GoldSim's own work
+            if (s_pipelined) s_worker.Submit(LookAheadStep);
+            s_profiler.Stop(PH_CALCULATE, t_calc);
             
             Log(2, "XF_CALCULATE complete");
         }
@@ -494,7 +1609,13 @@ extern "C" void __declspec(dllexport) SwmmGoldSimBridge(int methodID, int* statu
         Log(2, "XF_CLEANUP called");
         Cleanup(status, outargs);
         *status = XF_SUCCESS;
-        Log(2, "XF_CLEANUP complete");
+        if (s_profiler.IsEnabled()) {
+            if (s_profiler.WriteSummary(PROFILE_FILE)) Log(2, "Profile summary written to %s", PROFILE_FILE);
+            else Log(1, "Could not write profile summary %s", PROFILE_FILE);
+        }
+        if (AllocTracker::IsEnabled()) LogAllocations();
+        Log(2, "XF_CLEANUP complete (log records written=%llu, dropped=%llu)",
+            s_logger.GetWrittenCount(), s_logger.GetDroppedCount());
         break;
 
     default:
@@ -504,3 +1625,26 @@ extern "C" void __declspec(dllexport) SwmmGoldSimBridge(int methodID, int* statu
     }
     Log(2, "=== Method %d complete, status=%d ===", methodID, *status);
 }
+
+extern "C" void GSSWMM_EXPORT SwmmGoldSimBridge(int methodID, int* status, double* inargs, double* outargs) {
+    const int alloc_method = AllocTracker::MethodFromID(methodID);
+    AllocTracker::Scope alloc_scope(alloc_method);
+    AllocTracker::CountCall(alloc_method);
+
+    // Timeline tags: the realization counts XF_INITIALIZE calls, the step XF_CALCULATE calls
+    if (methodID == XF_INITIALIZE) s_timeline.BeginRealization();
+    else if (methodID == XF_CALCULATE) s_timeline.NextStep();
+    // Only XF_CALCULATE is hot; the others may attach the timeline while they run
+    uint64_t t_call = methodID == XF_CALCULATE ? s_profiler.Start() : BridgeProfiler::Now();
+    Dispatch(methodID, status, inargs, outargs);
+    s_profiler.Span(MethodName(methodID), t_call);
+    if (s_mapping_loaded) TraceCall(methodID, *status, inargs, outargs);
+
+    // Guaranteed flush: stop the writer and close the log; the next Log() restarts it
+    if (methodID == XF_CLEANUP) {
+        uint64_t t_flush = s_profiler.Start();
+        s_logger.Shutdown();
+        s_profiler.Span("log_flush", t_flush);
+        if (s_profiler.GetTimeline()) WriteTimeline();
+    }
+}
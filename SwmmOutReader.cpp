@@ -0,0 +1,319 @@
+//-----------------------------------------------------------------------------
+//   SwmmOutReader.cpp
+//   Memory-mapped reader for SWMM 5 binary output files (model.out)
+//-----------------------------------------------------------------------------
+
+#include "include/SwmmOutReader.h"
+#include <algorithm>
+#include <cctype>
+#include <thread>
+
+// SWMM 5.1/5.2 output file layout (all integers int32, values float32):
+//
+//   opening records   magic, version, flow units, #subcatch, #nodes, #links, #pollutants
+//   ID names          per subcatch, node, link and pollutant: length, characters
+//                     pollutant unit codes
+//   object properties count, codes and values for subcatchments, nodes, links
+//   reporting vars    count and codes for subcatchments, nodes, links, system
+//                     start date (double), report step (seconds)
+//   results           per period: date (double), subcatch, node, link, system values
+//   closing records   ID, property and results offsets, #periods, error code, magic
+static const int32_t kMagic = 516114522;
+static const size_t kOpeningBytes = 7 * sizeof(int32_t);
+static const size_t kClosingBytes = 6 * sizeof(int32_t);
+
+// Names of the fixed reporting variables, indexed by SWMM's code
+static const char* const kSubcatchVars[] = { "RAINFALL", "SNOW_DEPTH", "EVAP", "INFIL", "RUNOFF",
+                                             "GW_FLOW", "GW_ELEV", "SOIL_MOISTURE" };
+static const char* const kNodeVars[] = { "DEPTH", "HEAD", "VOLUME", "LATERAL_INFLOW", "TOTAL_INFLOW",
+                                         "FLOODING" };
+static const char* const kLinkVars[] = { "FLOW", "DEPTH", "VELOCITY", "VOLUME", "CAPACITY" };
+static const char* const kSystemVars[] = { "AIR_TEMP", "RAINFALL", "SNOW_DEPTH", "INFIL", "RUNOFF",
+                                           "DW_INFLOW", "GW_INFLOW", "RDII_INFLOW", "EXT_INFLOW",
+                                           "TOTAL_INFLOW", "FLOODING", "OUTFLOW", "STORAGE", "EVAP", "PET" };
+static const char* const* const kVarNames[] = { kSubcatchVars, kNodeVars, kLinkVars, kSystemVars };
+static const int kVarNameCount[] = { 8, 6, 5, 15 };
+
+// Bridge property names that differ from the SWMM variable they read
+struct VarAlias { int type; const char* alias; const char* name; };
+static const VarAlias kAliases[] = {
+    { OUT_NODE, "INFLOW", "TOTAL_INFLOW" },
+    { OUT_NODE, "FLOW", "TOTAL_INFLOW" },      // outfall discharge
+    { OUT_NODE, "LATFLOW", "LATERAL_INFLOW" },
+    { OUT_NODE, "OVERFLOW", "FLOODING" },
+    { OUT_SUBCATCH, "RAIN", "RAINFALL" },
+    { OUT_SUBCATCH, "INFILTRATION", "INFIL" },
+};
+
+static std::string Upper(const std::string& s) {
+    std::string u(s);
+    for (char& c : u) c = (char)toupper((unsigned char)c);
+    return u;
+}
+
+// Bounds-checked sequential reads from the mapping
+class OutCursor {
+public:
+    OutCursor(const char* data, size_t size, size_t pos) : data_(data), size_(size), pos_(pos), ok_(pos <= size) {}
+    bool Ok() const { return ok_; }
+    size_t Pos() const { return pos_; }
+    const char* Take(size_t n) {
+        if (!ok_ || size_ - pos_ < n) { ok_ = false; return nullptr; }
+        const char* p = data_ + pos_;
+        pos_ += n;
+        return p;
+    }
+    int32_t Int() {
+        int32_t v = 0;
+        const char* p = Take(sizeof(v));
+        if (p) memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    double Double() {
+        double v = 0.0;
+        const char* p = Take(sizeof(v));
+        if (p) memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    // A count that must fit in what is left of the file at `unit` bytes each
+    int Count(size_t unit) {
+        int32_t n = Int();
+        if (n < 0 || (size_t)n > (size_ - pos_) / unit) ok_ = false;
+        return ok_ ? n : 0;
+    }
+    std::string Str() {
+        int n = Count(1);
+        const char* p = Take((size_t)n);
+        return p ? std::string(p, (size_t)n) : std::string();
+    }
+
+private:
+    const char* data_;
+    size_t size_, pos_;
+    bool ok_;
+};
+
+SwmmOutReader::SwmmOutReader() {
+    Close();
+}
+
+void SwmmOutReader::Close() {
+    file_.Close();
+    version_ = flow_units_ = periods_ = report_step_ = 0;
+    start_date_ = 0.0;
+    for (int t = 0; t < OUT_TYPE_COUNT; t++) {
+        counts_[t] = 0;
+        names_[t].clear();
+        var_codes_[t].clear();
+        type_offset_[t] = 0;
+    }
+    results_offset_ = period_bytes_ = 0;
+}
+
+bool SwmmOutReader::Open(const char* path, std::string& error) {
+    Close();
+    if (!file_.Open(path)) {
+        error = std::string("Cannot open ") + path;
+        return false;
+    }
+    const char* data = file_.GetData();
+    const size_t size = file_.GetSize();
+
+    if (size < kOpeningBytes + kClosingBytes) {
+        error = "Not a SWMM output file";
+    } else {
+        OutCursor head(data, size, 0);
+        OutCursor tail(data, size, size - kClosingBytes);
+        int32_t magic = head.Int();
+        version_ = head.Int();
+        flow_units_ = head.Int();
+        for (int t = 0; t < OUT_SYSTEM; t++) counts_[t] = head.Int();
+        int pollutants = head.Int();
+        counts_[OUT_SYSTEM] = 1;
+
+        int32_t id_pos = tail.Int();
+        int32_t prop_pos = tail.Int();
+        int32_t results_pos = tail.Int();
+        periods_ = tail.Int();
+        int32_t error_code = tail.Int();
+        int32_t end_magic = tail.Int();
+
+        if (magic != kMagic || end_magic != kMagic)
+            error = "Not a SWMM output file (run incomplete or interrupted?)";
+        else if (error_code != 0)
+            error = "SWMM reported error " + std::to_string(error_code) + " for this run";
+        else if (counts_[OUT_SUBCATCH] < 0 || counts_[OUT_NODE] < 0 || counts_[OUT_LINK] < 0 || pollutants < 0 ||
+                 id_pos < 0 || prop_pos < 0 || results_pos < 0 || periods_ < 0)
+            error = "Corrupt SWMM output header";
+
+        // ID names, then object properties (skipped), then reporting variables
+        if (error.empty()) {
+            OutCursor c(data, size, (size_t)id_pos);
+            for (int t = 0; t < OUT_SYSTEM; t++) {
+                for (int i = 0; i < counts_[t] && c.Ok(); i++) names_[t].push_back(c.Str());
+            }
+            for (int p = 0; p < pollutants && c.Ok(); p++) names_[OUT_SYSTEM].push_back(c.Str());
+
+            c = OutCursor(data, size, (size_t)prop_pos);
+            for (int t = 0; t < OUT_SYSTEM; t++) {
+                int n = c.Count(sizeof(int32_t));
+                c.Take((size_t)n * sizeof(int32_t));
+                c.Take((size_t)n * counts_[t] * sizeof(float));
+            }
+            for (int t = 0; t < OUT_TYPE_COUNT; t++) {
+                int n = c.Count(sizeof(int32_t));
+                for (int v = 0; v < n; v++) var_codes_[t].push_back(c.Int());
+            }
+            start_date_ = c.Double();
+            report_step_ = c.Int();
+            if (!c.Ok()) error = "Corrupt SWMM output header";
+        }
+
+        // Results: one fixed-size block per period, ending at the closing records
+        if (error.empty()) {
+            size_t offset = sizeof(double);
+            for (int t = 0; t < OUT_TYPE_COUNT; t++) {
+                type_offset_[t] = offset;
+                offset += (size_t)counts_[t] * var_codes_[t].size() * sizeof(float);
+            }
+            period_bytes_ = offset;
+            results_offset_ = (size_t)results_pos;
+            size_t end = size - kClosingBytes;
+            if (results_offset_ > end || (end - results_offset_) / period_bytes_ < (size_t)periods_)
+                error = "SWMM output file is shorter than its period count";
+        }
+    }
+    if (!error.empty()) {
+        error += std::string(" (") + path + ")";
+        Close();
+        return false;
+    }
+    return true;
+}
+
+double SwmmOutReader::GetPeriodDate(int period) const {
+    double date = 0.0;
+    if (period < 0 || period >= periods_) return date;
+    memcpy(&date, file_.GetData() + results_offset_ + (size_t)period * period_bytes_, sizeof(date));
+    return date;
+}
+
+int SwmmOutReader::GetCount(int type) const {
+    return (type >= 0 && type < OUT_TYPE_COUNT) ? counts_[type] : 0;
+}
+
+const std::string& SwmmOutReader::GetName(int type, int index) const {
+    static const std::string kNone;
+    if (type < 0 || type >= OUT_SYSTEM || index < 0 || index >= counts_[type]) return kNone;
+    return names_[type][index];
+}
+
+int SwmmOutReader::FindElement(int type, const std::string& name) const {
+    if (type == OUT_SYSTEM) return 0;
+    if (type < 0 || type >= OUT_TYPE_COUNT) return -1;
+    auto it = std::find(names_[type].begin(), names_[type].end(), name);
+    return it == names_[type].end() ? -1 : (int)(it - names_[type].begin());
+}
+
+int SwmmOutReader::GetVariableCount(int type) const {
+    return (type >= 0 && type < OUT_TYPE_COUNT) ? (int)var_codes_[type].size() : 0;
+}
+
+// Codes past the fixed variables are pollutant concentrations, in pollutant order
+std::string SwmmOutReader::GetVariableName(int type, int variable) const {
+    if (variable < 0 || variable >= GetVariableCount(type)) return std::string();
+    int code = var_codes_[type][variable];
+    if (code >= 0 && code < kVarNameCount[type]) return kVarNames[type][code];
+    int p = code - kVarNameCount[type];
+    if (type != OUT_SYSTEM && p >= 0 && p < (int)names_[OUT_SYSTEM].size()) return names_[OUT_SYSTEM][p];
+    return "VAR" + std::to_string(code);
+}
+
+int SwmmOutReader::FindVariable(int type, const std::string& name) const {
+    std::string key = Upper(name);
+    for (const VarAlias& a : kAliases) {
+        if (a.type == type && key == a.alias) key = a.name;
+    }
+    for (int v = 0; v < GetVariableCount(type); v++) {
+        if (Upper(GetVariableName(type, v)) == key) return v;
+    }
+    return -1;
+}
+
+int SwmmOutReader::TypeFromName(const std::string& name) {
+    std::string key = Upper(name);
+    if (key == "SUBCATCH" || key == "SUBCATCHMENT") return OUT_SUBCATCH;
+    if (key == "NODE" || key == "JUNCTION" || key == "OUTFALL" || key == "STORAGE" || key == "DIVIDER")
+        return OUT_NODE;
+    if (key == "LINK" || key == "CONDUIT" || key == "PUMP" || key == "ORIFICE" || key == "WEIR" || key == "OUTLET")
+        return OUT_LINK;
+    if (key == "SYSTEM") return OUT_SYSTEM;
+    return -1;
+}
+
+const char* SwmmOutReader::TypeName(int type) {
+    static const char* const kNames[] = { "SUBCATCH", "NODE", "LINK", "SYSTEM" };
+    return (type >= 0 && type < OUT_TYPE_COUNT) ? kNames[type] : "";
+}
+
+size_t SwmmOutReader::ValueOffset(int type, int index, int variable) const {
+    return type_offset_[type] + ((size_t)index * var_codes_[type].size() + (size_t)variable) * sizeof(float);
+}
+
+bool SwmmOutReader::GetSeries(int type, int index, int variable, Series& series) const {
+    if (index < 0 || index >= GetCount(type) || variable < 0 || variable >= GetVariableCount(type)) return false;
+    series.first = file_.GetData() + results_offset_ + ValueOffset(type, index, variable);
+    series.stride = period_bytes_;
+    series.count = periods_;
+    return true;
+}
+
+SwmmOutReader::Stats SwmmOutReader::Summarize(const Series& series, double step_seconds) {
+    Stats s = { series.count, 0.0, 0.0, 0.0, 0.0, -1 };
+    double sum = 0.0;
+    for (int p = 0; p < series.count; p++) {
+        double v = series[p];
+        if (p == 0 || v < s.min) s.min = v;
+        if (p == 0 || v > s.max) {
+            s.max = v;
+            s.argmax = p;
+        }
+        sum += v;
+    }
+    if (series.count > 0) s.mean = sum / series.count;
+    s.integral = sum * step_seconds;
+    return s;
+}
+
+bool SwmmOutReader::Extract(const std::vector<Request>& requests, std::vector<std::vector<float>>& values,
+                            int threads) const {
+    std::vector<size_t> offsets;
+    for (const Request& r : requests) {
+        if (r.index < 0 || r.index >= GetCount(r.type) || r.variable < 0 || r.variable >= GetVariableCount(r.type))
+            return false;
+        offsets.push_back(ValueOffset(r.type, r.index, r.variable));
+    }
+    values.assign(requests.size(), std::vector<float>((size_t)periods_));
+
+    // Each worker copies a contiguous range of periods for every series, so
+    // it streams through its part of the file once
+    auto copy = [&](int first, int last) {
+        const char* block = file_.GetData() + results_offset_ + (size_t)first * period_bytes_;
+        for (int p = first; p < last; p++, block += period_bytes_) {
+            for (size_t i = 0; i < offsets.size(); i++) memcpy(&values[i][p], block + offsets[i], sizeof(float));
+        }
+    };
+    threads = std::max(1, std::min(threads, periods_));
+    if (threads <= 1 || requests.empty()) {
+        copy(0, periods_);
+        return true;
+    }
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        int first = (int)((int64_t)periods_ * t / threads);
+        int last = (int)((int64_t)periods_ * (t + 1) / threads);
+        workers.emplace_back(copy, first, last);
+    }
+    for (std::thread& w : workers) w.join();
+    return true;
+}
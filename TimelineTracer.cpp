@@ -0,0 +1,129 @@
+//-----------------------------------------------------------------------------
+//   TimelineTracer.cpp
+//   Chrome/Perfetto trace-event timeline of bridge and SWMM phases
+//-----------------------------------------------------------------------------
+
+#include "include/Platform.h"
+#include "include/TimelineTracer.h"
+#include "include/BridgeProfiler.h"
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+static std::atomic<uint64_t> s_next_tracer(1);
+static std::atomic<int> s_next_tid(1);
+
+// The calling thread's buffer, valid while tracer and generation match
+struct ThreadCache {
+    uint64_t tracer;
+    uint32_t generation;
+    void* buffer;
+    int tid;              // stable for the life of the thread, 0 until first use
+};
+static thread_local ThreadCache t_cache = { 0, 0, NULL, 0 };
+
+static int ProcessId() {
+#ifdef _WIN32
+    return (int)GetCurrentProcessId();
+#else
+    return (int)getpid();
+#endif
+}
+
+TimelineTracer::TimelineTracer(int max_events)
+    : id_(s_next_tracer.fetch_add(1)), epoch_ns_(BridgeProfiler::Now()), max_events_(max_events), generation_(0),
+      realization_(-1), step_(-1), written_(0), dropped_(0) {}
+
+TimelineTracer::~TimelineTracer() {}
+
+void TimelineTracer::BeginRealization() {
+    realization_.fetch_add(1, std::memory_order_relaxed);
+    step_.store(-1, std::memory_order_relaxed);
+}
+
+TimelineTracer::ThreadBuffer* TimelineTracer::AcquireBuffer(int tid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ThreadBuffer* b = NULL;
+    for (auto& candidate : buffers_) {
+        if (!candidate->in_use) { b = candidate.get(); break; }
+    }
+    if (!b) {
+        buffers_.emplace_back(new ThreadBuffer());
+        b = buffers_.back().get();
+    }
+    b->tid = tid;
+    b->in_use = true;
+    b->count = 0;
+    b->dropped = 0;
+    return b;
+}
+
+void TimelineTracer::Span(const char* name, uint64_t start_ns, uint64_t end_ns) {
+    ThreadCache& c = t_cache;
+    uint32_t generation = generation_.load(std::memory_order_acquire);
+    if (c.tracer != id_ || c.generation != generation) {
+        if (c.tid == 0) c.tid = s_next_tid.fetch_add(1);
+        c.buffer = AcquireBuffer(c.tid);
+        c.tracer = id_;
+        c.generation = generation;
+    }
+    ThreadBuffer* b = (ThreadBuffer*)c.buffer;
+    if (b->count >= max_events_) {
+        b->dropped++;
+        return;
+    }
+    size_t chunk = (size_t)(b->count / kChunkEvents);
+    if (chunk == b->chunks.size()) b->chunks.emplace_back(new Event[kChunkEvents]);
+    Event& e = b->chunks[chunk][b->count % kChunkEvents];
+    e.name = name;
+    e.start = start_ns;
+    e.end = end_ns;
+    e.realization = realization_.load(std::memory_order_relaxed);
+    e.step = step_.load(std::memory_order_relaxed);
+    b->count++;
+}
+
+bool TimelineTracer::Write(const char* path, std::string& error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool create = (path_ != path);
+    FILE* f = NULL;
+    if (fopen_s(&f, path, create ? "wb" : "ab") != 0 || !f) {
+        error = std::string("Cannot open ") + path;
+        return false;   // the spans stay buffered for the next attempt
+    }
+    const int pid = ProcessId();
+    if (create) {
+        fprintf(f, "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,"
+                   "\"args\":{\"name\":\"GSswmm bridge\"}},\n", pid);
+        path_ = path;
+    }
+
+    // Times in microseconds since the tracer was created
+    written_ = dropped_ = 0;
+    for (auto& b : buffers_) {
+        if (!b->in_use) continue;
+        fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}},\n",
+                pid, b->tid, b->tid == t_cache.tid ? "GoldSim calls" : "worker");
+        for (int i = 0; i < b->count; i++) {
+            const Event& e = b->chunks[(size_t)(i / kChunkEvents)][i % kChunkEvents];
+            fprintf(f, "{\"name\":\"%s\",\"cat\":\"bridge\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d",
+                    e.name, (double)(int64_t)(e.start - epoch_ns_) / 1e3, (double)(e.end - e.start) / 1e3, pid, b->tid);
+            if (e.realization < 0) fprintf(f, ",\"args\":{}},\n");
+            else if (e.step < 0) fprintf(f, ",\"args\":{\"realization\":%d}},\n", e.realization);
+            else fprintf(f, ",\"args\":{\"realization\":%d,\"step\":%lld}},\n", e.realization, (long long)e.step);
+        }
+        if (b->dropped > 0) {
+            fprintf(f, "{\"name\":\"spans dropped\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d,"
+                       "\"args\":{\"count\":%lld}},\n",
+                    (double)(BridgeProfiler::Now() - epoch_ns_) / 1e3, pid, b->tid, (long long)b->dropped);
+        }
+        written_ += b->count;
+        dropped_ += b->dropped;
+        b->in_use = false;
+    }
+    generation_.fetch_add(1, std::memory_order_release);   // every thread acquires a buffer again
+    bool ok = !ferror(f);
+    if (fclose(f) != 0) ok = false;
+    if (!ok) error = std::string("Write to ") + path + " failed";
+    return ok;
+}
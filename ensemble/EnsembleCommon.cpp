@@ -0,0 +1,103 @@
+//-----------------------------------------------------------------------------
+//   EnsembleCommon.cpp
+//   Realization files and bridge driving shared by the ensemble runners
+//-----------------------------------------------------------------------------
+
+#include "../include/Platform.h"
+#include "EnsembleCommon.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+std::string BaseName(const std::string& path) {
+    size_t slash = path.find_last_of("\\/");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+bool ReadInputRows(const std::string& path, int ninputs, std::vector<std::vector<double>>& rows, std::string& error) {
+    std::ifstream file(path);
+    if (!file.is_open()) { error = "Cannot open " + path; return false; }
+    std::string line;
+    int lineno = 0;
+    while (std::getline(file, line)) {
+        lineno++;
+        if (line.empty() || line == "\r") continue;
+        std::vector<double> row;
+        std::stringstream ss(line);
+        std::string cell;
+        bool numeric = true;
+        while (std::getline(ss, cell, ',')) {
+            char* end = NULL;
+            double v = strtod(cell.c_str(), &end);
+            if (end == cell.c_str()) { numeric = false; break; }
+            row.push_back(v);
+        }
+        if (!numeric) {
+            if (lineno == 1) continue;  // header
+            error = "Non-numeric value on line " + std::to_string(lineno);
+            return false;
+        }
+        if ((int)row.size() != ninputs) {
+            error = "Line " + std::to_string(lineno) + " has " + std::to_string(row.size()) +
+                    " values, bridge expects " + std::to_string(ninputs);
+            return false;
+        }
+        rows.push_back(row);
+    }
+    return true;
+}
+
+const char* BridgeMessage(int status, double* outargs) {
+    if (status == XF_FAILURE_WITH_MSG) return *(const char**)outargs;
+    return "bridge call failed";
+}
+
+bool RunRealizationFile(BridgeFunction bridge, const MappingLoader& mapping, const std::string& input,
+                        const std::string& output, RealizationStats& stats, std::string& error) {
+    int ninputs = mapping.GetInputCount(), noutputs = mapping.GetOutputCount();
+    std::vector<std::vector<double>> rows;
+    if (!ReadInputRows(input, ninputs, rows, error)) return false;
+
+    FILE* out = NULL;
+    if (fopen_s(&out, output.c_str(), "w") != 0 || !out) { error = "Cannot write " + output; return false; }
+    fprintf(out, "step");
+    for (const auto& o : mapping.GetOutputs()) fprintf(out, ",%s/%s", o.name.c_str(), o.property.c_str());
+    fprintf(out, "\n");
+
+    int status;
+    std::vector<double> inargs(std::max(ninputs, 1), 0.0), outargs(std::max(noutputs, 2), 0.0);
+    auto t0 = std::chrono::steady_clock::now();
+    bridge(XF_INITIALIZE, &status, inargs.data(), outargs.data());
+    stats.startup_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    if (status != XF_SUCCESS) {
+        error = std::string("XF_INITIALIZE: ") + BridgeMessage(status, outargs.data());
+        fclose(out);
+        return false;
+    }
+
+    bool ok = true;
+    for (size_t k = 0; k < rows.size(); k++) {
+        std::copy(rows[k].begin(), rows[k].end(), inargs.begin());
+        bridge(XF_CALCULATE, &status, inargs.data(), outargs.data());
+        if (status != XF_SUCCESS) {
+            error = "XF_CALCULATE step " + std::to_string(k) + ": " + BridgeMessage(status, outargs.data());
+            ok = false;
+            break;
+        }
+        stats.steps++;
+        fprintf(out, "%zu", k);
+        for (int i = 0; i < noutputs; i++) fprintf(out, ",%.10g", outargs[i]);
+        fprintf(out, "\n");
+    }
+    bridge(XF_CLEANUP, &status, inargs.data(), outargs.data());
+    if (fclose(out) != 0 && ok) {
+        error = "Cannot write " + output;
+        ok = false;
+    }
+    return ok;
+}
@@ -0,0 +1,57 @@
+//-----------------------------------------------------------------------------
+//   EnsembleCommon.h
+//   Realization files and bridge driving shared by the ensemble runners
+//-----------------------------------------------------------------------------
+//
+//   GSswmmEnsemble (worker processes) and GSswmmZygote (forked children)
+//   read the same realization files and write the same results, so both
+//   drive the bridge through RunRealizationFile().
+//-----------------------------------------------------------------------------
+
+#ifndef ENSEMBLE_COMMON_H
+#define ENSEMBLE_COMMON_H
+
+#include "../include/MappingLoader.h"
+#include <string>
+#include <vector>
+
+#define XF_INITIALIZE   0
+#define XF_CALCULATE    1
+#define XF_REP_ARGUMENTS 3
+#define XF_CLEANUP      99
+#define XF_SUCCESS      0
+#define XF_FAILURE_WITH_MSG -1
+
+#define CONFIG_FILE "SwmmGoldSimBridge.json"
+
+typedef void (*BridgeFunction)(int, int*, double*, double*);
+
+// One realization's counters; plain data, so it can live in shared memory
+struct RealizationStats {
+    double startup_us;           // XF_INITIALIZE
+    long long steps;             // successful XF_CALCULATE calls
+};
+
+// File name without directory and extension ("in/r01.csv" -> "r01")
+std::string BaseName(const std::string& path);
+
+/**
+ * @brief Read a realization file: an optional header line, then one row of
+ *        ninputs comma-separated values per step
+ * @return false with a message naming the line if a row is malformed
+ */
+bool ReadInputRows(const std::string& path, int ninputs, std::vector<std::vector<double>>& rows, std::string& error);
+
+// The bridge's error string for XF_FAILURE_WITH_MSG, a generic text otherwise
+const char* BridgeMessage(int status, double* outargs);
+
+/**
+ * @brief Run one realization: XF_INITIALIZE, one XF_CALCULATE per input row
+ *        and XF_CLEANUP, writing the outputs of each step to `output` as CSV
+ * @return false with a message naming the failed call or file
+ * @note stats.steps counts the steps written even when a later call fails
+ */
+bool RunRealizationFile(BridgeFunction bridge, const MappingLoader& mapping, const std::string& input,
+                        const std::string& output, RealizationStats& stats, std::string& error);
+
+#endif
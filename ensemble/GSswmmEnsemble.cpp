@@ -0,0 +1,267 @@
+//-----------------------------------------------------------------------------
+//   GSswmmEnsemble.cpp
+//   Headless multi-process Monte Carlo driver for the GoldSim-SWMM bridge
+//-----------------------------------------------------------------------------
+//
+//   Runs many realizations through GSswmm.dll without GoldSim. The bridge
+//   keeps its state in statics, so each worker is a separate process with its
+//   own copy of the bridge, its own SWMM instance and its own working
+//   directory (model.inp, SwmmGoldSimBridge.json, model.rpt/.out, log).
+//
+//   Usage:
+//     GSswmmEnsemble.exe --model-dir <dir> --inputs <dir> --output <dir>
+//                        [--workers N] [--dll <path to GSswmm.dll>]
+//
+//   Each *.csv file in --inputs is one realization: an optional header line,
+//   then one row per GoldSim time step with one column per bridge input in
+//   interface order (including ElapsedTime). Results are written to
+//   <output>/<name>.out.csv, one row per step with the bridge outputs.
+//
+//   Workers pull the next realization from a shared counter in named shared
+//   memory, so a worker that finishes early immediately takes more work and
+//   all cores stay busy until the queue is empty.
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "../include/MappingLoader.h"
+#include "EnsembleCommon.h"
+
+#define MAX_ARGS 4096
+
+// Shared between the coordinator and all workers (named file mapping)
+struct SharedQueue {
+    volatile LONG next;          // next realization to hand out
+    LONG count;                  // number of realizations
+    volatile LONG completed;
+    volatile LONG failed;
+    volatile LONG64 steps;       // XF_CALCULATE calls across all workers
+};
+
+struct Options {
+    std::string model_dir, inputs_dir, output_dir, dll;
+    std::string shm_name, queue_file;
+    int workers;
+    int worker_id;               // -1 for the coordinator
+    Options() : workers(0), worker_id(-1) {}
+};
+
+static std::string FullPath(const std::string& path) {
+    char buf[MAX_PATH];
+    DWORD n = GetFullPathNameA(path.c_str(), MAX_PATH, buf, NULL);
+    return (n > 0 && n < MAX_PATH) ? std::string(buf) : path;
+}
+
+static std::string ExeDir() {
+    char buf[MAX_PATH];
+    DWORD n = GetModuleFileNameA(NULL, buf, MAX_PATH);
+    std::string p(buf, n);
+    size_t slash = p.find_last_of("\\/");
+    return slash == std::string::npos ? "." : p.substr(0, slash);
+}
+
+static std::vector<std::string> ListFiles(const std::string& dir, const char* pattern) {
+    std::vector<std::string> files;
+    WIN32_FIND_DATAA fd;
+    HANDLE h = FindFirstFileA((dir + "\\" + pattern).c_str(), &fd);
+    if (h == INVALID_HANDLE_VALUE) return files;
+    do {
+        if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) files.push_back(fd.cFileName);
+    } while (FindNextFileA(h, &fd));
+    FindClose(h);
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+//=============================================================================
+// Worker
+//=============================================================================
+
+static int RunWorker(const Options& opt) {
+    HANDLE map = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, opt.shm_name.c_str());
+    if (!map) { fprintf(stderr, "worker %d: cannot open shared queue\n", opt.worker_id); return 1; }
+    SharedQueue* q = (SharedQueue*)MapViewOfFile(map, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SharedQueue));
+    if (!q) { CloseHandle(map); return 1; }
+
+    std::vector<std::string> inputs;
+    std::ifstream qf(opt.queue_file);
+    std::string line;
+    while (std::getline(qf, line)) if (!line.empty()) inputs.push_back(line);
+
+    HMODULE dll = LoadLibraryA(opt.dll.c_str());
+    BridgeFunction bridge = dll ? (BridgeFunction)GetProcAddress(dll, "SwmmGoldSimBridge") : NULL;
+    MappingLoader mapping;
+    std::string error;
+    if (!bridge || !mapping.LoadFromFile(CONFIG_FILE, error)) {
+        fprintf(stderr, "worker %d: %s\n", opt.worker_id, bridge ? error.c_str() : "cannot load bridge DLL");
+        UnmapViewOfFile(q); CloseHandle(map);
+        return 1;
+    }
+    int status;
+    double args[2] = { 0.0, 0.0 };
+    bridge(XF_REP_ARGUMENTS, &status, args, args);  // loads the mapping inside the bridge
+
+    for (;;) {
+        LONG idx = InterlockedIncrement(&q->next) - 1;
+        if (idx >= q->count || idx >= (LONG)inputs.size()) break;
+        const std::string& input = inputs[idx];
+        std::string output = opt.output_dir + "\\" + BaseName(input) + ".out.csv";
+        RealizationStats stats = { 0.0, 0 };
+        error.clear();
+        if (RunRealizationFile(bridge, mapping, input, output, stats, error)) {
+            InterlockedIncrement(&q->completed);
+        } else {
+            InterlockedIncrement(&q->failed);
+            fprintf(stderr, "worker %d: %s: %s\n", opt.worker_id, BaseName(input).c_str(), error.c_str());
+        }
+        InterlockedExchangeAdd64(&q->steps, stats.steps);
+    }
+
+    FreeLibrary(dll);
+    UnmapViewOfFile(q);
+    CloseHandle(map);
+    return 0;
+}
+
+//=============================================================================
+// Coordinator
+//=============================================================================
+
+static bool PrepareWorkDir(const std::string& model_dir, const std::string& work_dir, std::string& error) {
+    CreateDirectoryA(work_dir.c_str(), NULL);
+    std::vector<std::string> files = ListFiles(model_dir, "*");
+    for (const auto& f : files) {
+        std::string src = model_dir + "\\" + f, dst = work_dir + "\\" + f;
+        if (!CopyFileA(src.c_str(), dst.c_str(), FALSE)) { error = "Cannot copy " + src; return false; }
+    }
+    DWORD a = GetFileAttributesA((work_dir + "\\model.inp").c_str());
+    DWORD b = GetFileAttributesA((work_dir + "\\" CONFIG_FILE).c_str());
+    if (a == INVALID_FILE_ATTRIBUTES || b == INVALID_FILE_ATTRIBUTES) {
+        error = "Model directory must contain model.inp and " CONFIG_FILE;
+        return false;
+    }
+    return true;
+}
+
+static int RunCoordinator(Options& opt) {
+    opt.model_dir = FullPath(opt.model_dir);
+    opt.inputs_dir = FullPath(opt.inputs_dir);
+    opt.output_dir = FullPath(opt.output_dir);
+    opt.dll = FullPath(opt.dll.empty() ? ExeDir() + "\\GSswmm.dll" : opt.dll);
+    if (opt.workers <= 0) {
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        opt.workers = (int)si.dwNumberOfProcessors;
+    }
+
+    std::vector<std::string> inputs = ListFiles(opt.inputs_dir, "*.csv");
+    if (inputs.empty()) { fprintf(stderr, "No *.csv realization files in %s\n", opt.inputs_dir.c_str()); return 1; }
+    opt.workers = std::min(opt.workers, (int)inputs.size());
+    CreateDirectoryA(opt.output_dir.c_str(), NULL);
+
+    std::string work_root = opt.output_dir + "\\work";
+    CreateDirectoryA(work_root.c_str(), NULL);
+    std::string queue_file = work_root + "\\queue.txt";
+    FILE* qf = NULL;
+    if (fopen_s(&qf, queue_file.c_str(), "w") != 0 || !qf) { fprintf(stderr, "Cannot write %s\n", queue_file.c_str()); return 1; }
+    for (const auto& f : inputs) fprintf(qf, "%s\\%s\n", opt.inputs_dir.c_str(), f.c_str());
+    fclose(qf);
+
+    char shm_name[64];
+    sprintf_s(shm_name, "Local\\GSswmmEnsemble_%lu", GetCurrentProcessId());
+    HANDLE map = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, sizeof(SharedQueue), shm_name);
+    if (!map) { fprintf(stderr, "Cannot create shared queue\n"); return 1; }
+    SharedQueue* q = (SharedQueue*)MapViewOfFile(map, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SharedQueue));
+    if (!q) { CloseHandle(map); return 1; }
+    memset((void*)q, 0, sizeof(SharedQueue));
+    q->count = (LONG)inputs.size();
+
+    printf("GSswmm ensemble: %zu realizations, %d workers\n", inputs.size(), opt.workers);
+    char exe[MAX_PATH];
+    GetModuleFileNameA(NULL, exe, MAX_PATH);
+
+    LARGE_INTEGER freq, t0, t1;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t0);
+
+    std::vector<PROCESS_INFORMATION> procs;
+    for (int k = 0; k < opt.workers; k++) {
+        std::string work_dir = work_root + "\\worker_" + std::to_string(k);
+        std::string error;
+        if (!PrepareWorkDir(opt.model_dir, work_dir, error)) { fprintf(stderr, "%s\n", error.c_str()); break; }
+        std::string cmd = "\"" + std::string(exe) + "\" --worker " + std::to_string(k) + " --shm " + shm_name +
+                          " --queue \"" + queue_file + "\" --dll \"" + opt.dll + "\" --output \"" + opt.output_dir + "\"";
+        std::vector<char> cmdline(cmd.begin(), cmd.end());
+        cmdline.push_back('\0');
+        STARTUPINFOA si;
+        ZeroMemory(&si, sizeof(si));
+        si.cb = sizeof(si);
+        PROCESS_INFORMATION pi;
+        if (!CreateProcessA(NULL, cmdline.data(), NULL, NULL, FALSE, 0, NULL, work_dir.c_str(), &si, &pi)) {
+            fprintf(stderr, "Cannot start worker %d (error %lu)\n", k, GetLastError());
+            break;
+        }
+        procs.push_back(pi);
+    }
+
+    int exit_code = procs.empty() ? 1 : 0;
+    for (auto& pi : procs) {
+        WaitForSingleObject(pi.hProcess, INFINITE);
+        DWORD code = 0;
+        GetExitCodeProcess(pi.hProcess, &code);
+        if (code != 0) exit_code = 1;
+        CloseHandle(pi.hProcess);
+        CloseHandle(pi.hThread);
+    }
+    QueryPerformanceCounter(&t1);
+    double seconds = (double)(t1.QuadPart - t0.QuadPart) / (double)freq.QuadPart;
+
+    LONG done = q->completed, failed = q->failed;
+    long long steps = q->steps;
+    printf("Completed: %ld, failed: %ld, steps: %lld\n", done, failed, steps);
+    printf("Wall time: %.2f s\n", seconds);
+    if (seconds > 0.0) {
+        printf("Throughput: %.1f realizations/hour, %.0f steps/s\n", done * 3600.0 / seconds, steps / seconds);
+    }
+    if (failed > 0 || done < q->count) exit_code = 1;
+
+    UnmapViewOfFile(q);
+    CloseHandle(map);
+    return exit_code;
+}
+
+//=============================================================================
+// Main
+//=============================================================================
+
+static void Usage() {
+    printf("Usage: GSswmmEnsemble.exe --model-dir <dir> --inputs <dir> --output <dir>\n");
+    printf("                          [--workers N] [--dll <GSswmm.dll>]\n");
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        if (a == "--model-dir" && has_value) opt.model_dir = argv[++i];
+        else if (a == "--inputs" && has_value) opt.inputs_dir = argv[++i];
+        else if (a == "--output" && has_value) opt.output_dir = argv[++i];
+        else if (a == "--workers" && has_value) opt.workers = atoi(argv[++i]);
+        else if (a == "--dll" && has_value) opt.dll = argv[++i];
+        else if (a == "--worker" && has_value) opt.worker_id = atoi(argv[++i]);
+        else if (a == "--shm" && has_value) opt.shm_name = argv[++i];
+        else if (a == "--queue" && has_value) opt.queue_file = argv[++i];
+        else { Usage(); return 1; }
+    }
+
+    if (opt.worker_id >= 0) return RunWorker(opt);
+    if (opt.model_dir.empty() || opt.inputs_dir.empty() || opt.output_dir.empty()) { Usage(); return 1; }
+    return RunCoordinator(opt);
+}
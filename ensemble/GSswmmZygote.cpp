@@ -0,0 +1,184 @@
+//-----------------------------------------------------------------------------
+//   GSswmmZygote.cpp
+//   Fork-server ensemble runner for the GoldSim-SWMM bridge (Linux)
+//-----------------------------------------------------------------------------
+//
+//   Runs many short realizations through libgsswmm.so without GoldSim. The
+//   parent process loads the mapping, opens and parses model.inp and
+//   resolves every name once, in a priming realization with no steps. It
+//   then forks one copy-on-write child per realization. With
+//   "recycle_project": true the child's XF_INITIALIZE only calls swmm_start
+//   on the project it inherited, so it starts in microseconds and shares the
+//   parsed model's memory with the parent and its siblings.
+//
+//   Usage:
+//     GSswmmZygote --model-dir <dir> --inputs <dir> --output <dir> [--workers N]
+//
+//   The model directory needs model.inp and SwmmGoldSimBridge.json with
+//   "recycle_project": true and "output_policy": "NONE" (children must not
+//   share SWMM's report and output files). Input and result files are the
+//   same as for GSswmmEnsemble.exe: each *.csv in --inputs is one
+//   realization, with an optional header and one row per step holding the
+//   bridge inputs in index order; results go to <output>/<name>.out.csv.
+//-----------------------------------------------------------------------------
+
+#include "../include/ForkServer.h"
+#include "../include/MappingLoader.h"
+#include "EnsembleCommon.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+extern "C" void SwmmGoldSimBridge(int methodID, int* status, double* inargs, double* outargs);
+
+struct Options {
+    std::string model_dir, inputs_dir, output_dir;
+    int workers;
+    Options() : workers(0) {}
+};
+
+struct Context {
+    std::vector<std::string> inputs;   // full paths
+    std::string output_dir;
+    const MappingLoader* mapping;
+    RealizationStats* results;         // one per realization, ForkServer::SharedAlloc
+};
+
+static std::string FullPath(const std::string& path) {
+    char buf[PATH_MAX];
+    return realpath(path.c_str(), buf) ? std::string(buf) : path;
+}
+
+static std::vector<std::string> ListCsvFiles(const std::string& dir) {
+    std::vector<std::string> files;
+    DIR* d = opendir(dir.c_str());
+    if (!d) return files;
+    while (dirent* e = readdir(d)) {
+        std::string name = e->d_name;
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".csv") == 0) files.push_back(dir + "/" + name);
+    }
+    closedir(d);
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+static double Us(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+    return std::chrono::duration<double, std::micro>(b - a).count();
+}
+
+//=============================================================================
+// Child: one realization on the inherited project
+//=============================================================================
+
+static int RunRealization(int task, void* context) {
+    Context& ctx = *(Context*)context;
+    const std::string& input = ctx.inputs[task];
+    std::string output = ctx.output_dir + "/" + BaseName(input) + ".out.csv";
+    std::string error;
+    if (!RunRealizationFile(SwmmGoldSimBridge, *ctx.mapping, input, output, ctx.results[task], error)) {
+        fprintf(stderr, "%s: %s\n", BaseName(input).c_str(), error.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+//=============================================================================
+// Parent: prime the bridge once, then fork the realizations
+//=============================================================================
+
+static int Run(Options& opt) {
+    opt.inputs_dir = FullPath(opt.inputs_dir);
+    mkdir(opt.output_dir.c_str(), 0777);
+    opt.output_dir = FullPath(opt.output_dir);
+    if (opt.workers <= 0) opt.workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    Context ctx;
+    ctx.inputs = ListCsvFiles(opt.inputs_dir);
+    ctx.output_dir = opt.output_dir;
+    if (ctx.inputs.empty()) { fprintf(stderr, "No *.csv realization files in %s\n", opt.inputs_dir.c_str()); return 1; }
+
+    // The bridge uses paths relative to the model directory
+    if (chdir(opt.model_dir.c_str()) != 0) { fprintf(stderr, "Cannot enter %s\n", opt.model_dir.c_str()); return 1; }
+    MappingLoader mapping;
+    std::string error;
+    if (!mapping.LoadFromFile(CONFIG_FILE, error)) { fprintf(stderr, "%s\n", error.c_str()); return 1; }
+    if (!mapping.GetRecycleProject() || mapping.GetOutputPolicy() != "NONE" || mapping.GetLoggingLevel() != "OFF" ||
+        mapping.GetProfiling() || !mapping.GetSeriesFile().empty() || !mapping.GetCallTrace().empty() ||
+        !mapping.GetTimelineFile().empty()) {
+        fprintf(stderr, CONFIG_FILE " must set \"recycle_project\": true, \"output_policy\": \"NONE\" and "
+                        "\"logging_level\": \"OFF\", and no \"profiling\", \"series_file\", \"call_trace\" or "
+                        "\"timeline_file\": forked realizations share the parent's project and working directory, "
+                        "so they would all write the same bridge_debug.log, bridge_profile.json and output files\n");
+        return 1;
+    }
+    ctx.mapping = &mapping;
+
+    // Priming realization: mapping, swmm_open, name resolution (and any hot-start
+    // spin-up); XF_CLEANUP ends it but leaves the project open. fork() copies only
+    // the calling thread, so this relies on XF_CLEANUP having stopped the bridge's
+    // background threads: the look-ahead step worker (joined in Cleanup) and the
+    // logger's writer (shut down after every XF_CLEANUP). The series writer never
+    // starts, since "series_file" is refused above.
+    int status;
+    std::vector<double> inargs(std::max(mapping.GetInputCount(), 2), 0.0), outargs(std::max(mapping.GetOutputCount(), 2), 0.0);
+    auto t0 = std::chrono::steady_clock::now();
+    SwmmGoldSimBridge(XF_REP_ARGUMENTS, &status, inargs.data(), outargs.data());
+    if (status == XF_SUCCESS) SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs.data(), outargs.data());
+    if (status != XF_SUCCESS) {
+        fprintf(stderr, "Priming failed: %s\n", BridgeMessage(status, outargs.data()));
+        return 1;
+    }
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs.data(), outargs.data());
+    double prime_ms = Us(t0, std::chrono::steady_clock::now()) / 1000.0;
+
+    size_t shared_bytes = ctx.inputs.size() * sizeof(RealizationStats);
+    ctx.results = (RealizationStats*)ForkServer::SharedAlloc(shared_bytes);
+    if (!ctx.results) { fprintf(stderr, "Cannot allocate shared results\n"); return 1; }
+
+    int count = (int)ctx.inputs.size();
+    printf("GSswmm zygote: %d realizations, %d workers, primed in %.1f ms\n", count, opt.workers, prime_ms);
+    ForkServer server;
+    int failed = server.Run(count, opt.workers, RunRealization, &ctx);
+
+    long long steps = 0;
+    double startup_sum = 0.0, startup_max = 0.0;
+    for (int i = 0; i < count; i++) {
+        steps += ctx.results[i].steps;
+        startup_sum += ctx.results[i].startup_us;
+        startup_max = std::max(startup_max, ctx.results[i].startup_us);
+    }
+    double seconds = server.GetWallSeconds();
+    printf("Completed: %d, failed: %d, steps: %lld\n", count - failed, failed, steps);
+    printf("Child XF_INITIALIZE: %.1f us mean, %.1f us max\n", startup_sum / count, startup_max);
+    printf("Wall time: %.2f s\n", seconds);
+    if (seconds > 0.0)
+        printf("Throughput: %.1f realizations/hour, %.0f steps/s\n", (count - failed) * 3600.0 / seconds, steps / seconds);
+    ForkServer::SharedFree(ctx.results, shared_bytes);
+    return failed > 0 ? 1 : 0;
+}
+
+static void Usage() {
+    printf("Usage: GSswmmZygote --model-dir <dir> --inputs <dir> --output <dir> [--workers N]\n");
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        if (a == "--model-dir" && has_value) opt.model_dir = argv[++i];
+        else if (a == "--inputs" && has_value) opt.inputs_dir = argv[++i];
+        else if (a == "--output" && has_value) opt.output_dir = argv[++i];
+        else if (a == "--workers" && has_value) opt.workers = atoi(argv[++i]);
+        else { Usage(); return 1; }
+    }
+    if (opt.model_dir.empty() || opt.inputs_dir.empty() || opt.output_dir.empty()) { Usage(); return 1; }
+    return Run(opt);
+}
@@ -0,0 +1,21 @@
+@echo off
+echo Building GSswmm ensemble runner...
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+REM The runner loads GSswmm.dll at run time; it only links the mapping loader
+cl /EHsc /W3 /O2 /MD /I.. /Fe:GSswmmEnsemble.exe GSswmmEnsemble.cpp EnsembleCommon.cpp ..\MappingLoader.cpp
+if errorlevel 1 (
+    echo ERROR: Compilation failed
+    exit /b 1
+)
+
+echo.
+echo Built GSswmmEnsemble.exe
+echo Copy GSswmm.dll and swmm5.dll next to it, then run:
+echo   GSswmmEnsemble.exe --model-dir ^<dir^> --inputs ^<dir^> --output ^<dir^> [--workers N]
+exit /b 0
@@ -0,0 +1,69 @@
+//-----------------------------------------------------------------------------
+//   AllocTracker.h
+//   Heap allocation counts per bridge method (debug builds with
+//   GSSWMM_ALLOC_TRACKING)
+//-----------------------------------------------------------------------------
+
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <cstdint>
+
+struct AllocStats {
+    int64_t calls;    // calls counted with CountCall()
+    int64_t allocs;   // operator new calls made inside a Scope for the method
+    int64_t bytes;
+};
+
+/**
+ * @brief Counts operator new calls made by the bridge, per XF_* method
+ *
+ * Built with GSSWMM_ALLOC_TRACKING defined, AllocTracker.cpp replaces the
+ * global operator new and delete. An allocation is counted when the thread
+ * making it is inside a Scope, and is charged to that Scope's method. The
+ * bridge opens a Scope for every call and for the look-ahead step it runs
+ * on the worker thread, so the host's own allocations and those of the
+ * logger and series writer threads are not counted.
+ *
+ * The replacement covers the whole module: GSswmm.dll on Windows, and the
+ * whole process on Linux, where libgsswmm.so's operator new interposes.
+ * Without GSSWMM_ALLOC_TRACKING every member is an empty inline function
+ * and IsEnabled() is false.
+ */
+class AllocTracker {
+public:
+    enum Method { M_INITIALIZE = 0, M_CALCULATE, M_REP_VERSION, M_REP_ARGUMENTS, M_CLEANUP, M_OTHER, M_COUNT };
+
+    static int MethodFromID(int methodID);   // XF_* method ID to Method
+    static const char* MethodName(int method);
+
+#ifdef GSSWMM_ALLOC_TRACKING
+    // Charges this thread's allocations to method until destroyed; scopes nest
+    class Scope {
+    public:
+        explicit Scope(int method);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        int previous_;
+    };
+
+    static bool IsEnabled() { return true; }
+    static void CountCall(int method);
+    static AllocStats Get(int method);
+    static void Reset();
+#else
+    class Scope {
+    public:
+        explicit Scope(int) {}
+    };
+
+    static bool IsEnabled() { return false; }
+    static void CountCall(int) {}
+    static AllocStats Get(int) { AllocStats s = { 0, 0, 0 }; return s; }
+    static void Reset() {}
+#endif
+};
+
+#endif
@@ -0,0 +1,84 @@
+//-----------------------------------------------------------------------------
+//   BridgeLogger.h
+//   Asynchronous ring-buffer logger for the GoldSim-SWMM bridge
+//-----------------------------------------------------------------------------
+
+#ifndef BRIDGE_LOGGER_H
+#define BRIDGE_LOGGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Bounded, lock-free log queue drained by a background writer thread
+ *
+ * Producers format each record (timestamp, level tag, message) straight into
+ * a fixed-size slot of a bounded multi-producer ring buffer, so Write() never
+ * touches the file system. A single writer thread keeps the log file open and
+ * writes records in batches. When the ring is full, records are dropped and
+ * counted rather than blocking the caller; the writer reports drops in the log.
+ *
+ * Memory is fixed at kCapacity * kRecordSize bytes. Flush() drains the ring on
+ * the calling thread and is the guaranteed flush point; Shutdown() also stops
+ * the writer thread and closes the file (the next Write() restarts it).
+ */
+class BridgeLogger {
+public:
+    static const int kRecordSize = 512;   // bytes per record, including newline
+    static const int kCapacity = 2048;    // records (power of two)
+
+    explicit BridgeLogger(const char* path, const char* header);
+    ~BridgeLogger();
+    BridgeLogger(const BridgeLogger&) = delete;
+    BridgeLogger& operator=(const BridgeLogger&) = delete;
+
+    void Write(const char* tag, const char* fmt, va_list ap);
+    void Flush();
+    void Shutdown();
+
+    unsigned long long GetWrittenCount() const { return written_.load(std::memory_order_relaxed); }
+    unsigned long long GetDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<size_t> seq;
+        int len;
+        char text[kRecordSize];
+    };
+
+    bool TryPush(const char* text, int len);
+    bool TryPop(Slot*& slot, size_t& pos);
+    void Release(Slot* slot, size_t pos);
+    void EnsureStarted();
+    void WriterLoop();
+    int DrainLocked();
+    void OpenFileLocked();
+    void ReportDropsLocked();
+
+    std::string path_;
+    std::string header_;
+    Slot* slots_;
+    std::atomic<size_t> enqueue_pos_;
+    std::atomic<size_t> dequeue_pos_;
+
+    std::mutex io_mutex_;        // guards file_ and the consumer side of the ring
+    std::mutex state_mutex_;     // guards writer thread start/stop
+    std::condition_variable wake_;
+    std::thread writer_;
+    std::atomic<bool> running_;
+    std::atomic<bool> stop_;
+    std::atomic<bool> writer_done_;
+    FILE* file_;
+    bool truncate_on_open_;
+
+    std::atomic<unsigned long long> written_;
+    std::atomic<unsigned long long> dropped_;
+    unsigned long long dropped_reported_;
+};
+
+#endif
@@ -0,0 +1,110 @@
+//-----------------------------------------------------------------------------
+//   BridgeProfiler.h
+//   Per-phase latency histograms for the GoldSim-SWMM bridge
+//-----------------------------------------------------------------------------
+
+#ifndef BRIDGE_PROFILER_H
+#define BRIDGE_PROFILER_H
+
+#include "TimelineTracer.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Timed phases, in the order they appear in the JSON summary
+enum ProfilePhase {
+    PH_MAPPING_LOAD = 0,   // MappingLoader::LoadFromFile
+    PH_SWMM_OPEN,          // swmm_open
+    PH_SWMM_START,         // swmm_start (and state restore)
+    PH_RESOLVE,            // ResolveMapping, only in realizations that resolve names
+    PH_INPUT_APPLY,        // ApplyInputs
+    PH_SWMM_STEP,          // each swmm_step / swmm_stride call
+    PH_OUTPUT_GATHER,      // SampleOutputs
+    PH_LOGGING,            // time spent queuing log records
+    PH_CALCULATE,          // whole XF_CALCULATE call, as GoldSim sees it
+    PH_COUNT
+};
+
+/**
+ * @brief Log-linear latency histogram (HDR style) with fixed buckets
+ *
+ * Values below 64 ns get their own bucket. Above that, each power of two is
+ * split into 32 buckets, so any recorded value is within ~3% of its bucket.
+ * This covers 1 ns to beyond a year in 1920 counters. Record() does
+ * no allocation and is safe to call from several threads.
+ */
+class LatencyHistogram {
+public:
+    static const int kBucketCount = 1920;
+
+    LatencyHistogram();
+    void Record(uint64_t ns);
+    void Reset();
+
+    uint64_t GetCount() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t GetTotal() const { return total_.load(std::memory_order_relaxed); }
+    uint64_t GetMax() const { return max_.load(std::memory_order_relaxed); }
+    uint64_t GetPercentile(double q) const;   // upper bound of the bucket holding quantile q
+
+    static int BucketIndex(uint64_t ns);
+    static uint64_t BucketUpperBound(int index);
+
+private:
+    std::atomic<uint64_t> buckets_[kBucketCount];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> total_;
+    std::atomic<uint64_t> max_;
+};
+
+/**
+ * @brief Phase timers for SwmmGoldSimBridge(), enabled from the JSON mapping
+ *
+ * When disabled, Start() returns 0 without reading the clock and Stop()
+ * returns immediately, so instrumented code pays one predictable branch.
+ * With a timeline attached, every timed phase is also a span on it, and
+ * Span() adds spans that have no histogram. PH_CALCULATE is left out, as the
+ * bridge traces it as the XF_CALCULATE method span, and so is PH_LOGGING,
+ * which would add a span per Log() call; its time stays in the enclosing span. A start of 0 was taken
+ * while nothing was attached and is not traced.
+ */
+class BridgeProfiler {
+public:
+    BridgeProfiler() : enabled_(false), active_(false), realizations_(0), timeline_(NULL) {}
+    BridgeProfiler(const BridgeProfiler&) = delete;
+    BridgeProfiler& operator=(const BridgeProfiler&) = delete;
+
+    void SetEnabled(bool enabled) { enabled_ = enabled; active_ = enabled_ || timeline_; }
+    bool IsEnabled() const { return enabled_; }
+    void SetTimeline(TimelineTracer* timeline) { timeline_ = timeline; active_ = enabled_ || timeline_; }
+    TimelineTracer* GetTimeline() const { return timeline_; }
+
+    static uint64_t Now();                     // monotonic clock, ns
+    uint64_t Start() const { return active_ ? Now() : 0; }
+    void Stop(int phase, uint64_t start) {
+        if (!active_) return;
+        uint64_t now = Now();
+        if (enabled_) phases_[phase].Record(now - start);
+        if (timeline_ && start != 0 && phase != PH_CALCULATE && phase != PH_LOGGING)
+            timeline_->Span(PhaseName(phase), start, now);
+    }
+    void Span(const char* name, uint64_t start) {
+        if (timeline_ && start != 0) timeline_->Span(name, start, Now());
+    }
+    void Record(int phase, uint64_t ns) { phases_[phase].Record(ns); }
+    void CountRealization() { realizations_++; }
+
+    const LatencyHistogram& GetPhase(int phase) const { return phases_[phase]; }
+    static const char* PhaseName(int phase);
+
+    bool WriteSummary(const char* path) const;
+    void Reset();
+
+private:
+    bool enabled_;
+    bool active_;                  // enabled_ or a timeline attached
+    int realizations_;
+    TimelineTracer* timeline_;
+    LatencyHistogram phases_[PH_COUNT];
+};
+
+#endif
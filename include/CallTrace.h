@@ -0,0 +1,125 @@
+//-----------------------------------------------------------------------------
+//   CallTrace.h
+//   Binary trace of SwmmGoldSimBridge calls, for headless replay
+//-----------------------------------------------------------------------------
+
+#ifndef CALL_TRACE_H
+#define CALL_TRACE_H
+
+#include "MappedFile.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// File layout (native byte order, every block a multiple of 8 bytes):
+//
+//   CallTraceHeader
+//   call*: CallTraceRecord, `inputs` doubles (the inargs GoldSim passed),
+//          `outputs` doubles (the outargs the bridge returned), then
+//          message_size bytes of error text padded to 8 bytes
+//
+// A call that failed with status -1 stores its message instead of outputs.
+// The hashes identify the mapping and model.inp the calls were made against.
+struct CallTraceHeader {
+    char magic[4];           // "GSCT"
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t record_header_size;
+    uint64_t config_hash;
+    uint64_t model_hash;
+    int32_t input_count;     // of the mapping at the time of recording
+    int32_t output_count;
+};
+
+struct CallTraceRecord {
+    int32_t method;          // XF_* method ID
+    int32_t status;          // as returned to GoldSim
+    int32_t inputs;          // doubles of inargs that follow
+    int32_t outputs;         // doubles of outargs that follow
+    int32_t message_size;    // bytes of error text, without padding or NUL
+    int32_t reserved;
+};
+
+#define CALL_TRACE_FORMAT_VERSION 1
+
+/**
+ * @brief Appends bridge calls to a trace file through a write buffer
+ *
+ * Record() copies the call into the buffer and only touches the file when
+ * the buffer is full, so XF_CALCULATE pays a memcpy of its arguments. The
+ * bridge calls Flush() at XF_CLEANUP, which leaves every finished
+ * realization on disk if GoldSim is killed later.
+ */
+class CallTraceWriter {
+public:
+    static const size_t kBufferBytes = 1 << 20;
+
+    CallTraceWriter();
+    ~CallTraceWriter();
+    CallTraceWriter(const CallTraceWriter&) = delete;
+    CallTraceWriter& operator=(const CallTraceWriter&) = delete;
+
+    // Create (truncate) the file and write the header
+    bool Open(const char* path, uint64_t config_hash, uint64_t model_hash, int input_count, int output_count,
+              std::string& error);
+    void Record(int method, int status, const double* inargs, int inputs, const double* outargs, int outputs,
+                const char* message);
+    bool Flush(std::string& error);   // false if any write since the last Flush() failed
+    void Close();
+
+    bool IsOpen() const { return file_ != NULL; }
+    const std::string& GetPath() const { return path_; }
+    uint64_t GetConfigHash() const { return config_hash_; }
+    uint64_t GetModelHash() const { return model_hash_; }
+    int64_t GetCallCount() const { return calls_; }
+
+private:
+    void Append(const void* data, size_t bytes);
+    void WriteBuffer();
+
+    std::string path_;
+    FILE* file_;
+    uint64_t config_hash_, model_hash_;
+    int64_t calls_;
+    std::vector<char> buffer_;
+    size_t used_;
+    bool failed_;
+};
+
+/**
+ * @brief Memory-maps a trace file and indexes its calls
+ *
+ * A file whose writer was interrupted is readable up to its last complete
+ * call; IsTruncated() tells the two apart.
+ */
+class CallTraceReader {
+public:
+    struct Call {
+        int method;
+        int status;
+        const double* inargs;    // valid until Close()
+        int inputs;
+        const double* outargs;
+        int outputs;
+        const char* message;     // not NUL-terminated
+        int message_size;
+    };
+
+    CallTraceReader();
+    bool Open(const char* path, std::string& error);
+    void Close();
+
+    const CallTraceHeader& GetHeader() const { return header_; }
+    size_t GetCallCount() const { return calls_.size(); }
+    const Call& GetCall(size_t i) const { return calls_[i]; }
+    bool IsTruncated() const { return truncated_; }
+
+private:
+    MappedFile file_;
+    CallTraceHeader header_;
+    std::vector<Call> calls_;
+    bool truncated_;
+};
+
+#endif
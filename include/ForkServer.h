@@ -0,0 +1,47 @@
+//-----------------------------------------------------------------------------
+//   ForkServer.h
+//   Runs tasks in copy-on-write child processes of a prepared parent (POSIX)
+//-----------------------------------------------------------------------------
+
+#ifndef FORK_SERVER_H
+#define FORK_SERVER_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Forks one child per task from the calling process, a few at a time
+ *
+ * The parent does the expensive setup once (load the mapping, open and parse
+ * the model, resolve names); every child starts from a copy-on-write image of
+ * that state, so the parsed model is shared until a child writes to it. A
+ * task's result is its child's exit code. Anything larger goes through
+ * SharedAlloc() memory, which parent and children see alike.
+ *
+ * Only threads that call fork() survive in the child, so the parent must not
+ * have other threads running (the bridge has none after XF_CLEANUP).
+ * Children leave with _exit(): stdio buffers and static destructors inherited
+ * from the parent are not run a second time.
+ */
+class ForkServer {
+public:
+    typedef int (*TaskFunction)(int task, void* context);   // runs in the child; 0 = success
+
+    ForkServer();
+
+    // Tasks 0..count-1, at most `workers` children at once; returns the number that failed
+    int Run(int count, int workers, TaskFunction task, void* context);
+
+    int GetExitCode(int task) const { return exit_codes_[task]; }   // -1 if fork failed or killed by a signal
+    double GetWallSeconds() const { return wall_seconds_; }
+
+    // Zero-filled memory shared with children forked afterwards
+    static void* SharedAlloc(size_t bytes);
+    static void SharedFree(void* p, size_t bytes);
+
+private:
+    std::vector<int> exit_codes_;
+    double wall_seconds_;
+};
+
+#endif
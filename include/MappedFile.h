@@ -0,0 +1,37 @@
+//-----------------------------------------------------------------------------
+//   MappedFile.h
+//   Read-only memory mapping of a whole file
+//-----------------------------------------------------------------------------
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+
+/**
+ * @brief Maps a file read-only with MapViewOfFile or mmap
+ *
+ * The file handle is closed as soon as the view exists; the view stays valid
+ * until Close(). Missing and empty files are not mapped. On Windows the file
+ * is opened with FILE_SHARE_DELETE so a writer can still replace it by rename.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const char* path);
+    void Close();
+
+    bool IsOpen() const { return view_ != NULL; }
+    const char* GetData() const { return (const char*)view_; }
+    size_t GetSize() const { return size_; }
+
+private:
+    void* view_;
+    size_t size_;
+};
+
+#endif
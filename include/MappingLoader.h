@@ -25,8 +25,9 @@ public:
         std::string name;
         std::string object_type;
         std::string property;
+        std::string aggregation;   // INSTANTANEOUS (default), MEAN, MAX, MIN or INTEGRAL
         int swmm_index;
-        OutputMapping() : interface_index(0), swmm_index(-1) {}
+        OutputMapping() : interface_index(0), aggregation("INSTANTANEOUS"), swmm_index(-1) {}
     };
 
     MappingLoader();
@@ -38,14 +39,44 @@ public:
     
     int GetInputCount() const;
     int GetOutputCount() const;
+    const std::string& GetHash() const;               // inp_file_hash, "" if absent
     const std::vector<InputMapping>& GetInputs() const;
     const std::vector<OutputMapping>& GetOutputs() const;
     const std::string& GetLoggingLevel() const;
+    const std::string& GetCouplingMode() const;       // "STEP" (default) or "SYNC"
+    const std::string& GetElapsedTimeUnits() const;   // units of the ElapsedTime input
+    bool GetPipelinedStepping() const;                // step SWMM ahead on a worker thread
+    double GetHotstartSpinupDays() const;             // 0 = no spin-up snapshot
+    bool GetProfiling() const;                        // write bridge_profile.json at cleanup
+    bool GetPlanCache() const;                        // reuse SwmmGoldSimBridge.plan (default true)
+    const std::string& GetOutputPolicy() const;       // "FULL" (default), "MAPPED" or "NONE"
+    const std::string& GetReportFile() const;         // swmm_open report file (default model.rpt)
+    const std::string& GetOutputFile() const;         // swmm_open binary output file (default model.out)
+    const std::string& GetSeriesFile() const;         // columnar series recording, "" = off
+    int GetSeriesDecimation() const;                  // record every Nth XF_CALCULATE (default 1)
+    bool GetRecycleProject() const;                   // keep the SWMM project open across realizations
+    const std::string& GetCallTrace() const;          // record every bridge call to this file, "" = off
+    const std::string& GetTimelineFile() const;       // Chrome trace-event timeline, "" = off
 
 private:
     std::vector<InputMapping> inputs_;
     std::vector<OutputMapping> outputs_;
+    std::string hash_;
     std::string logging_level_;
+    std::string coupling_mode_;
+    std::string elapsed_time_units_;
+    bool pipelined_stepping_;
+    double hotstart_spinup_days_;
+    bool profiling_;
+    bool plan_cache_;
+    std::string output_policy_;
+    std::string report_file_;
+    std::string output_file_;
+    std::string series_file_;
+    int series_decimation_;
+    bool recycle_project_;
+    std::string call_trace_;
+    std::string timeline_file_;
 };
 
 #endif
@@ -0,0 +1,53 @@
+//-----------------------------------------------------------------------------
+//   NameIndex.h
+//   Open-addressing hash table from SWMM element name to index
+//-----------------------------------------------------------------------------
+
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Name -> index map for one SWMM object type, filled once per resolution
+ *
+ * Names are interned into one contiguous buffer and the table stores only
+ * offsets, so building the index for 100k elements is a handful of
+ * allocations. Lookups are case-insensitive, matching swmm_getIndex. The
+ * table uses linear probing and is kept at most half full.
+ */
+class NameIndex {
+public:
+    NameIndex();
+
+    void Clear();
+    void Reserve(int count);
+
+    // Add a name; returns false (and keeps the first index) if it is already present
+    bool Add(const char* name, int index);
+    int Find(const std::string& name) const;   // index, or -1
+    int GetCount() const { return count_; }
+
+    // Closest name by case-insensitive edit distance, "" if nothing is close
+    std::string Suggest(const std::string& name) const;
+
+private:
+    struct Slot {
+        uint32_t hash;
+        int32_t offset;   // into names_, -1 if empty
+        int32_t index;
+    };
+
+    static uint32_t Hash(const char* s, size_t n);
+    void Grow();
+    int FindSlot(const char* s, size_t n, uint32_t h) const;
+
+    std::vector<Slot> slots_;     // power-of-two size
+    std::vector<char> names_;     // NUL-terminated names, back to back
+    int count_;
+};
+
+#endif
@@ -0,0 +1,89 @@
+//-----------------------------------------------------------------------------
+//   PlanCache.h
+//   Binary cache of the resolved mapping, reused while the model and
+//   mapping files are unchanged
+//-----------------------------------------------------------------------------
+
+#ifndef PLAN_CACHE_H
+#define PLAN_CACHE_H
+
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One resolved input or output, stored as a fixed-width record
+struct PlanRecord {
+    int32_t iface_idx;     // GoldSim interface index
+    int32_t obj_type;      // swmm_Object of the element (swmm_SUBCATCH for LID outputs)
+    int32_t prop_enum;     // SWMM property enum (-1 for LID outputs)
+    int32_t swmm_idx;      // element index, or subcatchment index for LID outputs
+    int32_t lid_idx;       // LID unit index, -1 otherwise
+    int32_t accessor;      // OutputAccessor (outputs only)
+    int32_t aggregation;   // OutputAggregation (outputs only)
+};
+
+#define PLAN_PATH_SIZE 260   // MAX_PATH
+
+// Mapping settings after validation, so a cache hit needs no JSON parse
+struct PlanSettings {
+    int32_t log_level;         // 0=OFF .. 3=DEBUG
+    int32_t coupling_mode;     // CouplingMode
+    int32_t pipelined;
+    int32_t profiling;
+    double elapsed_to_days;    // ElapsedTime input units -> days
+    double spinup_days;
+    int32_t output_policy;     // OutputPolicy
+    char report_file[PLAN_PATH_SIZE];   // NUL-terminated swmm_open file names
+    char output_file[PLAN_PATH_SIZE];
+    int32_t series_decimation;
+    char series_file[PLAN_PATH_SIZE];   // "" = no series recording
+    int32_t recycle_project;
+    char call_trace[PLAN_PATH_SIZE];    // "" = no call trace
+    char timeline_file[PLAN_PATH_SIZE]; // "" = no timeline
+};
+
+/**
+ * @brief Reads and writes the compiled plan file (SwmmGoldSimBridge.plan)
+ *
+ * The file is a header (magic, format version, content hashes of the mapping
+ * and model files, settings, record counts) followed by the input and output
+ * records. Load() memory-maps it and rejects it unless every header field
+ * matches; records are in native byte order, as the file never leaves the
+ * machine that wrote it. Save() writes a temporary file and renames it, so a
+ * reader never sees a partial plan.
+ */
+class PlanCache {
+public:
+    static const uint32_t kFormatVersion = 7;   // bump when record meaning changes
+
+    PlanCache();
+    ~PlanCache();
+    PlanCache(const PlanCache&) = delete;
+    PlanCache& operator=(const PlanCache&) = delete;
+
+    // 64-bit content hash of a file; false if it cannot be read
+    static bool HashFile(const char* path, uint64_t& hash);
+
+    // Map the plan; false (with the reason) if it is missing, corrupt or stale
+    bool Load(const char* path, uint64_t config_hash, uint64_t model_hash, std::string& reason);
+    void Close();
+
+    static bool Save(const char* path, uint64_t config_hash, uint64_t model_hash,
+                     const PlanSettings& settings,
+                     const std::vector<PlanRecord>& inputs,
+                     const std::vector<PlanRecord>& outputs,
+                     std::string& error);
+
+    // Valid between a successful Load() and Close()
+    const PlanSettings& GetSettings() const;
+    int GetInputCount() const;
+    int GetOutputCount() const;
+    const PlanRecord* GetInputs() const;
+    const PlanRecord* GetOutputs() const;
+
+private:
+    MappedFile file_;
+};
+
+#endif
@@ -0,0 +1,134 @@
+//-----------------------------------------------------------------------------
+//   Platform.h
+//   Thin platform layer so the bridge builds as GSswmm.dll on Windows and
+//   as libgsswmm.so elsewhere
+//-----------------------------------------------------------------------------
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+#define GSSWMM_EXPORT __declspec(dllexport)
+
+#else
+
+#include <cerrno>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <dlfcn.h>
+#include <sys/time.h>
+
+#define GSSWMM_EXPORT __attribute__((visibility("default")))
+
+// GoldSim passes the error string back as a pointer stored in outargs[0]
+typedef uintptr_t ULONG_PTR;
+typedef void* HMODULE;
+
+//--- Strings (the subset of the MSVC secure CRT the bridge uses) ------------
+
+#define _TRUNCATE ((size_t)-1)
+
+/**
+ * @brief strncpy_s: always terminates; with _TRUNCATE, copies what fits
+ * @return 0 on success, EINVAL for bad arguments, ERANGE if src did not fit
+ */
+inline int strncpy_s(char* dest, size_t size, const char* src, size_t count) {
+    if (!dest || size == 0) return EINVAL;
+    if (!src) { dest[0] = '\0'; return EINVAL; }
+    size_t n = strnlen(src, count == _TRUNCATE ? size : count);
+    if (n >= size) {
+        n = size - 1;
+        if (count != _TRUNCATE) { dest[0] = '\0'; return ERANGE; }
+    }
+    memcpy(dest, src, n);
+    dest[n] = '\0';
+    return 0;
+}
+
+template <size_t N>
+__attribute__((format(printf, 2, 3)))
+inline int sprintf_s(char (&buf)[N], const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buf, N, format, args);
+    va_end(args);
+    return n;
+}
+
+//--- Files ------------------------------------------------------------------
+
+inline int fopen_s(FILE** file, const char* path, const char* mode) {
+    if (!file) return EINVAL;
+    *file = fopen(path, mode);
+    return *file ? 0 : errno;
+}
+
+//--- Time -------------------------------------------------------------------
+
+typedef struct {
+    unsigned short wYear;
+    unsigned short wMonth;
+    unsigned short wDayOfWeek;
+    unsigned short wDay;
+    unsigned short wHour;
+    unsigned short wMinute;
+    unsigned short wSecond;
+    unsigned short wMilliseconds;
+} SYSTEMTIME;
+
+inline void GetLocalTime(SYSTEMTIME* st) {
+    struct timeval tv;
+    struct tm t;
+    gettimeofday(&tv, NULL);
+    localtime_r(&tv.tv_sec, &t);
+    st->wYear = (unsigned short)(t.tm_year + 1900);
+    st->wMonth = (unsigned short)(t.tm_mon + 1);
+    st->wDayOfWeek = (unsigned short)t.tm_wday;
+    st->wDay = (unsigned short)t.tm_mday;
+    st->wHour = (unsigned short)t.tm_hour;
+    st->wMinute = (unsigned short)t.tm_min;
+    st->wSecond = (unsigned short)t.tm_sec;
+    st->wMilliseconds = (unsigned short)(tv.tv_usec / 1000);
+}
+
+//--- Shared libraries -------------------------------------------------------
+
+/**
+ * @brief Handle of the loaded shared library that contains an address
+ * @note Used instead of a lookup by file name, because the SWMM engine may be
+ *       libswmm5.so, a differently named build, or linked into this library.
+ *       The handle stays valid while the library is loaded; callers pass the
+ *       address of a function they link against, so it always is.
+ */
+inline HMODULE PlatformModuleFromAddress(const void* addr) {
+    Dl_info info;
+    if (!dladdr(addr, &info) || !info.dli_fname) return NULL;
+    HMODULE h = dlopen(info.dli_fname, RTLD_LAZY | RTLD_NOLOAD);
+    if (!h) h = dlopen(NULL, RTLD_LAZY);   // the main program is not found by path
+    if (h) dlclose(h);   // drop the reference dlopen added
+    return h;
+}
+
+inline void* GetProcAddress(HMODULE module, const char* name) {
+    return module ? dlsym(module, name) : NULL;
+}
+
+inline HMODULE LoadLibraryA(const char* path) {
+    return dlopen(path, RTLD_NOW | RTLD_LOCAL);
+}
+
+// Nonzero on success, as on Windows
+inline int FreeLibrary(HMODULE module) {
+    return module && dlclose(module) == 0;
+}
+
+#endif
+
+#endif
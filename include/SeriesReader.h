@@ -0,0 +1,64 @@
+//-----------------------------------------------------------------------------
+//   SeriesReader.h
+//   Zero-copy reader for files written by SeriesRecorder
+//-----------------------------------------------------------------------------
+
+#ifndef SERIES_READER_H
+#define SERIES_READER_H
+
+#include "MappedFile.h"
+#include "SeriesRecorder.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Memory-maps a series file and indexes its chunks
+ *
+ * GetColumn() returns pointers into the mapping, one span per chunk, so a
+ * column is read without copying or decoding. A file whose writer was
+ * interrupted is still readable up to its last complete chunk.
+ */
+class SeriesReader {
+public:
+    struct Span {
+        const double* values;   // valid until Close()
+        int rows;
+        int64_t first_step;     // XF_CALCULATE call number of values[0]
+    };
+
+    SeriesReader();
+    bool Open(const char* path, std::string& error);
+    void Close();
+
+    int GetInputCount() const { return input_count_; }
+    int GetOutputCount() const { return output_count_; }
+    int GetColumnCount() const { return 1 + input_count_ + output_count_; }
+    int GetDecimation() const { return decimation_; }
+    bool IsTruncated() const { return truncated_; }   // the file ends inside a chunk
+
+    // Column numbers
+    static int TimeColumn() { return 0; }
+    int InputColumn(int i) const { return 1 + i; }
+    int OutputColumn(int i) const { return 1 + input_count_ + i; }
+
+    // Realizations are numbered 0..count-1 in the order they ran
+    int GetRealizationCount() const { return (int)segments_.size(); }
+    int64_t GetRowCount(int realization) const;
+    void GetColumn(int realization, int column, std::vector<Span>& spans) const;
+    void ReadColumn(int realization, int column, std::vector<double>& values) const;   // copies
+
+private:
+    struct Chunk {
+        size_t offset;   // of the first column block
+        int rows;
+        int64_t first_step;
+    };
+
+    MappedFile file_;
+    int input_count_, output_count_, decimation_;
+    bool truncated_;
+    std::vector<std::vector<Chunk>> segments_;   // chunks per realization
+};
+
+#endif
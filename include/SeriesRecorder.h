@@ -0,0 +1,115 @@
+//-----------------------------------------------------------------------------
+//   SeriesRecorder.h
+//   Columnar time-series file of bridge inputs and outputs
+//-----------------------------------------------------------------------------
+
+#ifndef SERIES_RECORDER_H
+#define SERIES_RECORDER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// File layout (native byte order, every block a multiple of 8 bytes):
+//
+//   SeriesFileHeader
+//   chunk*: SeriesChunkHeader, then column_count blocks of `rows` doubles
+//
+// Columns are elapsed time (days since GoldSim time 0), the GoldSim inputs,
+// then the GoldSim outputs. A chunk holds rows of a single realization, and
+// a realization's chunks are contiguous, so each realization is a segment.
+struct SeriesFileHeader {
+    char magic[4];           // "GSTS"
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t chunk_header_size;
+    int32_t input_count;
+    int32_t output_count;
+    int32_t column_count;    // 1 + input_count + output_count
+    int32_t chunk_rows;      // rows per full chunk
+    int32_t decimation;      // one row per this many XF_CALCULATE calls
+    int32_t reserved;
+};
+
+struct SeriesChunkHeader {
+    char magic[4];           // "GSCK"
+    int32_t realization;     // 0-based, in the order the bridge ran them
+    int32_t rows;            // 0 for a realization that recorded nothing
+    int32_t reserved;
+    int64_t first_step;      // XF_CALCULATE call number of row 0 (first call = 0)
+};
+
+#define SERIES_FORMAT_VERSION 1
+
+/**
+ * @brief Appends one row per recorded XF_CALCULATE to a chunked columnar file
+ *
+ * Record() copies the row into the current chunk buffer, column by column,
+ * and never allocates or touches the file. Full chunks go to a writer thread
+ * through a small pool of preallocated buffers; the calling thread only
+ * blocks if the writer falls kBufferCount chunks behind. Chunks are about
+ * kChunkBytes, so wide interfaces get fewer rows per chunk rather than
+ * larger buffers. End() writes the partial last chunk, joins the writer and
+ * closes the file, so every realization ends with its rows on disk.
+ *
+ * The first Begin() in a process creates the file; later realizations are
+ * appended unless the path, input or output count, or decimation changed,
+ * which starts a new file.
+ */
+class SeriesRecorder {
+public:
+    static const int kChunkBytes = 1 << 20;   // target chunk size
+    static const int kMinChunkRows = 16;
+    static const int kMaxChunkRows = 4096;
+    static const int kBufferCount = 4;
+
+    SeriesRecorder();
+    ~SeriesRecorder();
+    SeriesRecorder(const SeriesRecorder&) = delete;
+    SeriesRecorder& operator=(const SeriesRecorder&) = delete;
+
+    // Start a realization segment; false (with the error) if the file cannot be opened
+    bool Begin(const char* path, int input_count, int output_count, int decimation, std::string& error);
+    void Record(double elapsed, const double* inputs, const double* outputs);
+    bool End(std::string& error);    // false if any write failed
+
+    bool IsActive() const { return active_; }
+    int GetRealization() const { return realization_; }   // current or last segment
+    int64_t GetRowCount() const { return rows_; }         // rows recorded in that segment
+    int GetChunkRows() const { return chunk_rows_; }
+
+private:
+    double* Buffer(int i) { return &buffers_[(size_t)i * column_count_ * chunk_rows_]; }
+    void AcquireBuffer(int64_t first_step);
+    void Submit();
+    void WriterLoop();
+
+    std::string path_;
+    FILE* file_;
+    bool active_;
+    int input_count_, output_count_, column_count_;
+    int decimation_;
+    int chunk_rows_;
+    int realization_;           // -1 before the first Begin()
+    int64_t step_;              // XF_CALCULATE calls seen in this segment
+    int64_t rows_;
+
+    std::vector<double> buffers_;        // kBufferCount chunks, column-major
+    SeriesChunkHeader chunks_[kBufferCount];
+    int current_;                        // buffer being filled, -1 if none
+
+    std::mutex mutex_;                   // guards the queues, stop_ and failed_
+    std::condition_variable queued_;
+    std::condition_variable freed_;
+    int free_[kBufferCount], free_count_;
+    int queue_[kBufferCount], queue_head_, queue_count_;
+    bool stop_;
+    bool failed_;
+    std::thread writer_;
+};
+
+#endif
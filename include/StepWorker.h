@@ -0,0 +1,56 @@
+//-----------------------------------------------------------------------------
+//   StepWorker.h
+//   Single-job worker thread for look-ahead SWMM stepping
+//-----------------------------------------------------------------------------
+
+#ifndef STEP_WORKER_H
+#define STEP_WORKER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Runs one job at a time on a dedicated thread
+ *
+ * The bridge submits "apply inputs, step, sample outputs" right before
+ * XF_CALCULATE returns and waits for it at the start of the next call, so
+ * SWMM runs while GoldSim computes. At most one job is in flight and the
+ * submitting thread never touches SWMM until Wait() returns, so SWMM is
+ * only ever called from one thread at a time.
+ *
+ * Jobs are plain function pointers so Submit() does not allocate.
+ */
+class StepWorker {
+public:
+    typedef int (*Job)();
+
+    StepWorker();
+    ~StepWorker();
+    StepWorker(const StepWorker&) = delete;
+    StepWorker& operator=(const StepWorker&) = delete;
+
+    void Start();
+    void Stop();                     // waits for an in-flight job, then joins
+    bool IsRunning() const { return thread_.joinable(); }
+
+    void Submit(Job job);            // job must be non-NULL; one in flight at a time
+    bool IsBusy();
+    int Wait();                      // result of the last job (0 if none was submitted)
+    double GetLastWaitMs() const { return last_wait_ms_; }
+
+private:
+    void Loop();
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable job_ready_;
+    std::condition_variable job_done_;
+    Job job_;
+    bool busy_;
+    bool stop_;
+    int result_;
+    double last_wait_ms_;
+};
+
+#endif
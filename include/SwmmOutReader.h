@@ -0,0 +1,102 @@
+//-----------------------------------------------------------------------------
+//   SwmmOutReader.h
+//   Memory-mapped reader for SWMM 5 binary output files (model.out)
+//-----------------------------------------------------------------------------
+
+#ifndef SWMM_OUT_READER_H
+#define SWMM_OUT_READER_H
+
+#include "MappedFile.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Object types in the order SWMM writes them
+enum SwmmOutType { OUT_SUBCATCH = 0, OUT_NODE = 1, OUT_LINK = 2, OUT_SYSTEM = 3, OUT_TYPE_COUNT = 4 };
+
+/**
+ * @brief Decodes the layout of a SWMM .out file once and reads series in place
+ *
+ * The file is memory-mapped. Open() reads the element names, reporting
+ * variables and period count. After that, a series (one variable of one
+ * element over all reporting periods) is a strided view into the mapping:
+ * nothing is copied until a value is read. The file only holds the elements
+ * SWMM reported (see "output_policy"), so names are looked up in the file,
+ * not in model.inp.
+ *
+ * Values are 4-byte floats at arbitrary offsets (ID names have any length),
+ * so they are read with memcpy rather than through a float pointer.
+ */
+class SwmmOutReader {
+public:
+    // One variable of one element across all reporting periods
+    struct Series {
+        const char* first;   // value of period 0
+        size_t stride;       // bytes between periods
+        int count;           // periods
+        float operator[](int period) const {
+            float v;
+            memcpy(&v, first + stride * (size_t)period, sizeof(v));
+            return v;
+        }
+    };
+
+    struct Stats {
+        int count;
+        double min, max, mean;
+        double integral;     // sum of value x report step (seconds), e.g. CFS -> ft3
+        int argmax;          // period of the maximum
+    };
+
+    struct Request {
+        int type;            // SwmmOutType
+        int index;           // element index in the file (0 for OUT_SYSTEM)
+        int variable;        // position in the type's variable list
+    };
+
+    SwmmOutReader();
+    bool Open(const char* path, std::string& error);
+    void Close();
+
+    int GetVersion() const { return version_; }
+    int GetFlowUnits() const { return flow_units_; }   // swmm_FlowUnitsProperty
+    int GetPeriodCount() const { return periods_; }
+    int GetReportStep() const { return report_step_; } // seconds
+    double GetStartDate() const { return start_date_; }
+    double GetPeriodDate(int period) const;            // SWMM date of a reporting period
+
+    int GetCount(int type) const;                      // elements (1 for OUT_SYSTEM)
+    const std::string& GetName(int type, int index) const;
+    int FindElement(int type, const std::string& name) const;   // -1 if not reported
+    int GetVariableCount(int type) const;
+    std::string GetVariableName(int type, int variable) const;
+    int FindVariable(int type, const std::string& name) const;  // -1 if unknown
+
+    // Accepts SWMM and bridge object types (JUNCTION, OUTFALL, CONDUIT, PUMP, ...)
+    static int TypeFromName(const std::string& name);
+    static const char* TypeName(int type);
+
+    bool GetSeries(int type, int index, int variable, Series& series) const;
+    static Stats Summarize(const Series& series, double step_seconds);
+
+    // Copy many series at once: threads split the periods, so each period's
+    // block of the file is read once no matter how many series are requested
+    bool Extract(const std::vector<Request>& requests, std::vector<std::vector<float>>& values,
+                 int threads) const;
+
+private:
+    size_t ValueOffset(int type, int index, int variable) const;   // within a period
+
+    MappedFile file_;
+    int version_, flow_units_, periods_, report_step_;
+    double start_date_;
+    int counts_[OUT_TYPE_COUNT];
+    std::vector<std::string> names_[OUT_TYPE_COUNT];   // pollutants in names_[OUT_SYSTEM]
+    std::vector<int> var_codes_[OUT_TYPE_COUNT];
+    size_t type_offset_[OUT_TYPE_COUNT];               // within a period, after the date
+    size_t results_offset_;
+    size_t period_bytes_;
+};
+
+#endif
@@ -0,0 +1,85 @@
+//-----------------------------------------------------------------------------
+//   TimelineTracer.h
+//   Chrome/Perfetto trace-event timeline of bridge and SWMM phases
+//-----------------------------------------------------------------------------
+
+#ifndef TIMELINE_TRACER_H
+#define TIMELINE_TRACER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Collects timed spans per thread and appends them to a trace file
+ *
+ * Span() stores the name, start, end and the current realization and step
+ * in a buffer owned by the calling thread, so recording takes no lock and,
+ * once the buffers have grown to a realization's size, does not allocate.
+ * A thread's buffer holds at most max_events spans between writes; the rest
+ * are counted as dropped. Names must be string literals.
+ *
+ * Write() appends every buffered span to the file as complete ("X") trace
+ * events, in the JSON Array Format that chrome://tracing and Perfetto read:
+ * the first write in a process (or after the path changes) creates the file
+ * with the opening "[", and the array is never closed, so later writes just
+ * append. It must only be called while no other thread is recording; the
+ * bridge calls it at XF_CLEANUP, after the look-ahead worker has stopped.
+ */
+class TimelineTracer {
+public:
+    static const int kChunkEvents = 4096;
+    static const int kDefaultMaxEvents = 1 << 20;
+
+    explicit TimelineTracer(int max_events = kDefaultMaxEvents);   // per thread between writes
+    ~TimelineTracer();
+    TimelineTracer(const TimelineTracer&) = delete;
+    TimelineTracer& operator=(const TimelineTracer&) = delete;
+
+    // Tags for the spans that follow; a realization starts at step -1 (no step)
+    void BeginRealization();
+    void NextStep() { step_.fetch_add(1, std::memory_order_relaxed); }
+    int GetRealization() const { return realization_.load(std::memory_order_relaxed); }
+    int64_t GetStep() const { return step_.load(std::memory_order_relaxed); }
+
+    void Span(const char* name, uint64_t start_ns, uint64_t end_ns);   // BridgeProfiler::Now() times
+
+    bool Write(const char* path, std::string& error);   // false if the file cannot be written
+    int64_t GetWrittenCount() const { return written_; }     // spans written by the last Write()
+    int64_t GetDroppedCount() const { return dropped_; }     // spans dropped before the last Write()
+
+private:
+    struct Event {
+        const char* name;
+        uint64_t start, end;
+        int32_t realization;
+        int32_t reserved;
+        int64_t step;
+    };
+
+    struct ThreadBuffer {
+        int tid;
+        bool in_use;
+        int count;
+        int64_t dropped;
+        std::vector<std::unique_ptr<Event[]>> chunks;
+    };
+
+    ThreadBuffer* AcquireBuffer(int tid);
+
+    const uint64_t id_;                  // distinguishes tracers in the per-thread cache
+    const uint64_t epoch_ns_;            // time 0 of the trace
+    const int max_events_;               // per thread between writes
+    std::atomic<uint32_t> generation_;   // bumped by Write(), which hands out buffers again
+    std::atomic<int> realization_;
+    std::atomic<int64_t> step_;
+    std::mutex mutex_;                   // guards buffers_
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    std::string path_;                   // file created by the last Write(), "" before
+    int64_t written_, dropped_;
+};
+
+#endif
@@ -146,6 +146,10 @@ int    DLLEXPORT swmm_getIndex(int objType, const char *name);
 double DLLEXPORT swmm_getValue(int property, int index);
 void   DLLEXPORT swmm_setValue(int property, int index,  double value);
 double DLLEXPORT swmm_getSavedValue(int property, int index, int period);
+
+// Vectorized value API extensions - one call for many (property, index) pairs
+int    DLLEXPORT swmm_getValues(const int* props, const int* indexes, int n, double* values);
+int    DLLEXPORT swmm_setValues(const int* props, const int* indexes, int n, const double* values);
 void   DLLEXPORT swmm_writeLine(const char *line);
 void   DLLEXPORT swmm_decodeDate(double date, int *year, int *month, int *day,
                  int *hour, int *minute, int *second, int *dayOfWeek);
@@ -158,6 +162,18 @@ double DLLEXPORT swmm_getLidUSurfaceOutflow(int subcatchIndex, int lidIndex);
 double DLLEXPORT swmm_getLidUSurfaceInflow(int subcatchIndex, int lidIndex);
 double DLLEXPORT swmm_getLidUDrainFlow(int subcatchIndex, int lidIndex);
 
+// Batched LID API - one call for many units (structure-of-arrays buffers)
+int    DLLEXPORT swmm_getLidUTotalCount(void);
+int    DLLEXPORT swmm_getLidUStates(int n, const int* subcatchIndex, const int* lidIndex,
+                                    double* storageVolume, double* surfaceInflow,
+                                    double* surfaceOutflow, double* drainFlow,
+                                    double* evapVolume, double* exfilVolume);
+
+// State snapshot API - save/restore the full simulation state in memory
+int    DLLEXPORT swmm_getStateSize(void);
+int    DLLEXPORT swmm_saveState(char* buffer, int size, double* stateDate);
+int    DLLEXPORT swmm_loadState(const char* buffer, int size);
+
 #ifdef __cplusplus 
 }   // matches the linkage specification from above */ 
 #endif
@@ -0,0 +1,164 @@
+//-----------------------------------------------------------------------------
+//   GSswmmOut.cpp
+//   Command-line extractor for SWMM binary output files (model.out)
+//-----------------------------------------------------------------------------
+//
+//   Pulls time series out of the model.out a bridge run leaves behind, so
+//   SWMM's own results can be compared with what the bridge passed to
+//   GoldSim without opening the .rpt file or a GUI.
+//
+//   Usage:
+//     GSswmmOut <model.out> --list
+//     GSswmmOut <model.out> --series TYPE:NAME:VARIABLE [--series ...]
+//               [--stats] [--csv <file>] [--threads N]
+//
+//   TYPE is SUBCATCH, NODE, LINK or SYSTEM, or a bridge object type such as
+//   OUTFALL or PUMP. VARIABLE is a SWMM reporting variable (TOTAL_INFLOW,
+//   FLOW, RUNOFF, ...), a bridge property name (INFLOW, LATFLOW, OVERFLOW) or
+//   a pollutant name. SYSTEM series take no NAME: SYSTEM::RUNOFF.
+//
+//   Without --stats the series are written as CSV (period, SWMM date, one
+//   column per series) to --csv or stdout. With --stats one line per series
+//   gives count, min, max (and its period), mean and the time integral
+//   (value summed over periods times the report step in seconds).
+//-----------------------------------------------------------------------------
+
+#include "../include/SwmmOutReader.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Options {
+    std::string out_file, csv_file;
+    std::vector<std::string> series;
+    bool list, stats;
+    int threads;
+};
+
+static void Usage() {
+    fprintf(stderr,
+            "Usage: GSswmmOut <model.out> --list\n"
+            "       GSswmmOut <model.out> --series TYPE:NAME:VARIABLE [--series ...]\n"
+            "                 [--stats] [--csv <file>] [--threads N]\n");
+}
+
+static bool ParseArgs(int argc, char** argv, Options& opt) {
+    opt.list = opt.stats = false;
+    opt.threads = (int)std::thread::hardware_concurrency();
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        if (a == "--list") opt.list = true;
+        else if (a == "--stats") opt.stats = true;
+        else if (a == "--series" && has_value) opt.series.push_back(argv[++i]);
+        else if (a == "--csv" && has_value) opt.csv_file = argv[++i];
+        else if (a == "--threads" && has_value) opt.threads = atoi(argv[++i]);
+        else if (a[0] != '-' && opt.out_file.empty()) opt.out_file = a;
+        else {
+            fprintf(stderr, "Unknown or incomplete argument: %s\n", a.c_str());
+            return false;
+        }
+    }
+    return !opt.out_file.empty() && (opt.list || !opt.series.empty());
+}
+
+static void List(const SwmmOutReader& out) {
+    printf("SWMM version %d, %d periods every %d s, start date %.6f\n",
+           out.GetVersion(), out.GetPeriodCount(), out.GetReportStep(), out.GetStartDate());
+    for (int t = 0; t < OUT_TYPE_COUNT; t++) {
+        printf("%s: %d reported, variables:", SwmmOutReader::TypeName(t), t == OUT_SYSTEM ? 1 : out.GetCount(t));
+        for (int v = 0; v < out.GetVariableCount(t); v++) printf(" %s", out.GetVariableName(t, v).c_str());
+        printf("\n");
+        if (t == OUT_SYSTEM) continue;
+        for (int i = 0; i < out.GetCount(t); i++) printf("  %s\n", out.GetName(t, i).c_str());
+    }
+}
+
+// TYPE:NAME:VARIABLE -> request, or an error message
+static bool Resolve(const SwmmOutReader& out, const std::string& spec, SwmmOutReader::Request& r,
+                    std::string& error) {
+    size_t a = spec.find(':');
+    size_t b = spec.rfind(':');
+    if (a == std::string::npos || a == b) {
+        error = "Expected TYPE:NAME:VARIABLE, got " + spec;
+        return false;
+    }
+    std::string name = spec.substr(a + 1, b - a - 1);
+    r.type = SwmmOutReader::TypeFromName(spec.substr(0, a));
+    if (r.type < 0) {
+        error = "Unknown object type in " + spec;
+        return false;
+    }
+    r.index = out.FindElement(r.type, name);
+    if (r.index < 0) {
+        error = "Element not in the output file: " + spec + " (not reported, or check output_policy)";
+        return false;
+    }
+    r.variable = out.FindVariable(r.type, spec.substr(b + 1));
+    if (r.variable < 0) {
+        error = "Unknown variable in " + spec;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage();
+        return 1;
+    }
+
+    SwmmOutReader out;
+    std::string error;
+    if (!out.Open(opt.out_file.c_str(), error)) {
+        fprintf(stderr, "ERROR: %s\n", error.c_str());
+        return 1;
+    }
+    if (opt.list) {
+        List(out);
+        if (opt.series.empty()) return 0;
+    }
+
+    std::vector<SwmmOutReader::Request> requests(opt.series.size());
+    for (size_t i = 0; i < opt.series.size(); i++) {
+        if (!Resolve(out, opt.series[i], requests[i], error)) {
+            fprintf(stderr, "ERROR: %s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    if (opt.stats) {
+        // Statistics read the mapping in place; nothing is copied
+        printf("series,count,min,max,max_period,mean,integral\n");
+        for (size_t i = 0; i < requests.size(); i++) {
+            SwmmOutReader::Series s;
+            out.GetSeries(requests[i].type, requests[i].index, requests[i].variable, s);
+            SwmmOutReader::Stats st = SwmmOutReader::Summarize(s, out.GetReportStep());
+            printf("%s,%d,%.6g,%.6g,%d,%.6g,%.6g\n", opt.series[i].c_str(), st.count, st.min, st.max,
+                   st.argmax, st.mean, st.integral);
+        }
+        return 0;
+    }
+
+    std::vector<std::vector<float>> values;
+    out.Extract(requests, values, opt.threads);
+
+    FILE* f = stdout;
+    if (!opt.csv_file.empty() && !(f = fopen(opt.csv_file.c_str(), "w"))) {
+        fprintf(stderr, "ERROR: Cannot write %s\n", opt.csv_file.c_str());
+        return 1;
+    }
+    fprintf(f, "period,date");
+    for (const std::string& s : opt.series) fprintf(f, ",%s", s.c_str());
+    fprintf(f, "\n");
+    for (int p = 0; p < out.GetPeriodCount(); p++) {
+        fprintf(f, "%d,%.8f", p, out.GetPeriodDate(p));
+        for (const std::vector<float>& v : values) fprintf(f, ",%.7g", v[p]);
+        fprintf(f, "\n");
+    }
+    if (f != stdout) fclose(f);
+    return 0;
+}
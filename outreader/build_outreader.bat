@@ -0,0 +1,21 @@
+@echo off
+echo Building GSswmm output extractor...
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+REM Standalone: reads model.out directly, no GSswmm.dll or swmm5.dll needed
+cl /EHsc /W3 /O2 /MD /I.. /Fe:GSswmmOut.exe GSswmmOut.cpp ..\SwmmOutReader.cpp ..\MappedFile.cpp
+if errorlevel 1 (
+    echo ERROR: Compilation failed
+    exit /b 1
+)
+
+echo.
+echo Built GSswmmOut.exe
+echo   GSswmmOut.exe model.out --list
+echo   GSswmmOut.exe model.out --series OUTFALL:OUT1:FLOW --stats
+exit /b 0
@@ -0,0 +1,261 @@
+//-----------------------------------------------------------------------------
+//   GSswmmReplay.cpp
+//   Headless replay of a recorded GoldSim call sequence
+//-----------------------------------------------------------------------------
+//
+//   Replays a call trace written by the bridge ("call_trace" in
+//   SwmmGoldSimBridge.json) against a bridge library, as fast as it will
+//   go and without GoldSim. Every call gets the inargs GoldSim passed; the
+//   status, the outputs and any error message are checked bit-for-bit
+//   against the recording. A production run thereby becomes a reproducible
+//   benchmark and regression test, against the real engine or the mock,
+//   depending on which build of the bridge --dll names.
+//
+//   Usage:
+//     GSswmmReplay --trace <file> [--model-dir <dir>] [--dll <bridge library>]
+//                  [--repeat N] [--no-check] [--max-mismatches M]
+//
+//   The model directory (default: the current one) needs the model.inp and
+//   SwmmGoldSimBridge.json the trace was recorded with; a warning is printed
+//   if either has changed, since outputs are then unlikely to match. The
+//   mapping may keep "call_trace", but not pointing at the trace being
+//   replayed. --repeat runs the whole sequence N times in one process.
+//-----------------------------------------------------------------------------
+
+#include "../include/Platform.h"
+#include "../include/CallTrace.h"
+#include "../include/MappingLoader.h"
+#include "../include/PlanCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <direct.h>
+#define chdir _chdir
+#else
+#include <climits>
+#include <unistd.h>
+#endif
+
+#define XF_INITIALIZE   0
+#define XF_CALCULATE    1
+#define XF_REP_VERSION  2
+#define XF_REP_ARGUMENTS 3
+#define XF_CLEANUP      99
+#define XF_SUCCESS      0
+#define XF_FAILURE_WITH_MSG -1
+
+#define CONFIG_FILE "SwmmGoldSimBridge.json"
+#define MODEL_FILE "model.inp"
+
+#ifdef _WIN32
+#define DEFAULT_BRIDGE "GSswmm.dll"
+#else
+#define DEFAULT_BRIDGE "libgsswmm.so"
+#endif
+
+typedef void (*BridgeFunction)(int, int*, double*, double*);
+
+struct Options {
+    std::string trace, model_dir, dll;
+    int repeat;
+    bool check;
+    int max_mismatches;
+    Options() : dll(DEFAULT_BRIDGE), repeat(1), check(true), max_mismatches(10) {}
+};
+
+// Calls and time per XF_* method
+struct MethodStats {
+    const char* name;
+    int method;
+    long long calls;
+    double seconds;
+};
+
+static bool FileExists(const std::string& path) {
+    FILE* f = NULL;
+    if (fopen_s(&f, path.c_str(), "rb") != 0 || !f) return false;
+    fclose(f);
+    return true;
+}
+
+// Absolute path of an existing file, so it survives the chdir to the model directory
+static std::string FullPath(const std::string& path) {
+    if (!FileExists(path)) return path;
+#ifdef _WIN32
+    char buf[MAX_PATH];
+    return _fullpath(buf, path.c_str(), MAX_PATH) ? std::string(buf) : path;
+#else
+    char buf[PATH_MAX];
+    return realpath(path.c_str(), buf) ? std::string(buf) : path;
+#endif
+}
+
+static const char* MethodName(int method) {
+    switch (method) {
+    case XF_INITIALIZE: return "XF_INITIALIZE";
+    case XF_CALCULATE: return "XF_CALCULATE";
+    case XF_REP_VERSION: return "XF_REP_VERSION";
+    case XF_REP_ARGUMENTS: return "XF_REP_ARGUMENTS";
+    case XF_CLEANUP: return "XF_CLEANUP";
+    default: return "unknown";
+    }
+}
+
+/**
+ * @brief Compare a replayed call with its recording
+ * @return "" if they match, otherwise what differs
+ */
+static std::string Compare(const CallTraceReader::Call& c, int status, const double* outargs) {
+    char buf[256];
+    if (status != c.status) {
+        snprintf(buf, sizeof(buf), "status %d, recorded %d", status, c.status);
+        return buf;
+    }
+    if (status == XF_FAILURE_WITH_MSG) {
+        std::string message = *(const char**)outargs, recorded(c.message, (size_t)c.message_size);
+        return message == recorded ? "" : "message \"" + message + "\", recorded \"" + recorded + "\"";
+    }
+    if (memcmp(outargs, c.outargs, (size_t)c.outputs * sizeof(double)) == 0) return "";
+    int first = 0, count = 0;
+    for (int i = c.outputs - 1; i >= 0; i--) {
+        if (memcmp(&outargs[i], &c.outargs[i], sizeof(double)) != 0) {
+            first = i;
+            count++;
+        }
+    }
+    snprintf(buf, sizeof(buf), "%d of %d outputs differ, first is output %d: %.17g, recorded %.17g", count,
+             c.outputs, first, outargs[first], c.outargs[first]);
+    return buf;
+}
+
+static int Run(Options& opt) {
+    opt.trace = FullPath(opt.trace);
+    opt.dll = FullPath(opt.dll);
+    CallTraceReader trace;
+    std::string error;
+    if (!trace.Open(opt.trace.c_str(), error)) { fprintf(stderr, "%s\n", error.c_str()); return 1; }
+    const CallTraceHeader& h = trace.GetHeader();
+    if (trace.IsTruncated()) printf("Warning: the trace ends inside a call; replaying the complete calls\n");
+    if (trace.GetCallCount() == 0) { fprintf(stderr, "%s holds no calls\n", opt.trace.c_str()); return 1; }
+
+    // The bridge uses paths relative to the model directory
+    if (!opt.model_dir.empty() && chdir(opt.model_dir.c_str()) != 0) {
+        fprintf(stderr, "Cannot enter %s\n", opt.model_dir.c_str());
+        return 1;
+    }
+    uint64_t config_hash, model_hash;
+    if (!PlanCache::HashFile(CONFIG_FILE, config_hash) || !PlanCache::HashFile(MODEL_FILE, model_hash)) {
+        fprintf(stderr, "Cannot read " CONFIG_FILE " and " MODEL_FILE " in the model directory\n");
+        return 1;
+    }
+    if (config_hash != h.config_hash) printf("Warning: " CONFIG_FILE " differs from the one recorded\n");
+    if (model_hash != h.model_hash) printf("Warning: " MODEL_FILE " differs from the one recorded\n");
+    MappingLoader mapping;
+    if (!mapping.LoadFromFile(CONFIG_FILE, error)) { fprintf(stderr, "%s\n", error.c_str()); return 1; }
+    if (!mapping.GetCallTrace().empty()) {
+        if (FullPath(mapping.GetCallTrace()) == opt.trace) {
+            fprintf(stderr, "The mapping records its calls to %s, the trace being replayed; copy the trace "
+                            "elsewhere or remove \"call_trace\"\n", opt.trace.c_str());
+            return 1;
+        }
+        printf("Note: the bridge also records this replay to %s\n", mapping.GetCallTrace().c_str());
+    }
+
+    HMODULE dll = LoadLibraryA(opt.dll.c_str());
+    BridgeFunction bridge = dll ? (BridgeFunction)GetProcAddress(dll, "SwmmGoldSimBridge") : NULL;
+    if (!bridge) { fprintf(stderr, "Cannot load SwmmGoldSimBridge from %s\n", opt.dll.c_str()); return 1; }
+
+    // GoldSim sizes the argument arrays from XF_REP_ARGUMENTS
+    int ninputs = h.input_count, noutputs = std::max(h.output_count, 2);
+    for (size_t i = 0; i < trace.GetCallCount(); i++) {
+        ninputs = std::max(ninputs, trace.GetCall(i).inputs);
+        noutputs = std::max(noutputs, trace.GetCall(i).outputs);
+    }
+    std::vector<double> inargs((size_t)std::max(ninputs, 1), 0.0), outargs((size_t)noutputs, 0.0);
+
+    MethodStats stats[] = {
+        { "XF_REP_VERSION", XF_REP_VERSION, 0, 0.0 },
+        { "XF_REP_ARGUMENTS", XF_REP_ARGUMENTS, 0, 0.0 },
+        { "XF_INITIALIZE", XF_INITIALIZE, 0, 0.0 },
+        { "XF_CALCULATE", XF_CALCULATE, 0, 0.0 },
+        { "XF_CLEANUP", XF_CLEANUP, 0, 0.0 },
+    };
+    const int nstats = (int)(sizeof(stats) / sizeof(stats[0]));
+    long long mismatches = 0, realizations = 0;
+
+    printf("GSswmm replay: %zu calls (%d inputs, %d outputs) from %s, %d pass%s, %s\n", trace.GetCallCount(),
+           h.input_count, h.output_count, opt.trace.c_str(), opt.repeat, opt.repeat == 1 ? "" : "es", opt.dll.c_str());
+    auto t0 = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < opt.repeat; pass++) {
+        for (size_t i = 0; i < trace.GetCallCount(); i++) {
+            const CallTraceReader::Call& c = trace.GetCall(i);
+            std::copy(c.inargs, c.inargs + c.inputs, inargs.begin());
+            int status;
+            auto c0 = std::chrono::steady_clock::now();
+            bridge(c.method, &status, inargs.data(), outargs.data());
+            auto c1 = std::chrono::steady_clock::now();
+            for (int k = 0; k < nstats; k++) {
+                if (stats[k].method != c.method) continue;
+                stats[k].calls++;
+                stats[k].seconds += std::chrono::duration<double>(c1 - c0).count();
+            }
+            if (c.method == XF_INITIALIZE && status == XF_SUCCESS) realizations++;
+            if (!opt.check) continue;
+            std::string diff = Compare(c, status, outargs.data());
+            if (diff.empty()) continue;
+            if (++mismatches <= opt.max_mismatches)
+                printf("Mismatch: pass %d, call %zu (%s): %s\n", pass + 1, i, MethodName(c.method), diff.c_str());
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    printf("\n%-18s %10s %12s %12s\n", "method", "calls", "total s", "mean us");
+    for (int k = 0; k < nstats; k++) {
+        if (stats[k].calls == 0) continue;
+        printf("%-18s %10lld %12.4f %12.2f\n", stats[k].name, stats[k].calls, stats[k].seconds,
+               stats[k].seconds * 1e6 / stats[k].calls);
+    }
+    long long calls = (long long)trace.GetCallCount() * opt.repeat;
+    printf("\nWall time: %.3f s for %lld calls\n", seconds, calls);
+    if (seconds > 0.0)
+        printf("Throughput: %.0f calls/s, %.0f XF_CALCULATE/s, %.2f realizations/s\n", calls / seconds,
+               stats[3].calls / seconds, realizations / seconds);
+    if (!opt.check) {
+        printf("Outputs not checked (--no-check)\n");
+        return 0;
+    }
+    if (mismatches == 0) {
+        printf("All %lld calls matched the recording bit-for-bit\n", calls);
+        return 0;
+    }
+    printf("%lld of %lld calls differ from the recording%s\n", mismatches, calls,
+           mismatches > opt.max_mismatches ? " (first ones listed)" : "");
+    return 1;
+}
+
+static void Usage() {
+    printf("Usage: GSswmmReplay --trace <file> [--model-dir <dir>] [--dll <bridge library>]\n"
+           "                    [--repeat N] [--no-check] [--max-mismatches M]\n");
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        if (a == "--trace" && has_value) opt.trace = argv[++i];
+        else if (a == "--model-dir" && has_value) opt.model_dir = argv[++i];
+        else if (a == "--dll" && has_value) opt.dll = argv[++i];
+        else if (a == "--repeat" && has_value) opt.repeat = atoi(argv[++i]);
+        else if (a == "--max-mismatches" && has_value) opt.max_mismatches = atoi(argv[++i]);
+        else if (a == "--no-check") opt.check = false;
+        else { Usage(); return 1; }
+    }
+    if (opt.trace.empty() || opt.repeat < 1) { Usage(); return 1; }
+    return Run(opt);
+}
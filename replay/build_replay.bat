@@ -0,0 +1,21 @@
+@echo off
+echo Building GSswmm call trace replay...
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+REM The replay loads GSswmm.dll at run time (--dll); it links the trace reader and mapping loader
+cl /EHsc /W3 /O2 /MD /I.. /Fe:GSswmmReplay.exe GSswmmReplay.cpp ..\CallTrace.cpp ..\MappedFile.cpp ..\PlanCache.cpp ..\MappingLoader.cpp
+if errorlevel 1 (
+    echo ERROR: Compilation failed
+    exit /b 1
+)
+
+echo.
+echo Built GSswmmReplay.exe
+echo Copy GSswmm.dll and swmm5.dll next to it, then run:
+echo   GSswmmReplay.exe --trace ^<file^> --model-dir ^<dir^> [--repeat N] [--no-check]
+exit /b 0
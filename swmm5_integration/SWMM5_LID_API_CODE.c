@@ -7,6 +7,42 @@
 // LID API Extensions
 //=============================================================================
 
+/**
+ * @brief Total water stored in all layers of an LID unit
+ * @param lidUnit Pointer to the LID unit
+ * @return Storage volume in cubic feet (or cubic meters)
+ * @note Shared by swmm_getLidUStorageVolume() and swmm_getLidUStates()
+ */
+static double lidUnitStorageVolume(TLidUnit* lidUnit)
+{
+    double volume = 0.0;
+    double area = lidUnit->area * lidUnit->number;  // Total LID area
+    TLidProc* lidProc = &LidProcs[lidUnit->lidIndex];
+    
+    // Surface layer storage
+    if (lidUnit->surfaceDepth > 0.0) {
+        volume += lidUnit->surfaceDepth * area;
+    }
+    
+    // Soil layer storage
+    if (lidUnit->soilMoisture > 0.0 && lidProc->soil.thickness > 0.0) {
+        volume += lidUnit->soilMoisture * lidProc->soil.thickness * 
+                  area * lidProc->soil.porosity;
+    }
+    
+    // Storage layer
+    if (lidUnit->storageDepth > 0.0 && lidProc->storage.thickness > 0.0) {
+        volume += lidUnit->storageDepth * area * lidProc->storage.voidFrac;
+    }
+    
+    // Pavement layer storage
+    if (lidUnit->paveDepth > 0.0 && lidProc->pavement.thickness > 0.0) {
+        volume += lidUnit->paveDepth * area * lidProc->pavement.voidFrac;
+    }
+    
+    return volume;
+}
+
 /**
  * @brief Get the number of LID units in a subcatchment
  * @param subcatchIndex Zero-based subcatchment index
@@ -91,44 +127,8 @@ double DLLEXPORT swmm_getLidUStorageVolume(int subcatchIndex, int lidIndex)
         return 0.0;
     }
     
-    // Get LID unit
-    TLidUnit* lidUnit = subcatch->lidList + lidIndex;
-    
-    // Calculate total storage volume from all layers
-    double volume = 0.0;
-    double area = lidUnit->area * lidUnit->number;  // Total LID area
-    
-    // Surface layer storage
-    if (lidUnit->surfaceDepth > 0.0) {
-        volume += lidUnit->surfaceDepth * area;
-    }
-    
-    // Soil layer storage
-    if (lidUnit->soilMoisture > 0.0) {
-        TLidProc* lidProc = &LidProcs[lidUnit->lidIndex];
-        if (lidProc->soil.thickness > 0.0) {
-            volume += lidUnit->soilMoisture * lidProc->soil.thickness * 
-                      area * lidProc->soil.porosity;
-        }
-    }
-    
-    // Storage layer
-    if (lidUnit->storageDepth > 0.0) {
-        TLidProc* lidProc = &LidProcs[lidUnit->lidIndex];
-        if (lidProc->storage.thickness > 0.0) {
-            volume += lidUnit->storageDepth * area * lidProc->storage.voidFrac;
-        }
-    }
-    
-    // Pavement layer storage
-    if (lidUnit->paveDepth > 0.0) {
-        TLidProc* lidProc = &LidProcs[lidUnit->lidIndex];
-        if (lidProc->pavement.thickness > 0.0) {
-            volume += lidUnit->paveDepth * area * lidProc->pavement.voidFrac;
-        }
-    }
-    
-    return volume;
+    // Return total storage volume from all layers
+    return lidUnitStorageVolume(subcatch->lidList + lidIndex);
 }
 
 /**
@@ -190,3 +190,121 @@ double DLLEXPORT swmm_getLidUSurfaceInflow(int subcatchIndex, int lidIndex)
     // This represents runoff entering the LID from the subcatchment
     return lidUnit->surfaceInflow;
 }
+
+/**
+ * @brief Get the current underdrain flow rate from an LID unit
+ * @param subcatchIndex Zero-based subcatchment index
+ * @param lidIndex Zero-based LID unit index
+ * @return Current underdrain flow rate in flow units (CFS or CMS)
+ */
+double DLLEXPORT swmm_getLidUDrainFlow(int subcatchIndex, int lidIndex)
+{
+    // Validate subcatchment index
+    if (subcatchIndex < 0 || subcatchIndex >= Nobjects[SUBCATCH]) {
+        report_writeErrorMsg(ERR_API_OBJECT_INDEX, "Subcatchment");
+        return 0.0;
+    }
+    
+    TSubcatch* subcatch = &Subcatch[subcatchIndex];
+    
+    // Validate LID index
+    if (lidIndex < 0 || lidIndex >= subcatch->lidCount) {
+        report_writeErrorMsg(ERR_API_OBJECT_INDEX, "LID Unit");
+        return 0.0;
+    }
+    
+    // Get LID unit
+    TLidUnit* lidUnit = subcatch->lidList + lidIndex;
+    
+    // Return drain flow computed for the current time step
+    return lidUnit->newDrainFlow;
+}
+
+//=============================================================================
+// Batched LID API
+//=============================================================================
+
+/**
+ * @brief Get the total number of LID units in the project
+ * @return Sum of lidCount over all subcatchments
+ */
+int DLLEXPORT swmm_getLidUTotalCount(void)
+{
+    int i, total = 0;
+    for (i = 0; i < Nobjects[SUBCATCH]; i++) {
+        total += Subcatch[i].lidCount;
+    }
+    return total;
+}
+
+/**
+ * @brief Get the state of many LID units in one call
+ * @param n Number of entries to fill
+ * @param subcatchIndex Zero-based subcatchment indices (n entries), or NULL
+ * @param lidIndex Zero-based LID unit indices (n entries), or NULL
+ * @param storageVolume Receives storage volume (see swmm_getLidUStorageVolume)
+ * @param surfaceInflow Receives surface inflow rate
+ * @param surfaceOutflow Receives surface overflow rate
+ * @param drainFlow Receives underdrain flow rate
+ * @param evapVolume Receives cumulative evaporation volume
+ * @param exfilVolume Receives cumulative exfiltration volume to native soil
+ * @return 0 on success, or ERR_API_OBJECT_INDEX if any pair was invalid
+ *
+ * Fills caller-provided structure-of-arrays buffers in a single pass.
+ * Any output buffer may be NULL to skip that quantity. When both index
+ * arrays are NULL, the first n units of the project are returned in
+ * subcatchment order, then LID unit order (use swmm_getLidUTotalCount()
+ * to size the buffers). Entries with invalid indices are set to 0.
+ * Evaporation and exfiltration come from the unit's water balance,
+ * which SWMM accumulates as depths over the unit area; infiltration
+ * into the soil layer is not tracked per unit and is not reported.
+ */
+int DLLEXPORT swmm_getLidUStates(int n, const int* subcatchIndex, const int* lidIndex,
+                                 double* storageVolume, double* surfaceInflow,
+                                 double* surfaceOutflow, double* drainFlow,
+                                 double* evapVolume, double* exfilVolume)
+{
+    int i, errcode = 0;
+    int allUnits = (subcatchIndex == NULL && lidIndex == NULL);
+    int s = 0, k = 0;
+    
+    if (n < 0 || (!allUnits && (subcatchIndex == NULL || lidIndex == NULL))) {
+        report_writeErrorMsg(ERR_API_OUTBOUNDS, "Buffer");
+        return ERR_API_OUTBOUNDS;
+    }
+    
+    for (i = 0; i < n; i++) {
+        TLidUnit* lidUnit = NULL;
+        
+        if (allUnits) {
+            // Advance to the next subcatchment that still has units left
+            while (s < Nobjects[SUBCATCH] && k >= Subcatch[s].lidCount) { s++; k = 0; }
+            if (s < Nobjects[SUBCATCH]) lidUnit = Subcatch[s].lidList + k++;
+        } else if (subcatchIndex[i] >= 0 && subcatchIndex[i] < Nobjects[SUBCATCH] &&
+                   lidIndex[i] >= 0 && lidIndex[i] < Subcatch[subcatchIndex[i]].lidCount) {
+            lidUnit = Subcatch[subcatchIndex[i]].lidList + lidIndex[i];
+        }
+        
+        if (lidUnit == NULL) {
+            errcode = ERR_API_OBJECT_INDEX;
+            if (storageVolume)  storageVolume[i] = 0.0;
+            if (surfaceInflow)  surfaceInflow[i] = 0.0;
+            if (surfaceOutflow) surfaceOutflow[i] = 0.0;
+            if (drainFlow)      drainFlow[i] = 0.0;
+            if (evapVolume)     evapVolume[i] = 0.0;
+            if (exfilVolume)    exfilVolume[i] = 0.0;
+            continue;
+        }
+        
+        double area = lidUnit->area * lidUnit->number;
+        if (storageVolume)  storageVolume[i] = lidUnitStorageVolume(lidUnit);
+        if (surfaceInflow)  surfaceInflow[i] = lidUnit->surfaceInflow;
+        if (surfaceOutflow) surfaceOutflow[i] = lidUnit->surfaceOutflow;
+        if (drainFlow)      drainFlow[i] = lidUnit->newDrainFlow;
+        if (evapVolume)     evapVolume[i] = lidUnit->waterBalance.evap * area;
+        if (exfilVolume)    exfilVolume[i] = lidUnit->waterBalance.infil * area;
+    }
+    
+    if (errcode) report_writeErrorMsg(errcode, "LID Unit");
+    return errcode;
+}
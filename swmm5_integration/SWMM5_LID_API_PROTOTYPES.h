@@ -10,3 +10,11 @@ void   DLLEXPORT swmm_getLidUName(int subcatchIndex, int lidIndex, char* name, i
 double DLLEXPORT swmm_getLidUStorageVolume(int subcatchIndex, int lidIndex);
 double DLLEXPORT swmm_getLidUSurfaceOutflow(int subcatchIndex, int lidIndex);
 double DLLEXPORT swmm_getLidUSurfaceInflow(int subcatchIndex, int lidIndex);
+double DLLEXPORT swmm_getLidUDrainFlow(int subcatchIndex, int lidIndex);
+
+// Batched LID API - one call for many units (structure-of-arrays buffers)
+int    DLLEXPORT swmm_getLidUTotalCount(void);
+int    DLLEXPORT swmm_getLidUStates(int n, const int* subcatchIndex, const int* lidIndex,
+                                    double* storageVolume, double* surfaceInflow,
+                                    double* surfaceOutflow, double* drainFlow,
+                                    double* evapVolume, double* exfilVolume);
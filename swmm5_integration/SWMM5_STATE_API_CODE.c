@@ -0,0 +1,242 @@
+// =============================================================================
+// ADD THIS CODE TO: SWMM5-source/src/hotstart.c
+// Location: At the end of the file
+// =============================================================================
+
+//=============================================================================
+// In-Memory State Snapshot API Extensions
+//=============================================================================
+//
+// Captures the full simulation state into a caller-owned memory buffer and
+// restores it later, so Monte Carlo realizations can skip a spin-up period.
+// The runoff and routing state is written with this file's own hot start
+// routines (saveRunoff/saveRouting, readRunoff/readRouting), so it covers
+// everything a SAVE HOTSTART file covers. LID unit state is not part of the
+// hot start file format and is appended separately.
+//
+// The hot start routines work on a FILE*, so the state passes through an
+// anonymous tmpfile() that is deleted when closed. The snapshot itself lives
+// only in the caller's buffer.
+
+#define STATE_MAGIC "GSSTATE1"   // 8 bytes including the terminator
+
+typedef struct
+{
+    char   magic[8];
+    double stateDate;            // simulation date/time the state belongs to
+    int    hotstartBytes;        // size of the hot start block that follows
+    int    lidUnitCount;         // number of LID unit records after it
+}  TStateHeader;
+
+typedef struct
+{
+    double surfaceDepth;
+    double paveDepth;
+    double soilMoisture;
+    double storageDepth;
+    double dryTime;
+    double oldFluxRates[MAX_LAYERS];
+    double oldDrainFlow;
+    double newDrainFlow;
+    TWaterBalance waterBalance;
+}  TLidUnitState;
+
+/**
+ * @brief Number of LID units in the project
+ */
+static int stateLidUnitCount(void)
+{
+    int i, n = 0;
+    for (i = 0; i < Nobjects[SUBCATCH]; i++) n += Subcatch[i].lidCount;
+    return n;
+}
+
+/**
+ * @brief Write the current runoff and routing state to a temporary file
+ * @return Open temporary file positioned at its end, or NULL on error
+ */
+static FILE* stateWriteHotstart(void)
+{
+    FILE* saved = Fhotstart2.file;
+    FILE* f = tmpfile();
+    if (f == NULL) return NULL;
+    Fhotstart2.file = f;
+    saveRunoff();
+    saveRouting();
+    Fhotstart2.file = saved;
+    return f;
+}
+
+/**
+ * @brief Get the buffer size needed by swmm_saveState()
+ * @return Size in bytes, or -1 if no simulation is running
+ * @note The size only depends on the project, so it can be computed once
+ */
+int DLLEXPORT swmm_getStateSize(void)
+{
+    FILE* f;
+    long hotstartBytes;
+
+    if (!IsStartedFlag) {
+        report_writeErrorMsg(ERR_API_NOT_STARTED, "");
+        return -1;
+    }
+    f = stateWriteHotstart();
+    if (f == NULL) return -1;
+    hotstartBytes = ftell(f);
+    fclose(f);
+    return (int)(sizeof(TStateHeader) + hotstartBytes +
+                 stateLidUnitCount() * sizeof(TLidUnitState));
+}
+
+/**
+ * @brief Save the full simulation state to a memory buffer
+ * @param buffer Buffer receiving the state
+ * @param size Size of buffer in bytes (see swmm_getStateSize())
+ * @param stateDate Receives the simulation date/time of the state (may be NULL)
+ * @return Number of bytes written (> 0), or a negative value on error
+ */
+int DLLEXPORT swmm_saveState(char* buffer, int size, double* stateDate)
+{
+    TStateHeader header;
+    FILE* f;
+    long hotstartBytes;
+    int i, k, total;
+    char* p;
+
+    if (!IsStartedFlag) {
+        report_writeErrorMsg(ERR_API_NOT_STARTED, "");
+        return -1;
+    }
+    if (buffer == NULL || size <= 0) {
+        report_writeErrorMsg(ERR_API_OUTBOUNDS, "Buffer");
+        return -1;
+    }
+
+    // Runoff and routing state via the hot start writer
+    f = stateWriteHotstart();
+    if (f == NULL) return -1;
+    hotstartBytes = ftell(f);
+    total = (int)(sizeof(TStateHeader) + hotstartBytes +
+                  stateLidUnitCount() * sizeof(TLidUnitState));
+    if (total > size) {
+        fclose(f);
+        report_writeErrorMsg(ERR_API_OUTBOUNDS, "Buffer");
+        return -1;
+    }
+
+    memcpy(header.magic, STATE_MAGIC, sizeof(header.magic));
+    header.stateDate = getDateTime(NewRoutingTime);
+    header.hotstartBytes = (int)hotstartBytes;
+    header.lidUnitCount = stateLidUnitCount();
+    memcpy(buffer, &header, sizeof(header));
+    p = buffer + sizeof(header);
+
+    rewind(f);
+    if (fread(p, 1, hotstartBytes, f) != (size_t)hotstartBytes) {
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+    p += hotstartBytes;
+
+    // LID unit state, in subcatchment order
+    for (i = 0; i < Nobjects[SUBCATCH]; i++) {
+        for (k = 0; k < Subcatch[i].lidCount; k++) {
+            TLidUnit* lidUnit = Subcatch[i].lidList + k;
+            TLidUnitState s;
+            s.surfaceDepth = lidUnit->surfaceDepth;
+            s.paveDepth = lidUnit->paveDepth;
+            s.soilMoisture = lidUnit->soilMoisture;
+            s.storageDepth = lidUnit->storageDepth;
+            s.dryTime = lidUnit->dryTime;
+            memcpy(s.oldFluxRates, lidUnit->oldFluxRates, sizeof(s.oldFluxRates));
+            s.oldDrainFlow = lidUnit->oldDrainFlow;
+            s.newDrainFlow = lidUnit->newDrainFlow;
+            s.waterBalance = lidUnit->waterBalance;
+            memcpy(p, &s, sizeof(s));
+            p += sizeof(s);
+        }
+    }
+
+    if (stateDate) *stateDate = header.stateDate;
+    return total;
+}
+
+/**
+ * @brief Restore a state saved by swmm_saveState()
+ * @param buffer State buffer
+ * @param size Size of the state in bytes
+ * @return 0 on success, or an error code
+ * @note Call after swmm_start() and before the first swmm_step(). To continue
+ *       from the snapshot time, set swmm_STARTDATE to the saved stateDate
+ *       before swmm_start() so rain gages and time series start there too.
+ *       The project must be the same one the state was saved from.
+ */
+int DLLEXPORT swmm_loadState(const char* buffer, int size)
+{
+    TStateHeader header;
+    FILE* saved;
+    FILE* f;
+    const char* p;
+    int i, k;
+
+    if (!IsStartedFlag) {
+        report_writeErrorMsg(ERR_API_NOT_STARTED, "");
+        return ERR_API_NOT_STARTED;
+    }
+    if (buffer == NULL || size < (int)sizeof(header)) {
+        report_writeErrorMsg(ERR_API_OUTBOUNDS, "Buffer");
+        return ERR_API_OUTBOUNDS;
+    }
+    memcpy(&header, buffer, sizeof(header));
+    if (memcmp(header.magic, STATE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.lidUnitCount != stateLidUnitCount() ||
+        size < (int)(sizeof(header) + header.hotstartBytes +
+                     header.lidUnitCount * sizeof(TLidUnitState))) {
+        report_writeErrorMsg(ERR_HOTSTART_FILE_FORMAT, "");
+        return ERR_HOTSTART_FILE_FORMAT;
+    }
+    p = buffer + sizeof(header);
+
+    // Runoff and routing state via the hot start reader
+    f = tmpfile();
+    if (f == NULL) {
+        report_writeErrorMsg(ERR_HOTSTART_FILE_OPEN, "");
+        return ERR_HOTSTART_FILE_OPEN;
+    }
+    fwrite(p, 1, header.hotstartBytes, f);
+    rewind(f);
+    saved = Fhotstart1.file;
+    Fhotstart1.file = f;
+    fileVersion = 4;
+    if (!readRunoff() || !readRouting()) {
+        Fhotstart1.file = saved;
+        fclose(f);
+        report_writeErrorMsg(ERR_HOTSTART_FILE_READ, "");
+        return ERR_HOTSTART_FILE_READ;
+    }
+    Fhotstart1.file = saved;
+    fclose(f);
+    p += header.hotstartBytes;
+
+    // LID unit state
+    for (i = 0; i < Nobjects[SUBCATCH]; i++) {
+        for (k = 0; k < Subcatch[i].lidCount; k++) {
+            TLidUnit* lidUnit = Subcatch[i].lidList + k;
+            TLidUnitState s;
+            memcpy(&s, p, sizeof(s));
+            p += sizeof(s);
+            lidUnit->surfaceDepth = s.surfaceDepth;
+            lidUnit->paveDepth = s.paveDepth;
+            lidUnit->soilMoisture = s.soilMoisture;
+            lidUnit->storageDepth = s.storageDepth;
+            lidUnit->dryTime = s.dryTime;
+            memcpy(lidUnit->oldFluxRates, s.oldFluxRates, sizeof(s.oldFluxRates));
+            lidUnit->oldDrainFlow = s.oldDrainFlow;
+            lidUnit->newDrainFlow = s.newDrainFlow;
+            lidUnit->waterBalance = s.waterBalance;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+// =============================================================================
+// ADD THIS CODE TO: SWMM5-source/src/swmm5.c
+// Location: After swmm_setValue()
+// =============================================================================
+
+//=============================================================================
+// Vectorized Value API Extensions
+//=============================================================================
+
+/**
+ * @brief Get many property values in one call
+ * @param props Property codes (n entries), as for swmm_getValue()
+ * @param indexes Object indexes (n entries), as for swmm_getValue()
+ * @param n Number of values to get
+ * @param values Buffer receiving n values
+ * @return 0 on success, or ERR_API_OUTBOUNDS for invalid buffers
+ * @note Entry i receives swmm_getValue(props[i], indexes[i]); one DLL call
+ *       replaces n calls across the DLL boundary
+ */
+int DLLEXPORT swmm_getValues(const int* props, const int* indexes, int n, double* values)
+{
+    int i;
+    
+    // Validate parameters
+    if (n < 0 || (n > 0 && (!props || !indexes || !values))) {
+        return ERR_API_OUTBOUNDS;
+    }
+    
+    for (i = 0; i < n; i++) {
+        values[i] = swmm_getValue(props[i], indexes[i]);
+    }
+    return 0;
+}
+
+/**
+ * @brief Set many property values in one call
+ * @param props Property codes (n entries), as for swmm_setValue()
+ * @param indexes Object indexes (n entries), as for swmm_setValue()
+ * @param n Number of values to set
+ * @param values Values to set (n entries)
+ * @return 0 on success, or ERR_API_OUTBOUNDS for invalid buffers
+ * @note Entries are applied in order, so a later entry for the same
+ *       property and object overrides an earlier one
+ */
+int DLLEXPORT swmm_setValues(const int* props, const int* indexes, int n, const double* values)
+{
+    int i;
+    
+    // Validate parameters
+    if (n < 0 || (n > 0 && (!props || !indexes || !values))) {
+        return ERR_API_OUTBOUNDS;
+    }
+    
+    for (i = 0; i < n; i++) {
+        swmm_setValue(props[i], indexes[i], values[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,248 @@
+//-----------------------------------------------------------------------------
+//   bench_bridge_overhead.cpp
+//
+//   Benchmark: bridge overhead per GoldSim call, driving SwmmGoldSimBridge
+//   through the protocol against the SWMM mock and LID API stub
+//
+//   Each scenario writes its own mapping and model.inp, then times one cold
+//   realization (mapping load and name resolution) and a few warm ones.
+//   Scenarios sweep the output count, the input count, the share of LID
+//   outputs and the logging level. The mock does no hydraulics, so every
+//   nanosecond reported is the bridge's own. Heap allocations are counted by
+//   replacing the global operator new, which works because the bridge is
+//   linked into this executable (or, on Linux, interposed into libgsswmm.so).
+//
+//   Usage: bench_bridge_overhead [output_steps]
+//     output_steps  outputs x steps timed per scenario (default 2000000)
+//-----------------------------------------------------------------------------
+
+#include "../include/Platform.h"
+#include "../include/swmm5.h"
+#include "swmm_mock.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#define XF_INITIALIZE       0
+#define XF_CALCULATE        1
+#define XF_REP_ARGUMENTS    3
+#define XF_CLEANUP          99
+
+extern "C" void SwmmGoldSimBridge(int methodID, int* status, double* inargs, double* outargs);
+
+//=============================================================================
+// Allocation counting
+//=============================================================================
+
+static std::atomic<long long> g_allocs(0);
+static std::atomic<long long> g_alloc_bytes(0);
+
+void* operator new(size_t size) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    g_alloc_bytes.fetch_add((long long)size, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+struct AllocCount {
+    long long count, bytes;
+    static AllocCount Now() { return { g_allocs.load(), g_alloc_bytes.load() }; }
+    AllocCount operator-(const AllocCount& o) const { return { count - o.count, bytes - o.bytes }; }
+};
+
+//=============================================================================
+// Fixture
+//=============================================================================
+
+struct Scenario {
+    const char* sweep;
+    int inputs;          // including ElapsedTime
+    int outputs;
+    int lid_percent;     // share of outputs read from LID units
+    const char* log_level;
+};
+
+struct Result {
+    double cold_init_us, warm_init_us, cleanup_us;
+    double calc_ns, calc_ns_per_output;
+    double init_allocs, calc_allocs, calc_bytes, cleanup_allocs;
+};
+
+static double Us(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+    return std::chrono::duration<double, std::micro>(b - a).count();
+}
+
+class BridgeFixture {
+public:
+    explicit BridgeFixture(const Scenario& s) : s_(s) {}
+
+    // Mapping, model.inp and mock objects for the scenario
+    void SetUp(int id) {
+        std::string json = std::string("{\"version\": \"1.0\", \"logging_level\": \"") + s_.log_level +
+                           "\", \"plan_cache\": false,\n \"inputs\": [\n"
+                           "  {\"index\": 0, \"name\": \"ElapsedTime\", \"object_type\": \"SYSTEM\", \"property\": \"ELAPSEDTIME\"}";
+        for (int i = 1; i < s_.inputs; i++)
+            json += ",\n  {\"index\": " + std::to_string(i) + ", \"name\": \"RG" + std::to_string(i) +
+                    "\", \"object_type\": \"GAGE\", \"property\": \"RAINFALL\"}";
+        json += "],\n \"outputs\": [\n";
+        for (int i = 0; i < s_.outputs; i++) {
+            if (IsLid(i))
+                json += "  {\"index\": " + std::to_string(i) + ", \"name\": \"S" + std::to_string(i) +
+                        "/BioRetention\", \"object_type\": \"LID\", \"property\": \"STORAGE_VOLUME\"}";
+            else
+                json += "  {\"index\": " + std::to_string(i) + ", \"name\": \"S" + std::to_string(i) +
+                        "\", \"object_type\": \"SUBCATCH\", \"property\": \"RUNOFF\"}";
+            json += (i + 1 < s_.outputs) ? ",\n" : "\n";
+        }
+        json += "]}\n";
+        std::ofstream("SwmmGoldSimBridge.json", std::ios::binary) << json;
+        // A new model.inp hash makes the bridge reload the mapping and resolve again
+        std::ofstream("model.inp", std::ios::binary) << "[TITLE]\nBridge overhead scenario " << id << "\n";
+
+        SwmmMock_Reset();
+        SwmmMock_SetSuccessMode();
+        SwmmMock_SetGetValueReturn(1.0);
+        for (int i = 1; i < s_.inputs; i++) SwmmMock_AddObject(swmm_GAGE, ("RG" + std::to_string(i)).c_str());
+        SwmmLidStub_Initialize(s_.outputs);
+        for (int i = 0; i < s_.outputs; i++) {
+            SwmmMock_AddObject(swmm_SUBCATCH, ("S" + std::to_string(i)).c_str());
+            if (IsLid(i)) SwmmLidStub_AddLidUnit(i, "BioRetention", 1.0);
+        }
+        in_.assign((size_t)s_.inputs, 0.5);
+        out_.assign((size_t)std::max(s_.outputs, 2), 0.0);
+    }
+
+    // One cold realization, then `realizations` warm ones of `steps` steps each
+    bool Run(int realizations, int steps, Result& r) {
+        int status;
+        SwmmGoldSimBridge(XF_REP_ARGUMENTS, &status, in_.data(), out_.data());
+        if (status != 0) return false;
+
+        double warm_init = 0.0, cleanup = 0.0, calc_us = 0.0;
+        long long init_allocs = 0, cleanup_allocs = 0;
+        AllocCount calc_allocs = { 0, 0 };
+        for (int k = 0; k <= realizations; k++) {
+            AllocCount a0 = AllocCount::Now();
+            auto t0 = std::chrono::steady_clock::now();
+            SwmmGoldSimBridge(XF_INITIALIZE, &status, in_.data(), out_.data());
+            auto t1 = std::chrono::steady_clock::now();
+            AllocCount a1 = AllocCount::Now();
+            if (status != 0) {
+                fprintf(stderr, "XF_INITIALIZE failed: %s\n", status == -1 ? (const char*)*(ULONG_PTR*)out_.data() : "");
+                return false;
+            }
+            // The first call only publishes initial outputs; time the stepping calls
+            SwmmGoldSimBridge(XF_CALCULATE, &status, in_.data(), out_.data());
+            AllocCount a2 = AllocCount::Now();
+            auto t2 = std::chrono::steady_clock::now();
+            for (int s = 1; s < steps && status == 0; s++) {
+                in_[0] = 300.0 * s;
+                SwmmGoldSimBridge(XF_CALCULATE, &status, in_.data(), out_.data());
+            }
+            auto t3 = std::chrono::steady_clock::now();
+            AllocCount a3 = AllocCount::Now();
+            if (status != 0) return false;
+            SwmmGoldSimBridge(XF_CLEANUP, &status, in_.data(), out_.data());
+            auto t4 = std::chrono::steady_clock::now();
+            AllocCount a4 = AllocCount::Now();
+
+            if (k == 0) {
+                r.cold_init_us = Us(t0, t1);
+                continue;
+            }
+            warm_init += Us(t0, t1);
+            init_allocs += (a1 - a0).count;
+            calc_us += Us(t2, t3);
+            AllocCount c = a3 - a2;
+            calc_allocs.count += c.count;
+            calc_allocs.bytes += c.bytes;
+            cleanup += Us(t3, t4);
+            cleanup_allocs += (a4 - a3).count;
+        }
+        long long calls = (long long)realizations * (steps - 1);
+        r.warm_init_us = warm_init / realizations;
+        r.cleanup_us = cleanup / realizations;
+        r.calc_ns = calc_us * 1000.0 / calls;
+        r.calc_ns_per_output = r.calc_ns / std::max(s_.outputs, 1);
+        r.init_allocs = (double)init_allocs / realizations;
+        r.calc_allocs = (double)calc_allocs.count / calls;
+        r.calc_bytes = (double)calc_allocs.bytes / calls;
+        r.cleanup_allocs = (double)cleanup_allocs / realizations;
+        return true;
+    }
+
+    void TearDown() {
+        std::remove("SwmmGoldSimBridge.json");
+        std::remove("model.inp");
+    }
+
+private:
+    bool IsLid(int i) const { return i % 100 < s_.lid_percent; }
+
+    Scenario s_;
+    std::vector<double> in_, out_;
+};
+
+//=============================================================================
+// Scenarios
+//=============================================================================
+
+int main(int argc, char** argv) {
+    const long long output_steps = argc > 1 ? atoll(argv[1]) : 2000000;
+    const int realizations = 4;
+
+    const Scenario scenarios[] = {
+        { "outputs", 2, 10, 0, "OFF" },
+        { "outputs", 2, 100, 0, "OFF" },
+        { "outputs", 2, 1000, 0, "OFF" },
+        { "outputs", 2, 10000, 0, "OFF" },
+        { "inputs", 8, 1000, 0, "OFF" },
+        { "inputs", 32, 1000, 0, "OFF" },
+        { "inputs", 128, 1000, 0, "OFF" },
+        { "lid", 2, 1000, 25, "OFF" },
+        { "lid", 2, 1000, 50, "OFF" },
+        { "lid", 2, 1000, 100, "OFF" },
+        { "log", 2, 1000, 0, "ERROR" },
+        { "log", 2, 1000, 0, "INFO" },
+        { "log", 2, 1000, 0, "DEBUG" },
+    };
+
+    printf("=== Bridge overhead benchmark (SWMM mock) ===\n");
+    printf("%d warm realizations per scenario, about %lld output-steps each\n\n", realizations, output_steps);
+    printf("%-8s %5s %6s %4s %-6s | %10s %10s %7s | %10s %8s %7s %7s | %9s %7s\n", "sweep", "in", "out", "lid%",
+           "log", "cold us", "init us", "allocs", "ns/call", "ns/o/s", "allocs", "bytes", "clean us", "allocs");
+
+    int id = 0;
+    bool ok = true;
+    for (const Scenario& s : scenarios) {
+        int steps = (int)std::max(50LL, std::min(100000LL, output_steps / realizations / s.outputs));
+        BridgeFixture fixture(s);
+        fixture.SetUp(id++);
+        Result r;
+        if (!fixture.Run(realizations, steps, r)) {
+            fprintf(stderr, "Scenario %s in=%d out=%d failed\n", s.sweep, s.inputs, s.outputs);
+            ok = false;
+        } else {
+            printf("%-8s %5d %6d %4d %-6s | %10.1f %10.1f %7.1f | %10.1f %8.2f %7.2f %7.1f | %9.1f %7.1f\n", s.sweep,
+                   s.inputs, s.outputs, s.lid_percent, s.log_level, r.cold_init_us, r.warm_init_us, r.init_allocs,
+                   r.calc_ns, r.calc_ns_per_output, r.calc_allocs, r.calc_bytes, r.cleanup_us, r.cleanup_allocs);
+        }
+        fixture.TearDown();
+    }
+    printf("\nns/call and ns/o/s (per output per step) cover stepping XF_CALCULATE calls; allocs are\n"
+           "operator new calls per XF_INITIALIZE, XF_CALCULATE and XF_CLEANUP\n");
+    SwmmLidStub_Cleanup();
+    std::remove("bridge_debug.log");
+    return ok ? 0 : 1;
+}
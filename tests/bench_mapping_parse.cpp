@@ -0,0 +1,86 @@
+//-----------------------------------------------------------------------------
+//   bench_mapping_parse.cpp
+//
+//   Benchmark: MappingLoader::LoadFromFile on synthetic mappings of 10 to
+//   100k outputs, laid out the way generate_mapping.py writes them
+//
+//   Time per entry should stay flat as the mapping grows; a parser that
+//   rescans the document per key shows up here as growing ns/entry.
+//-----------------------------------------------------------------------------
+
+#include "../include/MappingLoader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+static const char* kBenchFile = "bench_mapping.json";
+
+// Mix of element types, LID composite IDs and aggregation modes
+static size_t WriteMapping(int outputs) {
+    static const char* types[] = { "SUBCATCH", "STORAGE", "OUTFALL", "LINK", "LID" };
+    static const char* props[] = { "RUNOFF", "VOLUME", "FLOW", "FLOW", "STORAGE_VOLUME" };
+
+    std::string json;
+    json.reserve((size_t)outputs * 160 + 512);
+    json += "{\n  \"version\": \"1.0\",\n  \"logging_level\": \"INFO\",\n";
+    json += "  \"inp_file_hash\": \"5245d86855c599addf209ec8ff2956ca\",\n";
+    json += "  \"input_count\": 2,\n  \"output_count\": " + std::to_string(outputs) + ",\n";
+    json += "  \"inputs\": [\n";
+    json += "    {\n      \"index\": 0,\n      \"name\": \"ElapsedTime\",\n      \"object_type\": \"SYSTEM\",\n      \"property\": \"ELAPSEDTIME\"\n    },\n";
+    json += "    {\n      \"index\": 1,\n      \"name\": \"RG1\",\n      \"object_type\": \"GAGE\",\n      \"property\": \"RAINFALL\"\n    }\n  ],\n";
+    json += "  \"outputs\": [\n";
+    for (int i = 0; i < outputs; i++) {
+        int k = i % 5;
+        std::string name = (k == 4) ? "S" + std::to_string(i) + "/BioRetention" : "E" + std::to_string(i);
+        json += "    {\n      \"index\": " + std::to_string(i) + ",\n";
+        json += "      \"name\": \"" + name + "\",\n";
+        json += std::string("      \"object_type\": \"") + types[k] + "\",\n";
+        json += std::string("      \"property\": \"") + props[k] + "\",\n";
+        if (i % 7 == 0) json += "      \"aggregation\": \"MEAN\",\n";
+        json += "      \"swmm_index\": 0\n    }";
+        json += (i + 1 < outputs) ? ",\n" : "\n";
+    }
+    json += "  ]\n}\n";
+
+    std::ofstream f(kBenchFile, std::ios::binary);
+    f << json;
+    return json.size();
+}
+
+int main() {
+    const int sizes[] = { 10, 100, 1000, 10000, 100000 };
+    const long long kEntriesPerSize = 2000000;   // work per measurement, split into loads
+
+    printf("=== MappingLoader parse benchmark ===\n");
+    printf("%8s %10s %12s %12s %10s\n", "outputs", "file KB", "ms/load", "ns/entry", "MB/s");
+
+    for (int n : sizes) {
+        size_t bytes = WriteMapping(n);
+        int loads = (int)std::max(3LL, kEntriesPerSize / n);
+
+        MappingLoader loader;
+        std::string error;
+        std::vector<double> ms;
+        ms.reserve(loads);
+        for (int r = 0; r < loads; r++) {
+            auto t0 = std::chrono::steady_clock::now();
+            bool ok = loader.LoadFromFile(kBenchFile, error);
+            auto t1 = std::chrono::steady_clock::now();
+            if (!ok || loader.GetOutputCount() != n) {
+                printf("load failed for %d outputs: %s\n", n, error.c_str());
+                return 1;
+            }
+            ms.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        }
+        std::sort(ms.begin(), ms.end());
+        double median = ms[ms.size() / 2];
+        printf("%8d %10.1f %12.3f %12.1f %10.1f\n", n, bytes / 1024.0, median,
+               median * 1e6 / (n + 2), bytes / (median * 1e-3) / 1e6);
+    }
+
+    std::remove(kBenchFile);
+    return 0;
+}
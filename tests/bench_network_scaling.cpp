@@ -0,0 +1,168 @@
+//-----------------------------------------------------------------------------
+//   bench_network_scaling.cpp
+//
+//   Benchmark: end-to-end bridge cost on synthetic networks of 10 to 100k
+//   subcatchments (swmm_test_models.h), driving SwmmGoldSimBridge through the
+//   GoldSim protocol
+//
+//   Every element is mapped, so outputs grow with the network. Per size it
+//   reports the cold XF_INITIALIZE (mapping load, swmm_open, name resolution),
+//   the time per XF_CALCULATE, and that time per element. A "scaling" column
+//   above 1 shows where cost per element grows with size. Linked against the
+//   SWMM mock it measures the bridge alone; with SWMM_LIBRARY it includes the
+//   engine's parse and routing.
+//
+//   Usage: bench_network_scaling [--max N] [--steps S] [--depth D] [--looped] [--lid]
+//          bench_network_scaling --write N [--depth D] [--looped] [--lid]
+//     --lid    also map LID outputs (the mock's LID stub has no units, so
+//              only use it with the real engine)
+//     --write  write model.inp and SwmmGoldSimBridge.json for N and exit
+//-----------------------------------------------------------------------------
+
+#include "../include/MappingLoader.h"
+#include "../include/Platform.h"
+#include "swmm_test_models.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#define XF_INITIALIZE       0
+#define XF_CALCULATE        1
+#define XF_REP_ARGUMENTS    3
+#define XF_CLEANUP          99
+
+extern "C" void SwmmGoldSimBridge(int methodID, int* status, double* inargs, double* outargs);
+
+static const char* kConfig = "SwmmGoldSimBridge.json";
+static const char* kModel = "model.inp";
+
+static double Ms(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+static long FileSize(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return 0;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+static SwmmTestModels::NetworkSpec Spec(int n, int depth, bool looped, bool lid) {
+    SwmmTestModels::NetworkSpec spec(n);
+    spec.depth = depth;
+    spec.looped = looped;
+    spec.map_lid = lid;
+    spec.rain_gages = 8;
+    return spec;
+}
+
+struct Row {
+    int subcatchments, elements, outputs;
+    double gen_ms, file_mb, init_ms, calc_us, ns_per_element, cleanup_ms;
+};
+
+static bool RunSize(const SwmmTestModels::NetworkSpec& spec, int steps, Row& row) {
+    auto g0 = std::chrono::steady_clock::now();
+    if (!SwmmTestModels::CreateNetworkModel(kModel, spec) || !SwmmTestModels::CreateNetworkMapping(kConfig, spec)) {
+        fprintf(stderr, "Cannot write %s / %s\n", kModel, kConfig);
+        return false;
+    }
+    row.gen_ms = Ms(g0, std::chrono::steady_clock::now());
+    row.file_mb = (FileSize(kModel) + FileSize(kConfig)) / 1048576.0;
+
+    // XF_REP_ARGUMENTS reports the mapping the process loaded first; the bridge
+    // only reloads it in XF_INITIALIZE, once it sees the new model.inp
+    MappingLoader mapping;
+    std::string error;
+    if (!mapping.LoadFromFile(kConfig, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return false;
+    }
+    int status;
+    row.outputs = mapping.GetOutputCount();
+    std::vector<double> in((size_t)mapping.GetInputCount() + 1, 0.0), out((size_t)row.outputs + 2, 0.0);
+    SwmmGoldSimBridge(XF_REP_ARGUMENTS, &status, in.data(), out.data());
+    if (status != 0) return false;
+    for (size_t i = 1; i < in.size(); i++) in[i] = 0.5;   // rainfall; control settings stay open
+
+    auto t0 = std::chrono::steady_clock::now();
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, in.data(), out.data());
+    auto t1 = std::chrono::steady_clock::now();
+    if (status != 0) {
+        fprintf(stderr, "XF_INITIALIZE failed: %s\n", status == -1 ? (const char*)*(ULONG_PTR*)out.data() : "");
+        return false;
+    }
+    SwmmGoldSimBridge(XF_CALCULATE, &status, in.data(), out.data());
+    auto t2 = std::chrono::steady_clock::now();
+    int done = 0;
+    for (int s = 1; s < steps && status == 0; s++, done++) {
+        in[0] = 300.0 * s;
+        SwmmGoldSimBridge(XF_CALCULATE, &status, in.data(), out.data());
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    SwmmGoldSimBridge(XF_CLEANUP, &status, in.data(), out.data());
+    auto t4 = std::chrono::steady_clock::now();
+
+    row.subcatchments = spec.subcatchments;
+    row.elements = 3 * spec.subcatchments + 1;   // subcatchments, nodes and outfall, tree links
+    row.init_ms = Ms(t0, t1);
+    row.calc_us = done > 0 ? Ms(t2, t3) * 1000.0 / done : 0.0;
+    row.ns_per_element = row.calc_us * 1000.0 / row.elements;
+    row.cleanup_ms = Ms(t3, t4);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int max_n = 100000, steps = 200, depth = 8, write_n = 0;
+    bool looped = false, lid = false;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        if (a == "--max" && has_value) max_n = atoi(argv[++i]);
+        else if (a == "--steps" && has_value) steps = atoi(argv[++i]);
+        else if (a == "--depth" && has_value) depth = atoi(argv[++i]);
+        else if (a == "--write" && has_value) write_n = atoi(argv[++i]);
+        else if (a == "--looped") looped = true;
+        else if (a == "--lid") lid = true;
+        else {
+            printf("Usage: bench_network_scaling [--max N] [--steps S] [--depth D] [--looped] [--lid] [--write N]\n");
+            return 1;
+        }
+    }
+
+    if (write_n > 0) {
+        SwmmTestModels::NetworkSpec spec = Spec(write_n, depth, looped, lid);
+        bool ok = SwmmTestModels::CreateNetworkModel(kModel, spec) && SwmmTestModels::CreateNetworkMapping(kConfig, spec);
+        printf("%s %s and %s for %d subcatchments\n", ok ? "Wrote" : "Could not write", kModel, kConfig, write_n);
+        return ok ? 0 : 1;
+    }
+    if (FileSize(kModel) > 0) {
+        fprintf(stderr, "%s exists here; run the benchmark in an empty directory\n", kModel);
+        return 1;
+    }
+
+    printf("=== Network scaling benchmark (%s, depth %d, %d steps) ===\n", looped ? "looped" : "dendritic", depth, steps);
+    printf("%8s %9s %8s %8s %8s | %10s %10s %10s %8s | %10s\n", "subcatch", "elements", "outputs", "gen ms", "MB",
+           "init ms", "us/step", "ns/elem", "scaling", "clean ms");
+    double base = 0.0;
+    bool ok = true;
+    for (int n = 10; n <= max_n && ok; n *= 10) {
+        Row row;
+        ok = RunSize(Spec(n, depth, looped, lid), steps, row);
+        if (!ok) break;
+        if (base == 0.0) base = row.ns_per_element;
+        printf("%8d %9d %8d %8.1f %8.2f | %10.2f %10.1f %10.2f %8.2f | %10.2f\n", row.subcatchments, row.elements,
+               row.outputs, row.gen_ms, row.file_mb, row.init_ms, row.calc_us, row.ns_per_element,
+               base > 0.0 ? row.ns_per_element / base : 0.0, row.cleanup_ms);
+    }
+    std::remove(kModel);
+    std::remove(kConfig);
+    std::remove("SwmmGoldSimBridge.plan");
+    std::remove("model.rpt");
+    std::remove("model.out");
+    return ok ? 0 : 1;
+}
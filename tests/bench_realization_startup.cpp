@@ -0,0 +1,149 @@
+//-----------------------------------------------------------------------------
+//   bench_realization_startup.cpp
+//
+//   Benchmark: per-realization XF_INITIALIZE and XF_CLEANUP cost with and
+//   without "recycle_project", driving the bridge through the GoldSim protocol
+//
+//   Run it in a model directory (model.inp + SwmmGoldSimBridge.json) with the
+//   bridge linked against the real engine to measure swmm_open/swmm_close
+//   savings. In an empty directory it writes a synthetic mapping of 200
+//   outputs and measures bridge overhead over the SWMM mock. Both files are
+//   restored afterwards.
+//-----------------------------------------------------------------------------
+
+#include "../include/Platform.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#define XF_INITIALIZE       0
+#define XF_CALCULATE        1
+#define XF_REP_ARGUMENTS    3
+#define XF_CLEANUP          99
+
+extern "C" void SwmmGoldSimBridge(int methodID, int* status, double* inargs, double* outargs);
+
+static const char* kConfig = "SwmmGoldSimBridge.json";
+static const char* kModel = "model.inp";
+
+static bool ReadText(const char* path, std::string& text) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f.is_open()) return false;
+    text.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static void WriteText(const char* path, const std::string& text) {
+    std::ofstream f(path, std::ios::binary);
+    f << text;
+}
+
+static std::string SyntheticMapping(int outputs) {
+    std::string json = "{\"version\": \"1.0\", \"logging_level\": \"OFF\", \"plan_cache\": false,\n"
+                       " \"inputs\": [{\"index\": 0, \"name\": \"ElapsedTime\", \"object_type\": \"SYSTEM\", "
+                       "\"property\": \"ELAPSEDTIME\"},\n"
+                       "            {\"index\": 1, \"name\": \"RG1\", \"object_type\": \"GAGE\", "
+                       "\"property\": \"RAINFALL\"}],\n \"outputs\": [\n";
+    for (int i = 0; i < outputs; i++) {
+        json += "  {\"index\": " + std::to_string(i) + ", \"name\": \"S" + std::to_string(i) +
+                "\", \"object_type\": \"SUBCATCH\", \"property\": \"RUNOFF\"}";
+        json += (i + 1 < outputs) ? ",\n" : "\n";
+    }
+    return json + "]}\n";
+}
+
+// The mapping with "recycle_project" set last, so it overrides any earlier value. Recycling
+// requires output_policy NONE, so both modes use it and differ only in swmm_open/swmm_close.
+static std::string WithRecycle(const std::string& json, bool recycle) {
+    size_t close = json.rfind('}');
+    return json.substr(0, close) + ", \"output_policy\": \"NONE\", \"recycle_project\": " +
+           (recycle ? "true" : "false") + "}\n";
+}
+
+struct Timing {
+    double init_mean, init_min, cleanup_mean;
+};
+
+static double Us(std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+    return std::chrono::duration<double, std::micro>(b - a).count();
+}
+
+// Realization 0 loads the mapping and resolves names in both modes; it is not counted
+static bool Run(int realizations, int steps, Timing& t) {
+    int status;
+    std::vector<double> in(2, 0.0), out(2, 0.0);
+    SwmmGoldSimBridge(XF_REP_ARGUMENTS, &status, in.data(), out.data());
+    if (status != 0) return false;
+    in.assign((size_t)out[0] + 1, 0.0);
+    out.assign((size_t)out[1] + 2, 0.0);
+
+    double init_sum = 0.0, cleanup_sum = 0.0;
+    t.init_min = 1e300;
+    for (int r = 0; r <= realizations; r++) {
+        auto t0 = std::chrono::steady_clock::now();
+        SwmmGoldSimBridge(XF_INITIALIZE, &status, in.data(), out.data());
+        auto t1 = std::chrono::steady_clock::now();
+        if (status != 0) {
+            fprintf(stderr, "XF_INITIALIZE failed: %s\n", status == -1 ? (const char*)*(ULONG_PTR*)out.data() : "");
+            return false;
+        }
+        for (int s = 0; s < steps && status == 0; s++) {
+            in[0] = 60.0 * s;
+            SwmmGoldSimBridge(XF_CALCULATE, &status, in.data(), out.data());
+        }
+        auto t2 = std::chrono::steady_clock::now();
+        SwmmGoldSimBridge(XF_CLEANUP, &status, in.data(), out.data());
+        auto t3 = std::chrono::steady_clock::now();
+        if (r == 0) continue;
+        init_sum += Us(t0, t1);
+        cleanup_sum += Us(t2, t3);
+        t.init_min = std::min(t.init_min, Us(t0, t1));
+    }
+    t.init_mean = init_sum / realizations;
+    t.cleanup_mean = cleanup_sum / realizations;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const int realizations = argc > 1 ? atoi(argv[1]) : 50;
+    const int steps = argc > 2 ? atoi(argv[2]) : 10;
+
+    std::string config, model;
+    bool synthetic = !ReadText(kModel, model) || !ReadText(kConfig, config);
+    if (synthetic) {
+        config = SyntheticMapping(200);
+        model = "[TITLE]\nRealization startup benchmark\n";
+    }
+
+    printf("=== Realization startup benchmark (%s) ===\n", synthetic ? "synthetic mapping" : kModel);
+    printf("%d realizations of %d steps per mode\n", realizations, steps);
+    printf("%10s %16s %16s %18s\n", "mode", "init us (mean)", "init us (min)", "cleanup us (mean)");
+
+    Timing t[2];
+    bool ok = true;
+    for (int recycle = 0; recycle < 2 && ok; recycle++) {
+        // A changed model.inp makes the bridge reload the mapping and close any open project
+        WriteText(kConfig, WithRecycle(config, recycle != 0));
+        WriteText(kModel, model + (recycle ? "; recycle_project true\n" : "; recycle_project false\n"));
+        ok = Run(realizations, steps, t[recycle]);
+        if (ok)
+            printf("%10s %16.1f %16.1f %18.1f\n", recycle ? "recycle" : "reopen", t[recycle].init_mean,
+                   t[recycle].init_min, t[recycle].cleanup_mean);
+    }
+    if (ok && t[1].init_mean > 0.0)
+        printf("startup speedup: %.1fx\n", (t[0].init_mean + t[0].cleanup_mean) / (t[1].init_mean + t[1].cleanup_mean));
+
+    if (synthetic) {
+        std::remove(kConfig);
+        std::remove(kModel);
+    } else {
+        WriteText(kConfig, config);
+        WriteText(kModel, model);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+//-----------------------------------------------------------------------------
+//   bench_value_api.cpp
+//
+//   Microbenchmark: scalar swmm_getValue/swmm_setValue vs vectorized
+//   swmm_getValues/swmm_setValues against the SWMM mock
+//
+//   Build the mock as a DLL (see build_and_run_value_bench.bat) so every
+//   call crosses a DLL boundary, as it does against the real swmm5.dll.
+//-----------------------------------------------------------------------------
+
+#include "swmm_mock.h"
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+static volatile double g_sink = 0.0;  // keeps results observable
+
+static double NsPerElement(std::chrono::steady_clock::duration d, long long elements) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() / (double)elements;
+}
+
+int main() {
+    const int sizes[] = { 10, 100, 1000, 10000 };
+    const long long kElementsPerRun = 20000000;   // work per measurement, split into steps
+
+    SwmmMock_Reset();
+    SwmmMock_SetGetValueReturn(1.5);
+
+    printf("=== SWMM value API microbenchmark (mock) ===\n");
+    printf("%8s %14s %14s %14s %14s\n", "n", "get ns/elem", "getv ns/elem", "set ns/elem", "setv ns/elem");
+
+    for (int n : sizes) {
+        std::vector<int> props(n), indexes(n);
+        std::vector<double> values(n, 0.0);
+        for (int i = 0; i < n; i++) {
+            props[i] = (i % 2) ? (int)swmm_NODE_VOLUME : (int)swmm_LINK_FLOW;
+            indexes[i] = i;
+        }
+        long long steps = kElementsPerRun / n;
+        long long elements = steps * n;
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (long long s = 0; s < steps; s++)
+            for (int i = 0; i < n; i++) values[i] = swmm_getValue(props[i], indexes[i]);
+        auto t1 = std::chrono::steady_clock::now();
+        g_sink = g_sink + values[n - 1];
+
+        for (long long s = 0; s < steps; s++)
+            swmm_getValues(props.data(), indexes.data(), n, values.data());
+        auto t2 = std::chrono::steady_clock::now();
+        g_sink = g_sink + values[n - 1];
+
+        for (long long s = 0; s < steps; s++)
+            for (int i = 0; i < n; i++) swmm_setValue(props[i], indexes[i], values[i]);
+        auto t3 = std::chrono::steady_clock::now();
+
+        for (long long s = 0; s < steps; s++)
+            swmm_setValues(props.data(), indexes.data(), n, values.data());
+        auto t4 = std::chrono::steady_clock::now();
+
+        printf("%8d %14.2f %14.2f %14.2f %14.2f\n", n,
+               NsPerElement(t1 - t0, elements), NsPerElement(t2 - t1, elements),
+               NsPerElement(t3 - t2, elements), NsPerElement(t4 - t3, elements));
+    }
+
+    // Sanity: both paths reached the mock the same number of times per element
+    printf("\nmock getValue elements: %d, getValues calls: %d\n",
+           SwmmMock_GetValueCallCount(), SwmmMock_GetValuesCallCount());
+    return 0;
+}
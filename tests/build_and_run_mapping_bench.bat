@@ -0,0 +1,21 @@
+@echo off
+REM Build and run the MappingLoader parse benchmark (10 to 100k outputs)
+
+echo ========================================
+echo Building Mapping Parse Benchmark
+echo ========================================
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+cl /O2 /EHsc /MD /I..\include bench_mapping_parse.cpp ..\MappingLoader.cpp /link /OUT:bench_mapping_parse.exe
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed!
+    exit /b 1
+)
+
+echo.
+bench_mapping_parse.exe
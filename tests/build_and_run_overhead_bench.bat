@@ -0,0 +1,29 @@
+@echo off
+REM Build and run the bridge overhead benchmark (ns per output per step and
+REM allocations per call as outputs, inputs, LID share and log level vary)
+REM The bridge is compiled in against the SWMM mock and LID API stub
+
+echo ========================================
+echo Building Bridge Overhead Benchmark
+echo ========================================
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+cl /O2 /EHsc /MD /I.. /I..\include bench_bridge_overhead.cpp swmm_mock.cpp swmm_lid_api_stub.cpp ^
+   ..\SwmmGoldSimBridge.cpp ..\MappingLoader.cpp ..\BridgeLogger.cpp ..\StepWorker.cpp ..\BridgeProfiler.cpp ..\PlanCache.cpp ..\NameIndex.cpp ^
+   ..\MappedFile.cpp ..\SeriesRecorder.cpp ..\CallTrace.cpp ..\TimelineTracer.cpp ..\AllocTracker.cpp /link /OUT:bench_bridge_overhead.exe
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed!
+    exit /b 1
+)
+
+REM Each scenario writes its own mapping and model.inp
+echo.
+if not exist overhead_bench_run mkdir overhead_bench_run
+pushd overhead_bench_run
+..\bench_bridge_overhead.exe
+popd
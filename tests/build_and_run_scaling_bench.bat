@@ -0,0 +1,29 @@
+@echo off
+REM Build and run the network scaling benchmark (synthetic networks of 10 to 100k
+REM subcatchments). The bridge is compiled in against the SWMM mock, so this
+REM measures bridge overhead; link GSswmm.lib for engine numbers
+
+echo ========================================
+echo Building Network Scaling Benchmark
+echo ========================================
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+cl /O2 /EHsc /MD /I.. /I..\include bench_network_scaling.cpp swmm_mock.cpp swmm_lid_api_stub.cpp ^
+   ..\SwmmGoldSimBridge.cpp ..\MappingLoader.cpp ..\BridgeLogger.cpp ..\StepWorker.cpp ..\BridgeProfiler.cpp ..\PlanCache.cpp ..\NameIndex.cpp ^
+   ..\MappedFile.cpp ..\SeriesRecorder.cpp ..\CallTrace.cpp ..\TimelineTracer.cpp ..\AllocTracker.cpp /link /OUT:bench_network_scaling.exe
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed!
+    exit /b 1
+)
+
+REM The benchmark writes model.inp and the mapping for each size
+echo.
+if not exist scaling_bench_run mkdir scaling_bench_run
+pushd scaling_bench_run
+..\bench_network_scaling.exe %*
+popd
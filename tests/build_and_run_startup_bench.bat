@@ -0,0 +1,29 @@
+@echo off
+REM Build and run the realization startup benchmark (recycle_project off vs on)
+REM The bridge is compiled in against the SWMM mock, so this measures bridge
+REM overhead; link GSswmm.lib and run it in a model directory for engine numbers
+
+echo ========================================
+echo Building Realization Startup Benchmark
+echo ========================================
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+cl /O2 /EHsc /MD /I.. /I..\include bench_realization_startup.cpp swmm_mock.cpp swmm_lid_api_stub.cpp ^
+   ..\SwmmGoldSimBridge.cpp ..\MappingLoader.cpp ..\BridgeLogger.cpp ..\StepWorker.cpp ..\BridgeProfiler.cpp ..\PlanCache.cpp ..\NameIndex.cpp ^
+   ..\MappedFile.cpp ..\SeriesRecorder.cpp ..\CallTrace.cpp ..\TimelineTracer.cpp ..\AllocTracker.cpp /link /OUT:bench_realization_startup.exe
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed!
+    exit /b 1
+)
+
+REM The benchmark writes its own mapping and model.inp when none are present
+echo.
+if not exist startup_bench_run mkdir startup_bench_run
+pushd startup_bench_run
+..\bench_realization_startup.exe
+popd
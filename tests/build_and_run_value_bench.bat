@@ -0,0 +1,29 @@
+@echo off
+REM Build and run the scalar vs vectorized value API microbenchmark
+REM The mock is built as a DLL so each call crosses a DLL boundary
+
+echo ========================================
+echo Building Value API Microbenchmark
+echo ========================================
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+REM Mock + LID stub as swmm_mock.dll (exports come from swmm5.h DLLEXPORT)
+cl /LD /O2 /EHsc /MD /I..\include swmm_mock.cpp swmm_lid_api_stub.cpp /link /OUT:swmm_mock.dll
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed!
+    exit /b 1
+)
+
+cl /O2 /EHsc /MD /I..\include bench_value_api.cpp swmm_mock.lib /link /OUT:bench_value_api.exe
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed!
+    exit /b 1
+)
+
+echo.
+bench_value_api.exe
@@ -0,0 +1,33 @@
+@echo off
+echo Building bridge mock test program...
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+REM Compile the bridge into the test program, against the SWMM mock and LID stub
+cl /EHsc /W3 /MD /I.. /I..\include /Fe:test_bridge_mock.exe test_bridge_mock.cpp swmm_mock.cpp swmm_lid_api_stub.cpp ^
+   ..\SwmmGoldSimBridge.cpp ..\MappingLoader.cpp ..\BridgeLogger.cpp ..\StepWorker.cpp ..\BridgeProfiler.cpp ..\PlanCache.cpp ..\NameIndex.cpp ^
+   ..\MappedFile.cpp ..\SeriesRecorder.cpp ..\CallTrace.cpp ..\TimelineTracer.cpp ..\AllocTracker.cpp ..\SeriesReader.cpp
+if errorlevel 1 (
+    echo ERROR: Compilation failed
+    exit /b 1
+)
+
+echo Test program compiled successfully
+echo.
+
+REM The test writes its own SwmmGoldSimBridge.json, so keep it out of tests\
+echo Running bridge mock tests...
+echo.
+if not exist bridge_mock_run mkdir bridge_mock_run
+pushd bridge_mock_run
+..\test_bridge_mock.exe
+set TEST_RESULT=%ERRORLEVEL%
+popd
+
+echo.
+echo Test completed with exit code: %TEST_RESULT%
+exit /b %TEST_RESULT%
@@ -0,0 +1,33 @@
+@echo off
+echo Building XF_CALCULATE allocation test program...
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+REM Compile the bridge with allocation tracking into the test program, against the SWMM mock and LID stub
+cl /EHsc /W3 /MD /DGSSWMM_ALLOC_TRACKING /I.. /I..\include /Fe:test_calculate_allocations.exe test_calculate_allocations.cpp swmm_mock.cpp swmm_lid_api_stub.cpp ^
+   ..\SwmmGoldSimBridge.cpp ..\MappingLoader.cpp ..\BridgeLogger.cpp ..\StepWorker.cpp ..\BridgeProfiler.cpp ..\PlanCache.cpp ..\NameIndex.cpp ^
+   ..\MappedFile.cpp ..\SeriesRecorder.cpp ..\CallTrace.cpp ..\TimelineTracer.cpp ..\AllocTracker.cpp
+if errorlevel 1 (
+    echo ERROR: Compilation failed
+    exit /b 1
+)
+
+echo Test program compiled successfully
+echo.
+
+REM The test writes its own SwmmGoldSimBridge.json, so keep it out of tests\
+echo Running XF_CALCULATE allocation tests...
+echo.
+if not exist alloc_test_run mkdir alloc_test_run
+pushd alloc_test_run
+..\test_calculate_allocations.exe
+set TEST_RESULT=%ERRORLEVEL%
+popd
+
+echo.
+echo Test completed with exit code: %TEST_RESULT%
+exit /b %TEST_RESULT%
@@ -0,0 +1,27 @@
+@echo off
+echo Building CallTrace test program...
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+REM Compile the test program together with the call trace writer and reader
+cl /EHsc /W3 /MD /I.. /Fe:test_call_trace.exe test_call_trace.cpp ..\CallTrace.cpp ..\MappedFile.cpp
+if errorlevel 1 (
+    echo ERROR: Compilation failed
+    exit /b 1
+)
+
+echo Test program compiled successfully
+echo.
+
+echo Running CallTrace tests...
+echo.
+test_call_trace.exe
+set TEST_RESULT=%ERRORLEVEL%
+
+echo.
+echo Test completed with exit code: %TEST_RESULT%
+exit /b %TEST_RESULT%
@@ -0,0 +1,27 @@
+@echo off
+echo Building NameIndex test program...
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+REM Compile the test program together with the name index
+cl /EHsc /W3 /MD /I.. /Fe:test_name_index.exe test_name_index.cpp ..\NameIndex.cpp
+if errorlevel 1 (
+    echo ERROR: Compilation failed
+    exit /b 1
+)
+
+echo Test program compiled successfully
+echo.
+
+echo Running NameIndex tests...
+echo.
+test_name_index.exe
+set TEST_RESULT=%ERRORLEVEL%
+
+echo.
+echo Test completed with exit code: %TEST_RESULT%
+exit /b %TEST_RESULT%
@@ -0,0 +1,27 @@
+@echo off
+echo Building SeriesRecorder test program...
+
+REM Set up Visual Studio environment
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+if errorlevel 1 (
+    call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvars64.bat" >nul 2>&1
+)
+
+REM Compile the test program together with the series recorder and reader
+cl /EHsc /W3 /MD /I.. /Fe:test_series_recorder.exe test_series_recorder.cpp ..\SeriesRecorder.cpp ..\SeriesReader.cpp ..\MappedFile.cpp
+if errorlevel 1 (
+    echo ERROR: Compilation failed
+    exit /b 1
+)
+
+echo Test program compiled successfully
+echo.
+
+echo Running SeriesRecorder tests...
+echo.
+test_series_recorder.exe
+set TEST_RESULT=%ERRORLEVEL%
+
+echo.
+echo Test completed with exit code: %TEST_RESULT%
+exit /b %TEST_RESULT%
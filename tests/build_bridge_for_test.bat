@@ -37,8 +37,8 @@ if %ERRORLEVEL% NEQ 0 (
 )
 echo [OK] LID API stub compiled
 
-echo [2/4] Compiling MappingLoader...
-cl /c /EHsc /W3 /MD /I.. ..\MappingLoader.cpp >nul 2>&1
+echo [2/4] Compiling MappingLoader and support modules...
+cl /c /EHsc /W3 /MD /I.. ..\MappingLoader.cpp ..\BridgeLogger.cpp ..\StepWorker.cpp ..\BridgeProfiler.cpp ..\PlanCache.cpp ..\NameIndex.cpp ..\MappedFile.cpp ..\SeriesRecorder.cpp ..\CallTrace.cpp ..\TimelineTracer.cpp ..\AllocTracker.cpp >nul 2>&1
 if %ERRORLEVEL% NEQ 0 (
     echo ERROR: Failed to compile MappingLoader
     exit /b 1
@@ -54,11 +54,11 @@ if %ERRORLEVEL% NEQ 0 (
 echo [OK] SwmmGoldSimBridge compiled
 
 echo [4/4] Linking test bridge DLL...
-link /DLL /OUT:GSswmm.dll SwmmGoldSimBridge.obj MappingLoader.obj swmm_lid_api_stub.obj ..\lib\swmm5.lib kernel32.lib user32.lib msvcrt.lib msvcprt.lib >nul 2>&1
+link /DLL /OUT:GSswmm.dll SwmmGoldSimBridge.obj MappingLoader.obj BridgeLogger.obj StepWorker.obj BridgeProfiler.obj PlanCache.obj NameIndex.obj MappedFile.obj SeriesRecorder.obj CallTrace.obj TimelineTracer.obj AllocTracker.obj swmm_lid_api_stub.obj ..\lib\swmm5.lib kernel32.lib user32.lib msvcrt.lib msvcprt.lib >nul 2>&1
 if %ERRORLEVEL% NEQ 0 (
     echo ERROR: Failed to link bridge DLL
     echo Trying with additional libraries...
-    link /DLL /OUT:GSswmm.dll SwmmGoldSimBridge.obj MappingLoader.obj swmm_lid_api_stub.obj ..\lib\swmm5.lib kernel32.lib user32.lib
+    link /DLL /OUT:GSswmm.dll SwmmGoldSimBridge.obj MappingLoader.obj BridgeLogger.obj StepWorker.obj BridgeProfiler.obj PlanCache.obj NameIndex.obj MappedFile.obj SeriesRecorder.obj CallTrace.obj TimelineTracer.obj AllocTracker.obj swmm_lid_api_stub.obj ..\lib\swmm5.lib kernel32.lib user32.lib
     if %ERRORLEVEL% NEQ 0 (
         echo ERROR: Link failed
         exit /b 1
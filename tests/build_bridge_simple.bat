@@ -10,8 +10,8 @@ cl /c /EHsc /W3 /MD /DDLLEXPORT=__declspec(dllexport) /I.. swmm_lid_api_stub.cpp
 if %ERRORLEVEL% NEQ 0 exit /b 1
 
 REM Compile MappingLoader
-echo [2/3] Compiling MappingLoader...
-cl /c /EHsc /W3 /MD /I.. ..\MappingLoader.cpp
+echo [2/3] Compiling MappingLoader and support modules...
+cl /c /EHsc /W3 /MD /I.. ..\MappingLoader.cpp ..\BridgeLogger.cpp ..\StepWorker.cpp ..\BridgeProfiler.cpp ..\PlanCache.cpp ..\NameIndex.cpp ..\MappedFile.cpp ..\SeriesRecorder.cpp ..\CallTrace.cpp ..\TimelineTracer.cpp ..\AllocTracker.cpp
 if %ERRORLEVEL% NEQ 0 exit /b 1
 
 REM Compile SwmmGoldSimBridge
@@ -21,7 +21,7 @@ if %ERRORLEVEL% NEQ 0 exit /b 1
 
 REM Link DLL
 echo [3/3] Linking bridge DLL...
-link /DLL /OUT:GSswmm.dll SwmmGoldSimBridge.obj MappingLoader.obj swmm_lid_api_stub.obj ..\lib\swmm5.lib
+link /DLL /OUT:GSswmm.dll SwmmGoldSimBridge.obj MappingLoader.obj BridgeLogger.obj StepWorker.obj BridgeProfiler.obj PlanCache.obj NameIndex.obj MappedFile.obj SeriesRecorder.obj CallTrace.obj TimelineTracer.obj AllocTracker.obj swmm_lid_api_stub.obj ..\lib\swmm5.lib
 if %ERRORLEVEL% NEQ 0 exit /b 1
 
 echo.
@@ -35,7 +35,7 @@ echo [OK] LID API stub compiled
 echo.
 
 echo [2/3] Compiling bridge components...
-cl /c /EHsc /W3 /MD /I.. ..\MappingLoader.cpp >nul 2>&1
+cl /c /EHsc /W3 /MD /I.. ..\MappingLoader.cpp ..\BridgeLogger.cpp ..\StepWorker.cpp ..\BridgeProfiler.cpp ..\PlanCache.cpp ..\NameIndex.cpp ..\MappedFile.cpp ..\SeriesRecorder.cpp ..\CallTrace.cpp ..\TimelineTracer.cpp ..\AllocTracker.cpp >nul 2>&1
 if %ERRORLEVEL% NEQ 0 (
     echo ERROR: Failed to compile MappingLoader.cpp
     exit /b 1
@@ -51,7 +51,7 @@ echo [OK] Bridge components compiled
 echo.
 
 echo [3/3] Linking bridge DLL...
-link /DLL /OUT:GSswmm.dll SwmmGoldSimBridge.obj MappingLoader.obj swmm_lid_api_stub.obj ..\lib\swmm5.lib >nul 2>&1
+link /DLL /OUT:GSswmm.dll SwmmGoldSimBridge.obj MappingLoader.obj BridgeLogger.obj StepWorker.obj BridgeProfiler.obj PlanCache.obj NameIndex.obj MappedFile.obj SeriesRecorder.obj CallTrace.obj TimelineTracer.obj AllocTracker.obj swmm_lid_api_stub.obj ..\lib\swmm5.lib >nul 2>&1
 
 if %ERRORLEVEL% NEQ 0 (
     echo ERROR: Failed to link bridge DLL
@@ -8,6 +8,7 @@
 #ifndef GTEST_MINIMAL_H
 #define GTEST_MINIMAL_H
 
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -80,15 +81,22 @@ public:
         return failed;
     }
     
+    // Assertions recorded so far, for drivers that call test functions directly
+    int GetFailureCount() const { return failure_count; }
+    
     void RecordFailure(const std::string& file, int line, const std::string& message) {
         current_test_failed = true;
+        failure_count++;
         std::cout << file << ":" << line << ": Failure" << std::endl;
         std::cout << message << std::endl;
     }
     
 private:
+    TestRegistry() : current_test_failed(false), failure_count(0) {}
+    
     std::vector<TestInfo> tests;
     bool current_test_failed;
+    int failure_count;
     std::string current_test_name;
 };
 
@@ -221,6 +229,17 @@ public:
         } \
     } while (0)
 
+#define ASSERT_FALSE(condition) \
+    do { \
+        if (condition) { \
+            std::ostringstream oss; \
+            oss << "Expected: " << #condition << " is false" << std::endl; \
+            oss << "  Actual: true"; \
+            TestRegistry::Instance().RecordFailure(__FILE__, __LINE__, oss.str()); \
+            return; \
+        } \
+    } while (0)
+
 #define ASSERT_GE(val1, val2) \
     do { \
         auto v1 = (val1); \
@@ -307,7 +326,7 @@ namespace testing {
 // Google Test Compatibility
 //-----------------------------------------------------------------------------
 namespace testing {
-    inline void InitGoogleTest(int* argc, char** argv) {
+    inline void InitGoogleTest(int* /*argc*/, char** /*argv*/) {
         // Minimal implementation - just parse basic flags if needed
     }
 }
@@ -10,6 +10,7 @@
 //   and enable integration testing of the bridge components.
 //-----------------------------------------------------------------------------
 
+#include "../include/Platform.h"
 #include "../include/swmm5.h"
 #include <string.h>
 #include <stdio.h>
@@ -33,6 +34,7 @@ static StubSubcatch* g_stubSubcatchments = nullptr;
 static int g_stubSubcatchCount = 0;
 static bool g_stubInitialized = false;
 static char g_stubErrorMsg[256] = "";
+static int g_stubNameCalls = 0;
 
 //-----------------------------------------------------------------------------
 // Stub initialization (called by test setup)
@@ -55,6 +57,7 @@ extern "C" void SwmmLidStub_Initialize(int subcatchCount) {
     
     g_stubInitialized = true;
     g_stubErrorMsg[0] = '\0';
+    g_stubNameCalls = 0;
 }
 
 extern "C" void SwmmLidStub_AddLidUnit(int subcatchIndex, const char* controlName, double initialVolume) {
@@ -98,6 +101,10 @@ extern "C" void SwmmLidStub_SetSurfaceOutflow(int subcatchIndex, int lidIndex, d
     subcatch->lidUnits[lidIndex].surfaceOutflow = outflow;
 }
 
+extern "C" int SwmmLidStub_GetNameCallCount() {
+    return g_stubNameCalls;
+}
+
 extern "C" void SwmmLidStub_Cleanup() {
     if (g_stubSubcatchments) {
         for (int i = 0; i < g_stubSubcatchCount; i++) {
@@ -159,6 +166,8 @@ extern "C" int DLLEXPORT swmm_getLidUCount(int subcatchIndex)
 extern "C" void DLLEXPORT swmm_getLidUName(int subcatchIndex, int lidIndex, 
                                             char* name, int size)
 {
+    g_stubNameCalls++;
+
     // Initialize output buffer
     if (name && size > 0) {
         name[0] = '\0';
@@ -283,6 +292,99 @@ extern "C" double DLLEXPORT swmm_getLidUSurfaceOutflow(int subcatchIndex, int li
     return subcatch->lidUnits[lidIndex].surfaceOutflow;
 }
 
+/**
+ * @brief Get the current surface inflow to an LID unit
+ * @note The stub does not track inflow; valid units report 0
+ */
+extern "C" double DLLEXPORT swmm_getLidUSurfaceInflow(int subcatchIndex, int lidIndex)
+{
+    if (!g_stubInitialized || subcatchIndex < 0 || subcatchIndex >= g_stubSubcatchCount ||
+        lidIndex < 0 || lidIndex >= g_stubSubcatchments[subcatchIndex].lidCount) {
+        snprintf(g_stubErrorMsg, sizeof(g_stubErrorMsg), 
+                 "LID API Error: Invalid LID unit (%d, %d)", subcatchIndex, lidIndex);
+        return 0.0;
+    }
+    return 0.0;
+}
+
+/**
+ * @brief Get the current underdrain flow from an LID unit
+ * @note The stub does not track drain flow; valid units report 0
+ */
+extern "C" double DLLEXPORT swmm_getLidUDrainFlow(int subcatchIndex, int lidIndex)
+{
+    if (!g_stubInitialized || subcatchIndex < 0 || subcatchIndex >= g_stubSubcatchCount ||
+        lidIndex < 0 || lidIndex >= g_stubSubcatchments[subcatchIndex].lidCount) {
+        snprintf(g_stubErrorMsg, sizeof(g_stubErrorMsg), 
+                 "LID API Error: Invalid LID unit (%d, %d)", subcatchIndex, lidIndex);
+        return 0.0;
+    }
+    return 0.0;
+}
+
+//-----------------------------------------------------------------------------
+// Batched LID API
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Get the total number of LID units across all subcatchments
+ */
+extern "C" int DLLEXPORT swmm_getLidUTotalCount(void)
+{
+    int total = 0;
+    for (int i = 0; i < g_stubSubcatchCount; i++) {
+        total += g_stubSubcatchments[i].lidCount;
+    }
+    return total;
+}
+
+/**
+ * @brief Get the state of many LID units in one call
+ * 
+ * Mirrors swmm5_integration/SWMM5_LID_API_CODE.c. The stub only tracks
+ * storage volume and surface outflow; other quantities are reported as 0.
+ */
+extern "C" int DLLEXPORT swmm_getLidUStates(int n, const int* subcatchIndex, const int* lidIndex,
+                                             double* storageVolume, double* surfaceInflow,
+                                             double* surfaceOutflow, double* drainFlow,
+                                             double* evapVolume, double* exfilVolume)
+{
+    bool allUnits = (subcatchIndex == nullptr && lidIndex == nullptr);
+    if (n < 0 || (!allUnits && (subcatchIndex == nullptr || lidIndex == nullptr))) {
+        snprintf(g_stubErrorMsg, sizeof(g_stubErrorMsg), 
+                 "LID API Error: Invalid buffer");
+        return -1;
+    }
+    
+    int errcode = 0;
+    int s = 0, k = 0;
+    for (int i = 0; i < n; i++) {
+        StubLidUnit* unit = nullptr;
+        if (allUnits) {
+            while (s < g_stubSubcatchCount && k >= g_stubSubcatchments[s].lidCount) { s++; k = 0; }
+            if (s < g_stubSubcatchCount) unit = &g_stubSubcatchments[s].lidUnits[k++];
+        } else if (g_stubInitialized && subcatchIndex[i] >= 0 && subcatchIndex[i] < g_stubSubcatchCount &&
+                   lidIndex[i] >= 0 && lidIndex[i] < g_stubSubcatchments[subcatchIndex[i]].lidCount) {
+            unit = &g_stubSubcatchments[subcatchIndex[i]].lidUnits[lidIndex[i]];
+        }
+        
+        if (!unit) errcode = -1;
+        double volume = unit ? unit->storageVolume : 0.0;
+        if (storageVolume)  storageVolume[i] = (volume >= 0.0) ? volume : 0.0;
+        if (surfaceInflow)  surfaceInflow[i] = 0.0;
+        if (surfaceOutflow) surfaceOutflow[i] = unit ? unit->surfaceOutflow : 0.0;
+        if (drainFlow)      drainFlow[i] = 0.0;
+        if (evapVolume)     evapVolume[i] = 0.0;
+        if (exfilVolume)    exfilVolume[i] = 0.0;
+    }
+    
+    if (errcode) {
+        snprintf(g_stubErrorMsg, sizeof(g_stubErrorMsg), 
+                 "LID API Error: Invalid LID unit in batch request");
+    }
+    return errcode;
+}
+
 //-----------------------------------------------------------------------------
 // Error message retrieval (integrates with existing swmm_getError)
 //-----------------------------------------------------------------------------
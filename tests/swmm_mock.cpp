@@ -7,6 +7,7 @@
 #include "swmm_mock.h"
 #include <string.h>
 #include <stdio.h>
+#include <ctype.h>
 
 //-----------------------------------------------------------------------------
 // Global mock state
@@ -29,6 +30,12 @@ void SwmmMock_Reset()
     g_mock_state.setValue_call_count = 0;
     g_mock_state.getError_call_count = 0;
     g_mock_state.getCount_call_count = 0;
+    g_mock_state.getValues_call_count = 0;
+    g_mock_state.setValues_call_count = 0;
+    g_mock_state.getIndex_call_count = 0;
+    g_mock_state.getName_call_count = 0;
+    g_mock_state.saveState_call_count = 0;
+    g_mock_state.loadState_call_count = 0;
     
     // Reset parameter tracking
     g_mock_state.last_input_file = "";
@@ -52,6 +59,10 @@ void SwmmMock_Reset()
     g_mock_state.getValue_return_value = 0.0;
     g_mock_state.error_message = "";
     g_mock_state.getCount_return_value = 1;  // Default to 1 subcatchment
+    g_mock_state.getIndex_return_value = 0;
+    for (auto& names : g_mock_state.objects) names.clear();
+    for (auto& flags : g_mock_state.rpt_flags) flags.clear();
+    g_mock_state.rpt_flags_after_start = 0;
     
     // Reset step behavior
     g_mock_state.step_calls_until_end = 0;
@@ -124,6 +135,29 @@ void SwmmMock_SetGetCountReturn(int count)
     g_mock_state.getCount_return_value = count;
 }
 
+void SwmmMock_SetGetIndexReturn(int index)
+{
+    g_mock_state.getIndex_return_value = index;
+}
+
+void SwmmMock_AddObject(int objType, const char* name)
+{
+    if (objType >= 0 && objType < 4 && name)
+        g_mock_state.objects[objType].push_back(name);
+}
+
+double SwmmMock_GetReportFlag(int objType, int index)
+{
+    if (objType < 0 || objType >= 4 || index < 0 || index >= (int)g_mock_state.rpt_flags[objType].size())
+        return -1.0;
+    return g_mock_state.rpt_flags[objType][index];
+}
+
+int SwmmMock_GetLateReportFlagCount()
+{
+    return g_mock_state.rpt_flags_after_start;
+}
+
 int SwmmMock_GetOpenCallCount()
 {
     return g_mock_state.open_call_count;
@@ -159,6 +193,36 @@ int SwmmMock_GetSetValueCallCount()
     return g_mock_state.setValue_call_count;
 }
 
+int SwmmMock_GetValuesCallCount()
+{
+    return g_mock_state.getValues_call_count;
+}
+
+int SwmmMock_GetSetValuesCallCount()
+{
+    return g_mock_state.setValues_call_count;
+}
+
+int SwmmMock_GetIndexCallCount()
+{
+    return g_mock_state.getIndex_call_count;
+}
+
+int SwmmMock_GetNameCallCount()
+{
+    return g_mock_state.getName_call_count;
+}
+
+int SwmmMock_GetSaveStateCallCount()
+{
+    return g_mock_state.saveState_call_count;
+}
+
+int SwmmMock_GetLoadStateCallCount()
+{
+    return g_mock_state.loadState_call_count;
+}
+
 const char* SwmmMock_GetLastInputFile()
 {
     return g_mock_state.last_input_file.c_str();
@@ -214,13 +278,23 @@ extern "C" int swmm_open(const char* f1, const char* f2, const char* f3)
     g_mock_state.last_input_file = f1 ? f1 : "";
     g_mock_state.last_report_file = f2 ? f2 : "";
     g_mock_state.last_output_file = f3 ? f3 : "";
-    
-    if (g_mock_state.open_return_code == 0)
+
+    if (g_mock_state.open_return_code != 0)
     {
-        g_mock_state.is_opened = true;
+        return g_mock_state.open_return_code;
     }
-    
-    return g_mock_state.open_return_code;
+
+    // Like SWMM, fail on an input file that cannot be opened (the contents are not read)
+    FILE* inp = f1 ? fopen(f1, "r") : NULL;
+    if (!inp)
+    {
+        g_mock_state.error_message = "ERROR 303: cannot open input file.";
+        return 303;
+    }
+    fclose(inp);
+
+    g_mock_state.is_opened = true;
+    return 0;
 }
 
 extern "C" int swmm_start(int saveFlag)
@@ -284,6 +358,18 @@ extern "C" void swmm_setValue(int type, int index, double value)
     g_mock_state.last_setValue_type = type;
     g_mock_state.last_setValue_index = index;
     g_mock_state.last_setValue_value = value;
+
+    int objType = (type == swmm_SUBCATCH_RPTFLAG) ? swmm_SUBCATCH :
+                  (type == swmm_NODE_RPTFLAG) ? swmm_NODE :
+                  (type == swmm_LINK_RPTFLAG) ? swmm_LINK : -1;
+    if (objType >= 0 && index >= 0)
+    {
+        // SWMM only honours report flags before swmm_start
+        if (g_mock_state.is_started) g_mock_state.rpt_flags_after_start++;
+        std::vector<double>& flags = g_mock_state.rpt_flags[objType];
+        if ((int)flags.size() <= index) flags.resize(index + 1, -1.0);
+        flags[index] = value;
+    }
 }
 
 extern "C" double swmm_getValue(int type, int index)
@@ -294,6 +380,37 @@ extern "C" double swmm_getValue(int type, int index)
     return g_mock_state.getValue_return_value;
 }
 
+extern "C" int swmm_getValues(const int* props, const int* indexes, int n, double* values)
+{
+    g_mock_state.getValues_call_count++;
+    if (n < 0 || (n > 0 && (!props || !indexes || !values))) return -1;
+    
+    // Per-element tracking matches n scalar swmm_getValue calls
+    for (int i = 0; i < n; i++)
+    {
+        g_mock_state.getValue_call_count++;
+        g_mock_state.last_getValue_type = props[i];
+        g_mock_state.last_getValue_index = indexes[i];
+        values[i] = g_mock_state.getValue_return_value;
+    }
+    return 0;
+}
+
+extern "C" int swmm_setValues(const int* props, const int* indexes, int n, const double* values)
+{
+    g_mock_state.setValues_call_count++;
+    if (n < 0 || (n > 0 && (!props || !indexes || !values))) return -1;
+    
+    for (int i = 0; i < n; i++)
+    {
+        g_mock_state.setValue_call_count++;
+        g_mock_state.last_setValue_type = props[i];
+        g_mock_state.last_setValue_index = indexes[i];
+        g_mock_state.last_setValue_value = values[i];
+    }
+    return 0;
+}
+
 // Forward declaration for LID API stub error retrieval
 extern "C" const char* SwmmLidStub_GetLastError();
 
@@ -321,9 +438,67 @@ extern "C" int swmm_getError(char* errMsg, int msgLen)
     return 0;
 }
 
+static const std::vector<std::string>* MockObjects(int objType)
+{
+    if (objType < 0 || objType >= 4 || g_mock_state.objects[objType].empty()) return NULL;
+    return &g_mock_state.objects[objType];
+}
+
 extern "C" int swmm_getCount(int objType)
 {
     g_mock_state.getCount_call_count++;
     g_mock_state.last_getCount_type = objType;
-    return g_mock_state.getCount_return_value;
+    const std::vector<std::string>* names = MockObjects(objType);
+    return names ? (int)names->size() : g_mock_state.getCount_return_value;
+}
+
+extern "C" int swmm_getIndex(int objType, const char* name)
+{
+    g_mock_state.getIndex_call_count++;
+    if (!name) return -1;
+    const std::vector<std::string>* names = MockObjects(objType);
+    if (!names) return g_mock_state.getIndex_return_value;
+    for (size_t i = 0; i < names->size(); i++) {
+        // SWMM IDs are case-insensitive
+        const std::string& id = (*names)[i];
+        size_t k = 0;
+        while (k < id.size() && name[k] && toupper((unsigned char)id[k]) == toupper((unsigned char)name[k])) k++;
+        if (k == id.size() && name[k] == '\0') return (int)i;
+    }
+    return -1;
+}
+
+extern "C" void swmm_getName(int objType, int index, char* name, int size)
+{
+    g_mock_state.getName_call_count++;
+    if (!name || size <= 0) return;
+    name[0] = '\0';
+    const std::vector<std::string>* names = MockObjects(objType);
+    if (names && index >= 0 && index < (int)names->size()) {
+        strncpy(name, (*names)[index].c_str(), size - 1);
+        name[size - 1] = '\0';
+    }
+}
+
+// The mock's state snapshot is its elapsed time at the save; restoring it only
+// checks the size, since the bridge moves the start date to the snapshot date
+extern "C" int swmm_getStateSize(void)
+{
+    return (int)sizeof(double);
+}
+
+extern "C" int swmm_saveState(char* buffer, int size, double* stateDate)
+{
+    g_mock_state.saveState_call_count++;
+    if (!buffer || size < (int)sizeof(double)) return -1;
+    memcpy(buffer, &g_mock_state.last_step_elapsed_time, sizeof(double));
+    if (stateDate) *stateDate = 40000.0 + g_mock_state.last_step_elapsed_time / 86400.0;
+    return (int)sizeof(double);
+}
+
+extern "C" int swmm_loadState(const char* buffer, int size)
+{
+    g_mock_state.loadState_call_count++;
+    if (!buffer || size != (int)sizeof(double)) return -1;
+    return 0;
 }
@@ -26,6 +26,12 @@ struct SwmmMockState {
     int setValue_call_count;
     int getError_call_count;
     int getCount_call_count;
+    int getValues_call_count;
+    int setValues_call_count;
+    int getIndex_call_count;
+    int getName_call_count;
+    int saveState_call_count;
+    int loadState_call_count;
     
     // Parameter tracking for last call
     std::string last_input_file;
@@ -49,6 +55,10 @@ struct SwmmMockState {
     double getValue_return_value;
     std::string error_message;
     int getCount_return_value;
+    int getIndex_return_value;
+    std::vector<std::string> objects[4];   // named objects per swmm_Object type (GAGE..LINK)
+    std::vector<double> rpt_flags[4];      // last *_RPTFLAG value per object type and index (-1 = never set)
+    int rpt_flags_after_start;             // *_RPTFLAG writes SWMM would ignore
     
     // Step behavior configuration
     int step_calls_until_end;  // Return >0 after this many calls (0 = never end)
@@ -91,6 +101,13 @@ void SwmmMock_SetGetValueReturn(double value);
 // Configure getCount return value
 void SwmmMock_SetGetCountReturn(int count);
 
+// Configure getIndex return value (the index every name resolves to)
+void SwmmMock_SetGetIndexReturn(int index);
+
+// Register a named object. Once a type has objects, swmm_getCount,
+// swmm_getName and swmm_getIndex answer from this list for that type.
+void SwmmMock_AddObject(int objType, const char* name);
+
 // Get call counts for verification
 int SwmmMock_GetOpenCallCount();
 int SwmmMock_GetStartCallCount();
@@ -99,6 +116,12 @@ int SwmmMock_GetEndCallCount();
 int SwmmMock_GetCloseCallCount();
 int SwmmMock_GetValueCallCount();
 int SwmmMock_GetSetValueCallCount();
+int SwmmMock_GetValuesCallCount();
+int SwmmMock_GetSetValuesCallCount();
+int SwmmMock_GetIndexCallCount();
+int SwmmMock_GetNameCallCount();
+int SwmmMock_GetSaveStateCallCount();
+int SwmmMock_GetLoadStateCallCount();
 
 // Get last call parameters for verification
 const char* SwmmMock_GetLastInputFile();
@@ -110,6 +133,8 @@ int SwmmMock_GetLastGetValueIndex();
 int SwmmMock_GetLastSetValueType();
 int SwmmMock_GetLastSetValueIndex();
 double SwmmMock_GetLastSetValueValue();
+double SwmmMock_GetReportFlag(int objType, int index);   // -1 if never set
+int SwmmMock_GetLateReportFlagCount();
 
 //-----------------------------------------------------------------------------
 // Mock SWMM API Functions
@@ -126,13 +151,22 @@ int swmm_end();
 int swmm_close();
 void swmm_setValue(int type, int index, double value);
 double swmm_getValue(int type, int index);
+int swmm_getValues(const int* props, const int* indexes, int n, double* values);
+int swmm_setValues(const int* props, const int* indexes, int n, const double* values);
 int swmm_getError(char* errMsg, int msgLen);
 int swmm_getCount(int objType);
+int swmm_getIndex(int objType, const char* name);
+void swmm_getName(int objType, int index, char* name, int size);
+int swmm_getStateSize(void);
+int swmm_saveState(char* buffer, int size, double* stateDate);
+int swmm_loadState(const char* buffer, int size);
 
 // LID API stub control functions
 void SwmmLidStub_Initialize(int subcatchCount);
 void SwmmLidStub_AddLidUnit(int subcatchIndex, const char* controlName, double initialVolume);
+void SwmmLidStub_SetSurfaceOutflow(int subcatchIndex, int lidIndex, double outflow);
 void SwmmLidStub_Cleanup();
+int SwmmLidStub_GetNameCallCount();
 const char* SwmmLidStub_GetLastError();
 
 #ifdef __cplusplus
@@ -4,6 +4,7 @@
 #include <string>
 #include <fstream>
 #include <cstdio>
+#include <vector>
 
 /**
  * SWMM Test Model Generator
@@ -278,6 +279,356 @@ inline bool CreateModelMissingElement(const std::string& filename, const std::st
     return true;
 }
 
+/**
+ * Rainfall time series shapes for CreateNetworkModel()
+ */
+enum RainPattern {
+    RAIN_BLOCK,      // constant intensity for the storm duration
+    RAIN_TRIANGLE,   // linear rise to a peak at one third of the storm, then linear fall
+    RAIN_MOVING      // triangle, delayed gage by gage as if the storm crosses the network
+};
+
+/**
+ * Parameters of a synthetic network for scaling benchmarks
+ *
+ * Every subcatchment drains to its own inlet node. The inlet nodes form a
+ * tree under a single outfall, at most `depth` levels deep, and each node
+ * joins its parent through one link. Percentages are applied
+ * deterministically by element number, so the same spec always gives the
+ * same file.
+ */
+struct NetworkSpec {
+    int subcatchments;       // also the number of inlet nodes and tree links
+    int depth;               // levels of the tree below the outfall
+    bool looped;             // add conduits between neighbouring nodes of a level
+    int loop_percent;        // share of nodes with such a cross conduit
+    int storage_percent;     // share of nodes that are storage units instead of junctions
+    int pump_percent;        // share of tree links that are pumps,
+    int orifice_percent;     //   orifices
+    int weir_percent;        //   or weirs instead of conduits
+    int lid_percent;         // share of subcatchments with a bioretention cell
+    int rain_gages;
+    RainPattern rain;
+    double duration_hours;
+    std::string routing;     // "DYNWAVE" or "KINWAVE"; looped networks are always DYNWAVE
+
+    // What CreateNetworkMapping() maps
+    bool map_subcatchments;  // RUNOFF
+    bool map_nodes;          // DEPTH, and FLOW at the outfall
+    bool map_links;          // FLOW
+    bool map_lid;            // STORAGE_VOLUME of each bioretention cell
+    bool map_controls;       // SETTING of each pump, orifice and weir, as inputs
+
+    explicit NetworkSpec(int count = 100)
+        : subcatchments(count), depth(8), looped(false), loop_percent(10), storage_percent(10),
+          pump_percent(2), orifice_percent(4), weir_percent(4), lid_percent(20), rain_gages(4),
+          rain(RAIN_TRIANGLE), duration_hours(6.0), routing("DYNWAVE"),
+          map_subcatchments(true), map_nodes(true), map_links(true), map_lid(true), map_controls(false) {
+    }
+};
+
+/**
+ * Element layout shared by CreateNetworkModel() and CreateNetworkMapping()
+ */
+struct NetworkLayout {
+    enum LinkKind { CONDUIT, PUMP, ORIFICE, WEIR };
+
+    int branching;                   // children per node
+    std::vector<int> parent;         // node -> parent node, -1 = outfall
+    std::vector<int> level;          // node -> 1 (drains to the outfall) .. depth
+    std::vector<bool> storage;       // node is a storage unit
+    std::vector<LinkKind> link;      // tree link from node k to its parent
+    std::vector<int> cross;          // nodes with a cross conduit to node k + 1
+    std::vector<bool> lid;           // subcatchment has a bioretention cell
+
+    explicit NetworkLayout(const NetworkSpec& spec) {
+        int n = spec.subcatchments > 0 ? spec.subcatchments : 0;
+        int depth = spec.depth > 0 ? spec.depth : 1;
+
+        // Smallest branching factor whose tree of `depth` levels holds n nodes
+        branching = 2;
+        for (;;) {
+            double capacity = 0.0, width = 1.0;
+            for (int l = 0; l < depth; l++) {
+                width *= branching;
+                capacity += width;
+            }
+            if (capacity >= n || branching >= n) break;
+            branching++;
+        }
+
+        // Heap layout: the outfall's children are nodes 0..b-1, node k's are b(k+1)..b(k+1)+b-1
+        parent.resize(n);
+        level.resize(n);
+        storage.resize(n);
+        link.resize(n);
+        lid.resize(n);
+        int pumps = spec.pump_percent, orifices = pumps + spec.orifice_percent, weirs = orifices + spec.weir_percent;
+        for (int k = 0; k < n; k++) {
+            parent[k] = k / branching - 1;
+            level[k] = parent[k] < 0 ? 1 : level[parent[k]] + 1;
+            storage[k] = k % 100 < spec.storage_percent;
+            int r = (k * 37) % 100;   // decorrelated from the storage share
+            link[k] = r < pumps ? PUMP : r < orifices ? ORIFICE : r < weirs ? WEIR : CONDUIT;
+            lid[k] = (k * 53) % 100 < spec.lid_percent;
+        }
+        if (spec.looped) {
+            for (int k = 0; k + 1 < n; k++) {
+                if (level[k] == level[k + 1] && (k * 71) % 100 < spec.loop_percent) cross.push_back(k);
+            }
+        }
+    }
+
+    std::string NodeName(int k) const {
+        return (storage[k] ? "ST" : "J") + std::to_string(k);
+    }
+
+    std::string ParentName(int k) const {
+        return parent[k] < 0 ? "OF1" : NodeName(parent[k]);
+    }
+
+    std::string LinkName(int k) const {
+        static const char* prefix[] = { "C", "P", "OR", "W" };
+        return prefix[link[k]] + std::to_string(k);
+    }
+
+    static int GageOf(const NetworkSpec& spec, int subcatch) {
+        int gages = spec.rain_gages > 0 ? spec.rain_gages : 1;
+        return (int)((long long)subcatch * gages / spec.subcatchments) + 1;
+    }
+};
+
+/**
+ * Generate a synthetic network model of any size (see NetworkSpec)
+ *
+ * Elements created:
+ * - Rain gages: RG1..RGn, each with its own time series TS1..TSn
+ * - Subcatchments: S0..S(N-1), draining to inlet node k
+ * - Inlet nodes: Jk (junction) or STk (storage), and outfall OF1
+ * - Tree links: Ck (conduit), Pk (pump), ORk (orifice) or Wk (weir) from node k to its parent
+ * - Cross conduits: Xk from node k to node k + 1 (looped networks)
+ * - LID control BioCell, one unit in each selected subcatchment
+ */
+inline bool CreateNetworkModel(const std::string& filename, const NetworkSpec& spec) {
+    std::ofstream file(filename);
+    if (!file.is_open() || spec.subcatchments < 1) return false;
+    NetworkLayout net(spec);
+    const int n = spec.subcatchments;
+    const int gages = spec.rain_gages > 0 ? spec.rain_gages : 1;
+    const bool dynwave = spec.looped || spec.routing != "KINWAVE";
+    const double node_drop = 0.5;   // ft per level over a 400 ft link
+
+    int minutes = (int)(spec.duration_hours * 60.0 + 0.5);
+    if (minutes < 5) minutes = 5;
+    if (minutes > 27 * 1440) minutes = 27 * 1440;
+    char end_date[16], end_time[16];
+    snprintf(end_date, sizeof(end_date), "01/%02d/2024", 1 + minutes / 1440);
+    snprintf(end_time, sizeof(end_time), "%02d:%02d:00", (minutes % 1440) / 60, minutes % 60);
+
+    file << "[TITLE]\n";
+    file << "Synthetic network: " << n << " subcatchments, depth " << spec.depth
+         << (spec.looped ? ", looped" : ", dendritic") << "\n\n";
+
+    file << "[OPTIONS]\n";
+    file << "FLOW_UNITS           CFS\n";
+    file << "INFILTRATION         HORTON\n";
+    file << "FLOW_ROUTING         " << (dynwave ? "DYNWAVE" : "KINWAVE") << "\n";
+    file << "START_DATE           01/01/2024\n";
+    file << "START_TIME           00:00:00\n";
+    file << "REPORT_START_DATE    01/01/2024\n";
+    file << "REPORT_START_TIME    00:00:00\n";
+    file << "END_DATE             " << end_date << "\n";
+    file << "END_TIME             " << end_time << "\n";
+    file << "REPORT_STEP          00:05:00\n";
+    file << "WET_STEP             00:01:00\n";
+    file << "DRY_STEP             01:00:00\n";
+    file << "ROUTING_STEP         0:00:30\n";
+    file << "ALLOW_PONDING        NO\n";
+    file << "INERTIAL_DAMPING     PARTIAL\n";
+    file << "VARIABLE_STEP        0.75\n";
+    file << "NORMAL_FLOW_LIMITED  BOTH\n";
+    file << "LINK_OFFSETS         DEPTH\n\n";
+
+    file << "[RAINGAGES]\n";
+    for (int g = 1; g <= gages; g++) file << "RG" << g << "  INTENSITY 0:05 1.0 TIMESERIES TS" << g << "\n";
+    file << "\n";
+
+    file << "[SUBCATCHMENTS]\n";
+    for (int i = 0; i < n; i++)
+        file << "S" << i << "  RG" << NetworkLayout::GageOf(spec, i) << "  " << net.NodeName(i)
+             << "  5.0  50  500  0.5  0\n";
+    file << "\n";
+
+    file << "[SUBAREAS]\n";
+    for (int i = 0; i < n; i++) file << "S" << i << "  0.01  0.1  0.05  0.05  25  OUTLET\n";
+    file << "\n";
+
+    file << "[INFILTRATION]\n";
+    for (int i = 0; i < n; i++) file << "S" << i << "  3.0  0.5  4  7  0\n";
+    file << "\n";
+
+    file << "[LID_CONTROLS]\n";
+    file << "BioCell  BC\n";
+    file << "BioCell  SURFACE  6  0.0  0.1  1.0  5\n";
+    file << "BioCell  SOIL     12  0.5  0.2  0.1  0.5  10.0  3.5\n";
+    file << "BioCell  STORAGE  12  0.75  0.5  0\n";
+    file << "BioCell  DRAIN    0.5  0.5  6  6\n\n";
+
+    file << "[LID_USAGE]\n";
+    for (int i = 0; i < n; i++) {
+        if (net.lid[i]) file << "S" << i << "  BioCell  1  2000  40  0  50  0\n";
+    }
+    file << "\n";
+
+    file << "[JUNCTIONS]\n";
+    for (int k = 0; k < n; k++) {
+        if (!net.storage[k]) file << "J" << k << "  " << node_drop * net.level[k] << "  10  0  0  0\n";
+    }
+    file << "\n";
+
+    file << "[OUTFALLS]\n";
+    file << "OF1  0  FREE  NO\n\n";
+
+    file << "[STORAGE]\n";
+    for (int k = 0; k < n; k++) {
+        if (net.storage[k]) file << "ST" << k << "  " << node_drop * net.level[k] << "  10  0  FUNCTIONAL 1000  0  0  0  0\n";
+    }
+    file << "\n";
+
+    std::string xsections;
+    file << "[CONDUITS]\n";
+    for (int k = 0; k < n; k++) {
+        if (net.link[k] != NetworkLayout::CONDUIT) continue;
+        file << "C" << k << "  " << net.NodeName(k) << "  " << net.ParentName(k) << "  400  0.013  0  0  0  0\n";
+        xsections += "C" + std::to_string(k) + "  CIRCULAR  2  0  0  0  1\n";
+    }
+    for (int k : net.cross) {
+        file << "X" << k << "  " << net.NodeName(k) << "  " << net.NodeName(k + 1)
+             << "  400  0.013  0  0  0  0\n";
+        xsections += "X" + std::to_string(k) + "  CIRCULAR  1  0  0  0  1\n";
+    }
+    file << "\n";
+
+    file << "[PUMPS]\n";
+    for (int k = 0; k < n; k++) {
+        if (net.link[k] != NetworkLayout::PUMP) continue;
+        file << "P" << k << "  " << net.NodeName(k) << "  " << net.ParentName(k) << "  PumpCurve  ON  0  0\n";
+    }
+    file << "\n";
+
+    file << "[ORIFICES]\n";
+    for (int k = 0; k < n; k++) {
+        if (net.link[k] != NetworkLayout::ORIFICE) continue;
+        file << "OR" << k << "  " << net.NodeName(k) << "  " << net.ParentName(k) << "  SIDE  0  0.65  NO  0\n";
+        xsections += "OR" + std::to_string(k) + "  CIRCULAR  1  0  0  0\n";
+    }
+    file << "\n";
+
+    file << "[WEIRS]\n";
+    for (int k = 0; k < n; k++) {
+        if (net.link[k] != NetworkLayout::WEIR) continue;
+        file << "W" << k << "  " << net.NodeName(k) << "  " << net.ParentName(k) << "  TRANSVERSE  0  3.33  NO  0  0  YES\n";
+        xsections += "W" + std::to_string(k) + "  RECT_OPEN  2  4  0  0\n";
+    }
+    file << "\n";
+
+    file << "[XSECTIONS]\n" << xsections << "\n";
+
+    file << "[CURVES]\n";
+    file << "PumpCurve  Pump2  0  5\n";
+    file << "PumpCurve         4  10\n\n";
+
+    // Storm over the first half of the run, in 5-minute intervals
+    file << "[TIMESERIES]\n";
+    int storm = minutes / 2 / 5 * 5;
+    if (storm < 10) storm = 10;
+    for (int g = 1; g <= gages; g++) {
+        int delay = spec.rain == RAIN_MOVING ? (g - 1) * storm / (2 * gages) / 5 * 5 : 0;
+        int peak = delay + storm / 3;
+        for (int t = 0; t <= minutes; t += 5) {
+            double v = 0.0;
+            if (spec.rain == RAIN_BLOCK) {
+                v = t < storm ? 1.0 : 0.0;
+            } else if (t >= delay && t < delay + storm) {
+                v = t <= peak ? 2.0 * (t - delay) / (peak - delay) : 2.0 * (delay + storm - t) / (delay + storm - peak);
+            }
+            file << "TS" << g << "  " << t / 60 << ":" << (t % 60 < 10 ? "0" : "") << t % 60 << "  " << v << "\n";
+        }
+    }
+    file << "\n";
+
+    file << "[REPORT]\n";
+    file << "INPUT      NO\n";
+    file << "CONTROLS   NO\n\n";
+
+    file.close();
+    return !file.fail();
+}
+
+/**
+ * Generate SwmmGoldSimBridge.json for a CreateNetworkModel() network
+ *
+ * Inputs are ElapsedTime, the rainfall of every gage and, with map_controls,
+ * the setting of every pump, orifice and weir. Outputs follow the map_* flags.
+ */
+inline bool CreateNetworkMapping(const std::string& filename, const NetworkSpec& spec,
+                                 const std::string& logging_level = "OFF") {
+    std::ofstream file(filename);
+    if (!file.is_open() || spec.subcatchments < 1) return false;
+    NetworkLayout net(spec);
+    const int n = spec.subcatchments;
+    static const char* link_type[] = { "CONDUIT", "PUMP", "ORIFICE", "WEIR" };
+    static const char* control_type[] = { "", "PUMP", "ORIFICE", "WEIR" };
+
+    std::vector<std::string> inputs, outputs;
+    inputs.push_back("\"name\": \"ElapsedTime\", \"object_type\": \"SYSTEM\", \"property\": \"ELAPSEDTIME\"");
+    for (int g = 1; g <= (spec.rain_gages > 0 ? spec.rain_gages : 1); g++)
+        inputs.push_back("\"name\": \"RG" + std::to_string(g) + "\", \"object_type\": \"GAGE\", \"property\": \"RAINFALL\"");
+    if (spec.map_controls) {
+        for (int k = 0; k < n; k++) {
+            if (net.link[k] != NetworkLayout::CONDUIT)
+                inputs.push_back("\"name\": \"" + net.LinkName(k) + "\", \"object_type\": \"" +
+                                 control_type[net.link[k]] + "\", \"property\": \"SETTING\"");
+        }
+    }
+    if (spec.map_subcatchments) {
+        for (int i = 0; i < n; i++)
+            outputs.push_back("\"name\": \"S" + std::to_string(i) + "\", \"object_type\": \"SUBCATCH\", \"property\": \"RUNOFF\"");
+    }
+    if (spec.map_nodes) {
+        for (int k = 0; k < n; k++)
+            outputs.push_back("\"name\": \"" + net.NodeName(k) + "\", \"object_type\": \"" +
+                              (net.storage[k] ? "STORAGE" : "JUNCTION") + "\", \"property\": \"DEPTH\"");
+        outputs.push_back("\"name\": \"OF1\", \"object_type\": \"OUTFALL\", \"property\": \"FLOW\"");
+    }
+    if (spec.map_links) {
+        for (int k = 0; k < n; k++)
+            outputs.push_back("\"name\": \"" + net.LinkName(k) + "\", \"object_type\": \"" +
+                              link_type[net.link[k]] + "\", \"property\": \"FLOW\"");
+        for (int k : net.cross)
+            outputs.push_back("\"name\": \"X" + std::to_string(k) + "\", \"object_type\": \"CONDUIT\", \"property\": \"FLOW\"");
+    }
+    if (spec.map_lid) {
+        for (int i = 0; i < n; i++) {
+            if (net.lid[i])
+                outputs.push_back("\"name\": \"S" + std::to_string(i) + "/BioCell\", \"object_type\": \"LID\", \"property\": \"STORAGE_VOLUME\"");
+        }
+    }
+
+    file << "{\n  \"version\": \"1.0\",\n  \"logging_level\": \"" << logging_level << "\",\n";
+    file << "  \"input_count\": " << inputs.size() << ",\n  \"output_count\": " << outputs.size() << ",\n";
+    file << "  \"inputs\": [\n";
+    for (size_t i = 0; i < inputs.size(); i++)
+        file << "    {\"index\": " << i << ", " << inputs[i] << "}" << (i + 1 < inputs.size() ? ",\n" : "\n");
+    file << "  ],\n  \"outputs\": [\n";
+    for (size_t i = 0; i < outputs.size(); i++)
+        file << "    {\"index\": " << i << ", " << outputs[i] << "}" << (i + 1 < outputs.size() ? ",\n" : "\n");
+    file << "  ]\n}\n";
+
+    file.close();
+    return !file.fail();
+}
+
 /**
  * Test fixture class for managing SWMM test files
  * Automatically creates and cleans up test files
@@ -319,6 +670,10 @@ public:
         return CreateModelMissingElement(model_file, element);
     }
 
+    bool CreateNetwork(const NetworkSpec& spec) {
+        return CreateNetworkModel(model_file, spec);
+    }
+
     void Cleanup() {
         std::remove(model_file.c_str());
         std::remove(report_file.c_str());
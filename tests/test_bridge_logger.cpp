@@ -0,0 +1,98 @@
+//-----------------------------------------------------------------------------
+//   test_bridge_logger.cpp
+//
+//   Unit tests for BridgeLogger (asynchronous ring-buffer logger)
+//   Tests: record formatting, guaranteed flush, drop counting, restart
+//-----------------------------------------------------------------------------
+
+#include "../include/BridgeLogger.h"
+#include "gtest_minimal.h"
+#include <fstream>
+#include <string>
+
+static void LogTo(BridgeLogger& logger, const char* tag, const char* fmt, ...) {
+    va_list ap; va_start(ap, fmt); logger.Write(tag, fmt, ap); va_end(ap);
+}
+
+static int CountLines(const char* path, const std::string& needle) {
+    std::ifstream file(path);
+    std::string line;
+    int count = 0;
+    while (std::getline(file, line)) {
+        if (line.find(needle) != std::string::npos) count++;
+    }
+    return count;
+}
+
+TEST(BridgeLoggerTests, FlushWritesHeaderAndRecords) {
+    const char* path = "test_logger_flush.log";
+    BridgeLogger logger(path, "Logger Test Header");
+    LogTo(logger, "INFO ", "value=%d", 42);
+    LogTo(logger, "ERROR", "name=%s", "POND");
+    logger.Flush();
+
+    EXPECT_EQ(CountLines(path, "Logger Test Header"), 1);
+    EXPECT_EQ(CountLines(path, "[INFO ] value=42"), 1);
+    EXPECT_EQ(CountLines(path, "[ERROR] name=POND"), 1);
+    EXPECT_EQ(logger.GetWrittenCount(), 2ULL);
+    EXPECT_EQ(logger.GetDroppedCount(), 0ULL);
+    logger.Shutdown();
+    remove(path);
+}
+
+TEST(BridgeLoggerTests, ShutdownFlushesAndRestartAppends) {
+    const char* path = "test_logger_restart.log";
+    BridgeLogger logger(path, "Header");
+    for (int i = 0; i < 1000; i++) LogTo(logger, "DEBUG", "record %d", i);
+    logger.Shutdown();
+    EXPECT_EQ(CountLines(path, "record "), 1000);
+
+    // Writer restarts lazily and appends rather than truncating
+    LogTo(logger, "INFO ", "after restart");
+    logger.Shutdown();
+    EXPECT_EQ(CountLines(path, "record "), 1000);
+    EXPECT_EQ(CountLines(path, "after restart"), 1);
+    EXPECT_EQ(CountLines(path, "Header"), 1);
+    remove(path);
+}
+
+TEST(BridgeLoggerTests, OverflowDropsAndReports) {
+    const char* path = "test_logger_overflow.log";
+    BridgeLogger logger(path, "Header");
+    // Far more records than the ring holds, faster than the writer's interval
+    const int total = BridgeLogger::kCapacity * 8;
+    for (int i = 0; i < total; i++) LogTo(logger, "DEBUG", "burst %d", i);
+    logger.Shutdown();
+
+    unsigned long long written = logger.GetWrittenCount();
+    unsigned long long dropped = logger.GetDroppedCount();
+    EXPECT_EQ(written + dropped, (unsigned long long)total);
+    EXPECT_EQ(CountLines(path, "burst "), (int)written);
+    if (dropped > 0) {
+        EXPECT_GE(CountLines(path, "records dropped"), 1);
+    }
+    remove(path);
+}
+
+TEST(BridgeLoggerTests, LongMessagesAreTruncated) {
+    const char* path = "test_logger_truncate.log";
+    BridgeLogger logger(path, "");
+    std::string big(BridgeLogger::kRecordSize * 2, 'x');
+    LogTo(logger, "INFO ", "%s", big.c_str());
+    LogTo(logger, "INFO ", "next");
+    logger.Shutdown();
+
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    EXPECT_EQ((int)line.size(), BridgeLogger::kRecordSize - 1);
+    std::getline(file, line);
+    EXPECT_TRUE(line.find("next") != std::string::npos);
+    file.close();
+    remove(path);
+}
+
+int main() {
+    std::cout << "=== BridgeLogger Tests ===" << std::endl;
+    return RUN_ALL_TESTS();
+}
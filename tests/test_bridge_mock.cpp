@@ -0,0 +1,709 @@
+//-----------------------------------------------------------------------------
+//   test_bridge_mock.cpp
+//
+//   Runs SwmmGoldSimBridge against the SWMM mock, linked in-process
+//   Tests: GoldSim protocol, optional export binding, error string passing,
+//          resolved plan reuse and SwmmGoldSimBridge.plan, LID name index,
+//          bulk element name index and near-miss suggestions, output policy,
+//          series recording, project recycling, hot-start snapshot
+//          invalidation, call trace record and replay, timeline spans
+//-----------------------------------------------------------------------------
+
+#include "../include/Platform.h"
+#include "../include/CallTrace.h"
+#include "../include/SeriesReader.h"
+#include "gtest_minimal.h"
+#include "swmm_mock.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#define XF_INITIALIZE       0
+#define XF_CALCULATE        1
+#define XF_REP_VERSION      2
+#define XF_REP_ARGUMENTS    3
+#define XF_CLEANUP          99
+
+#define XF_SUCCESS              0
+#define XF_FAILURE              1
+#define XF_FAILURE_WITH_MSG    -1
+
+extern "C" void SwmmGoldSimBridge(int methodID, int* status, double* inargs, double* outargs);
+
+static void WriteMapping() {
+    std::ofstream f("SwmmGoldSimBridge.json");
+    f << R"({
+  "version": "1.0",
+  "logging_level": "OFF",
+  "inputs": [
+    {"index": 0, "name": "ElapsedTime", "object_type": "SYSTEM", "property": "ELAPSEDTIME"},
+    {"index": 1, "name": "RG1", "object_type": "GAGE", "property": "RAINFALL"}
+  ],
+  "outputs": [
+    {"index": 0, "name": "S1", "object_type": "SUBCATCH", "property": "RUNOFF"}
+  ]
+})";
+}
+
+static std::string ReadBytes(const char* path) {
+    std::ifstream f(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+static void WriteBytes(const char* path, const std::string& bytes) {
+    std::ofstream f(path, std::ios::binary);
+    f << bytes;
+}
+
+static int CountOf(const std::string& text, const std::string& what) {
+    int n = 0;
+    for (size_t pos = text.find(what); pos != std::string::npos; pos = text.find(what, pos + 1)) n++;
+    return n;
+}
+
+// Four outputs on two LID units of one subcatchment
+static void WriteLidMapping() {
+    std::ofstream f("SwmmGoldSimBridge.json");
+    f << R"({
+  "version": "1.0",
+  "logging_level": "OFF",
+  "plan_cache": false,
+  "inputs": [
+    {"index": 0, "name": "ElapsedTime", "object_type": "SYSTEM", "property": "ELAPSEDTIME"},
+    {"index": 1, "name": "RG1", "object_type": "GAGE", "property": "RAINFALL"}
+  ],
+  "outputs": [
+    {"index": 0, "name": "S1/Planter", "object_type": "LID", "property": "STORAGE_VOLUME"},
+    {"index": 1, "name": "S1/Planter", "object_type": "LID", "property": "SURFACE_OUTFLOW"},
+    {"index": 2, "name": "S1/Barrel", "object_type": "LID", "property": "STORAGE_VOLUME"},
+    {"index": 3, "name": "S1/Barrel", "object_type": "LID", "property": "DRAIN_FLOW"}
+  ]
+})";
+}
+
+static void ResetMock() {
+    WriteMapping();
+    if (!std::ifstream("model.inp")) WriteBytes("model.inp", "[TITLE]\nMock model\n");   // swmm_open needs a file
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    SwmmLidStub_Initialize(1);
+}
+
+TEST(BridgeMockTests, ReportsVersionAndArguments) {
+    ResetMock();
+    int status;
+    double inargs[2] = {0}, outargs[2] = {0};
+
+    SwmmGoldSimBridge(XF_REP_VERSION, &status, inargs, outargs);
+    EXPECT_EQ(status, XF_SUCCESS);
+    EXPECT_GT(outargs[0], 5.0);
+
+    SwmmGoldSimBridge(XF_REP_ARGUMENTS, &status, inargs, outargs);
+    EXPECT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(outargs[0], 2.0);
+    EXPECT_EQ(outargs[1], 1.0);
+}
+
+TEST(BridgeMockTests, RealizationAppliesInputsAndReadsOutputs) {
+    ResetMock();
+    SwmmMock_SetGetValueReturn(5.5);
+    int status;
+    double inargs[2] = {0.0, 2.5}, outargs[1] = {0};
+
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetOpenCallCount(), 1);
+    EXPECT_EQ(SwmmMock_GetStartCallCount(), 1);
+
+    // First call reports initial outputs; the second applies the stored rainfall
+    SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetStepCallCount(), 0);
+    inargs[0] = 300.0;
+    SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetStepCallCount(), 1);
+    EXPECT_EQ(SwmmMock_GetSetValueCallCount(), 1);
+    EXPECT_EQ(SwmmMock_GetLastSetValueValue(), 2.5);
+    EXPECT_EQ(outargs[0], 5.5);
+#ifndef _WIN32
+    // The batched exports are found through the platform module lookup
+    EXPECT_EQ(SwmmMock_GetSetValuesCallCount(), 1);
+    EXPECT_EQ(SwmmMock_GetValuesCallCount(), 2);
+#endif
+
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    EXPECT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetEndCallCount(), 1);
+    EXPECT_EQ(SwmmMock_GetCloseCallCount(), 1);
+}
+
+TEST(BridgeMockTests, OpenFailurePassesErrorString) {
+    ResetMock();
+    SwmmMock_SetOpenFailure(200, "Mock open error");
+    int status;
+    double inargs[2] = {0}, outargs[2] = {0};
+
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_FAILURE_WITH_MSG);
+    const char* msg = (const char*)*(ULONG_PTR*)outargs;
+    EXPECT_STREQ(msg, "Mock open error");
+    EXPECT_EQ(SwmmMock_GetStartCallCount(), 0);
+
+    SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);
+    EXPECT_EQ(status, XF_FAILURE);
+}
+
+TEST(BridgeMockTests, ResolvedPlanIsReusedAndCached) {
+    std::remove("SwmmGoldSimBridge.plan");
+    WriteBytes("model.inp", "[TITLE]\nMock model A\n");
+    int status;
+    double inargs[2] = {0}, outargs[1] = {0};
+
+    // The first realization resolves names and writes the plan
+    ResetMock();
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetIndexCallCount(), 2);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    std::string plan_a = ReadBytes("SwmmGoldSimBridge.plan");
+    ASSERT_FALSE(plan_a.empty());
+
+    // Later realizations in the same process reuse the resolved indices
+    ResetMock();
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetIndexCallCount(), 0);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+
+    // An edited model is resolved again and the plan replaced
+    WriteBytes("model.inp", "[TITLE]\nMock model B\n");
+    ResetMock();
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetIndexCallCount(), 2);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    EXPECT_TRUE(ReadBytes("SwmmGoldSimBridge.plan") != plan_a);
+
+    // Back on model A with its plan: no JSON parse, no name lookups
+    WriteBytes("model.inp", "[TITLE]\nMock model A\n");
+    WriteBytes("SwmmGoldSimBridge.plan", plan_a);
+    ResetMock();
+    SwmmMock_SetGetValueReturn(4.25);
+    SwmmGoldSimBridge(XF_REP_ARGUMENTS, &status, inargs, outargs);
+    EXPECT_EQ(outargs[0], 2.0);
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetIndexCallCount(), 0);
+    SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(outargs[0], 4.25);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+
+    std::remove("SwmmGoldSimBridge.plan");
+    std::remove("model.inp");
+}
+
+TEST(BridgeMockTests, LidNamesAreIndexedOncePerSubcatchment) {
+    WriteBytes("model.inp", "[TITLE]\nLID name index\n");   // new model: mapping is reloaded
+    WriteLidMapping();
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    SwmmLidStub_Initialize(1);
+    SwmmLidStub_AddLidUnit(0, "Barrel", 1.0);
+    SwmmLidStub_AddLidUnit(0, "Trench", 2.0);
+    SwmmLidStub_AddLidUnit(0, "Planter", 3.0);
+    int status;
+    double inargs[2] = {0}, outargs[4] = {0};
+
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmLidStub_GetNameCallCount(), 3);   // one per unit, not per unit and output
+
+    SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_DOUBLE_EQ(outargs[0], 3.0);
+    EXPECT_DOUBLE_EQ(outargs[2], 1.0);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    std::remove("model.inp");
+}
+
+TEST(BridgeMockTests, DuplicateLidControlIsAnError) {
+    WriteBytes("model.inp", "[TITLE]\nDuplicate LID controls\n");
+    WriteLidMapping();
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    SwmmLidStub_Initialize(1);
+    SwmmLidStub_AddLidUnit(0, "Planter", 1.0);
+    SwmmLidStub_AddLidUnit(0, "Barrel", 2.0);
+    SwmmLidStub_AddLidUnit(0, "Planter", 3.0);
+    int status;
+    double inargs[2] = {0}, outargs[4] = {0};
+
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_FAILURE_WITH_MSG);
+    std::string msg = (const char*)*(ULONG_PTR*)outargs;
+    EXPECT_TRUE(msg.find("Duplicate LID control 'Planter' in subcatchment 'S1'") != std::string::npos);
+    std::remove("model.inp");
+}
+
+static void WriteOutfallMapping(const char* outfall) {
+    std::ofstream f("SwmmGoldSimBridge.json");
+    f << "{\"version\": \"1.0\", \"logging_level\": \"OFF\", \"plan_cache\": false,\n"
+         " \"inputs\": [{\"index\": 0, \"name\": \"RG1\", \"object_type\": \"GAGE\", \"property\": \"RAINFALL\"}],\n"
+         " \"outputs\": [{\"index\": 0, \"name\": \"j2\", \"object_type\": \"JUNCTION\", \"property\": \"DEPTH\"},\n"
+         "             {\"index\": 1, \"name\": \"" << outfall << "\", \"object_type\": \"OUTFALL\", \"property\": \"FLOW\"}]}";
+}
+
+static void AddMockNetwork() {
+    SwmmMock_AddObject(swmm_GAGE, "RG1");
+    SwmmMock_AddObject(swmm_NODE, "J1");
+    SwmmMock_AddObject(swmm_NODE, "J2");
+    SwmmMock_AddObject(swmm_NODE, "OUT1");
+}
+
+TEST(BridgeMockTests, NamesResolveThroughBulkIndex) {
+    WriteBytes("model.inp", "[TITLE]\nBulk name index\n");
+    WriteOutfallMapping("OUT1");
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    AddMockNetwork();
+    int status;
+    double inargs[1] = {0}, outargs[2] = {0};
+
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetIndexCallCount(), 0);
+    EXPECT_EQ(SwmmMock_GetNameCallCount(), 4);   // one gage and three nodes, each named once
+
+    SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetLastGetValueIndex(), 2);   // OUT1, read last
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    std::remove("model.inp");
+}
+
+TEST(BridgeMockTests, UnknownNameSuggestsNearMiss) {
+    WriteBytes("model.inp", "[TITLE]\nTypo in the mapping\n");
+    WriteOutfallMapping("OUT2");
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    AddMockNetwork();
+    int status;
+    double inargs[1] = {0}, outargs[2] = {0};
+
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_FAILURE_WITH_MSG);
+    EXPECT_STREQ((const char*)*(ULONG_PTR*)outargs, "Element not found: OUT2 (did you mean 'OUT1'?)");
+    EXPECT_EQ(SwmmMock_GetIndexCallCount(), 1);   // only the miss falls back to swmm_getIndex
+    EXPECT_EQ(SwmmMock_GetStartCallCount(), 0);   // resolution happens before swmm_start
+    EXPECT_EQ(SwmmMock_GetCloseCallCount(), 1);
+    std::remove("model.inp");
+}
+
+static void WritePolicyMapping(const char* policy) {
+    std::ofstream f("SwmmGoldSimBridge.json");
+    f << "{\"version\": \"1.0\", \"logging_level\": \"OFF\", \"plan_cache\": false,\n"
+         " \"output_policy\": \"" << policy << "\", \"report_file\": \"policy.rpt\", \"output_file\": \"\",\n"
+         " \"inputs\": [{\"index\": 0, \"name\": \"RG1\", \"object_type\": \"GAGE\", \"property\": \"RAINFALL\"},\n"
+         "            {\"index\": 1, \"name\": \"P1\", \"object_type\": \"PUMP\", \"property\": \"SETTING\"}],\n"
+         " \"outputs\": [{\"index\": 0, \"name\": \"J2\", \"object_type\": \"JUNCTION\", \"property\": \"DEPTH\"}]}";
+}
+
+static void AddPolicyNetwork() {
+    AddMockNetwork();
+    SwmmMock_AddObject(swmm_SUBCATCH, "S1");
+    SwmmMock_AddObject(swmm_LINK, "C1");
+    SwmmMock_AddObject(swmm_LINK, "P1");
+}
+
+TEST(BridgeMockTests, MappedOutputPolicyReportsOnlyMappedElements) {
+    WriteBytes("model.inp", "[TITLE]\nMapped output policy\n");
+    WritePolicyMapping("MAPPED");
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    AddPolicyNetwork();
+    int status;
+    double inargs[2] = {0}, outargs[1] = {0};
+
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_STREQ(SwmmMock_GetLastReportFile(), "policy.rpt");
+    EXPECT_STREQ(SwmmMock_GetLastOutputFile(), "");
+    EXPECT_EQ(SwmmMock_GetLastStartSaveFlag(), 1);
+    EXPECT_EQ(SwmmMock_GetLateReportFlagCount(), 0);
+    EXPECT_EQ(SwmmMock_GetReportFlag(swmm_SUBCATCH, 0), 0.0);
+    EXPECT_EQ(SwmmMock_GetReportFlag(swmm_NODE, 0), 0.0);   // J1
+    EXPECT_EQ(SwmmMock_GetReportFlag(swmm_NODE, 1), 1.0);   // J2, mapped output
+    EXPECT_EQ(SwmmMock_GetReportFlag(swmm_NODE, 2), 0.0);   // OUT1
+    EXPECT_EQ(SwmmMock_GetReportFlag(swmm_LINK, 0), 0.0);   // C1
+    EXPECT_EQ(SwmmMock_GetReportFlag(swmm_LINK, 1), 1.0);   // P1, mapped input
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    std::remove("model.inp");
+}
+
+TEST(BridgeMockTests, NoneOutputPolicySavesNoResults) {
+    WriteBytes("model.inp", "[TITLE]\nNo output\n");
+    WritePolicyMapping("NONE");
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    AddPolicyNetwork();
+    int status;
+    double inargs[2] = {0}, outargs[1] = {0};
+
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetLastStartSaveFlag(), 0);
+    EXPECT_EQ(SwmmMock_GetReportFlag(swmm_SUBCATCH, 0), 0.0);
+    EXPECT_EQ(SwmmMock_GetReportFlag(swmm_NODE, 1), 0.0);
+    EXPECT_EQ(SwmmMock_GetReportFlag(swmm_NODE, 2), 0.0);
+    EXPECT_EQ(SwmmMock_GetReportFlag(swmm_LINK, 1), 0.0);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+
+    // FULL leaves the model's [REPORT] settings alone
+    WriteBytes("model.inp", "[TITLE]\nFull output\n");
+    WritePolicyMapping("FULL");
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    AddPolicyNetwork();
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetLastStartSaveFlag(), 1);
+    EXPECT_EQ(SwmmMock_GetReportFlag(swmm_NODE, 1), -1.0);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+
+    // Unknown policies are rejected
+    WriteBytes("model.inp", "[TITLE]\nBad policy\n");
+    WritePolicyMapping("SOME");
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_FAILURE_WITH_MSG);
+    EXPECT_STREQ((const char*)*(ULONG_PTR*)outargs, "Unknown output_policy: SOME (expected FULL, MAPPED or NONE)");
+    std::remove("model.inp");
+}
+
+TEST(BridgeMockTests, SeriesFileRecordsEachRealization) {
+    WriteBytes("model.inp", "[TITLE]\nSeries recording\n");
+    {
+        std::ofstream f("SwmmGoldSimBridge.json");
+        f << R"({
+  "version": "1.0",
+  "logging_level": "OFF",
+  "plan_cache": false,
+  "series_file": "bridge.series",
+  "inputs": [
+    {"index": 0, "name": "ElapsedTime", "object_type": "SYSTEM", "property": "ELAPSEDTIME"},
+    {"index": 1, "name": "RG1", "object_type": "GAGE", "property": "RAINFALL"}
+  ],
+  "outputs": [
+    {"index": 0, "name": "S1", "object_type": "SUBCATCH", "property": "RUNOFF"}
+  ]
+})";
+    }
+    std::remove("bridge.series");
+    int status;
+    double inargs[2] = {0}, outargs[1] = {0};
+    for (int realization = 0; realization < 2; realization++) {
+        SwmmMock_Reset();
+        SwmmMock_SetSuccessMode();
+        SwmmMock_SetGetValueReturn(1.5 + realization);
+        SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+        ASSERT_EQ(status, XF_SUCCESS);
+        for (int step = 0; step < 3 + realization; step++) {
+            inargs[0] = 60.0 * step;
+            inargs[1] = 0.25 * step;
+            SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);
+            ASSERT_EQ(status, XF_SUCCESS);
+        }
+        SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    }
+
+    SeriesReader reader;
+    std::string error;
+    ASSERT_TRUE(reader.Open("bridge.series", error));
+    EXPECT_EQ(reader.GetInputCount(), 2);
+    EXPECT_EQ(reader.GetOutputCount(), 1);
+    ASSERT_EQ(reader.GetRealizationCount(), 2);
+    EXPECT_EQ(reader.GetRowCount(0), 3);
+    EXPECT_EQ(reader.GetRowCount(1), 4);
+    std::vector<double> rain, runoff;
+    reader.ReadColumn(1, reader.InputColumn(1), rain);
+    reader.ReadColumn(1, reader.OutputColumn(0), runoff);
+    ASSERT_EQ((int)rain.size(), 4);
+    EXPECT_EQ(rain[3], 0.75);
+    EXPECT_EQ(runoff[3], 2.5);
+    reader.Close();
+    std::remove("bridge.series");
+    std::remove("model.inp");
+}
+
+TEST(BridgeMockTests, RecycledProjectIsRestartedNotReopened) {
+    WriteBytes("model.inp", "[TITLE]\nRecycled project\n");
+    {
+        std::ofstream f("SwmmGoldSimBridge.json");
+        f << R"({
+  "version": "1.0",
+  "logging_level": "OFF",
+  "plan_cache": false,
+  "output_policy": "NONE",
+  "recycle_project": true,
+  "inputs": [
+    {"index": 0, "name": "ElapsedTime", "object_type": "SYSTEM", "property": "ELAPSEDTIME"},
+    {"index": 1, "name": "RG1", "object_type": "GAGE", "property": "RAINFALL"}
+  ],
+  "outputs": [
+    {"index": 0, "name": "S1", "object_type": "SUBCATCH", "property": "RUNOFF"}
+  ]
+})";
+    }
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    int status;
+    double inargs[2] = {0.0, 1.25}, outargs[1] = {0};
+    int lookups = 0;
+    for (int realization = 0; realization < 3; realization++) {
+        SwmmMock_SetGetValueReturn(1.5 + realization);
+        SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+        ASSERT_EQ(status, XF_SUCCESS);
+        if (realization == 0) lookups = SwmmMock_GetIndexCallCount() + SwmmMock_GetNameCallCount();
+        for (int step = 0; step < 2; step++) {
+            SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);
+            ASSERT_EQ(status, XF_SUCCESS);
+        }
+        EXPECT_EQ(outargs[0], 1.5 + realization);
+        SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    }
+    EXPECT_EQ(SwmmMock_GetOpenCallCount(), 1);
+    EXPECT_EQ(SwmmMock_GetStartCallCount(), 3);
+    EXPECT_EQ(SwmmMock_GetEndCallCount(), 3);
+    EXPECT_EQ(SwmmMock_GetCloseCallCount(), 0);
+    EXPECT_EQ(SwmmMock_GetIndexCallCount() + SwmmMock_GetNameCallCount(), lookups);
+    EXPECT_EQ(SwmmMock_GetLastSetValueValue(), 1.25);   // inputs still applied after a restart
+
+    // An edited model closes the recycled project and opens the new one
+    WriteBytes("model.inp", "[TITLE]\nRecycled project, edited\n");
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetCloseCallCount(), 1);
+    EXPECT_EQ(SwmmMock_GetOpenCallCount(), 2);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+
+    // Without recycling every realization closes its project again
+    WriteMapping();
+    WriteBytes("model.inp", "[TITLE]\nNot recycled\n");
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    EXPECT_EQ(SwmmMock_GetOpenCallCount(), 3);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    EXPECT_EQ(SwmmMock_GetCloseCallCount(), 3);
+
+    // A recycled project would write a second run into an already finalized output file
+    WriteBytes("model.inp", "[TITLE]\nRecycled with output\n");
+    {
+        std::ofstream f("SwmmGoldSimBridge.json");
+        f << "{\"version\": \"1.0\", \"logging_level\": \"OFF\", \"plan_cache\": false,\n"
+             " \"output_policy\": \"MAPPED\", \"recycle_project\": true,\n"
+             " \"inputs\": [{\"index\": 0, \"name\": \"RG1\", \"object_type\": \"GAGE\", \"property\": \"RAINFALL\"}],\n"
+             " \"outputs\": []}";
+    }
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_FAILURE_WITH_MSG);
+    EXPECT_STREQ((const char*)*(ULONG_PTR*)outargs,
+                 "recycle_project requires output_policy NONE (use series_file for per-realization results)");
+    EXPECT_EQ(SwmmMock_GetOpenCallCount(), 3);
+    std::remove("model.inp");
+}
+
+TEST(BridgeMockTests, HotStartSnapshotIsDiscardedWhenTheModelChanges) {
+    WriteBytes("model.inp", "[TITLE]\nHot start\n");
+    {
+        std::ofstream f("SwmmGoldSimBridge.json");
+        f << R"({
+  "version": "1.0",
+  "logging_level": "OFF",
+  "plan_cache": false,
+  "hotstart_spinup_days": 1.0,
+  "inputs": [
+    {"index": 0, "name": "ElapsedTime", "object_type": "SYSTEM", "property": "ELAPSEDTIME"},
+    {"index": 1, "name": "RG1", "object_type": "GAGE", "property": "RAINFALL"}
+  ],
+  "outputs": [
+    {"index": 0, "name": "S1", "object_type": "SUBCATCH", "property": "RUNOFF"}
+  ]
+})";
+    }
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    int status;
+    double inargs[2] = {0}, outargs[1] = {0};
+
+    // The first realization spins up and captures the snapshot, the second restores it
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    EXPECT_EQ(SwmmMock_GetSaveStateCallCount(), 1);
+    EXPECT_EQ(SwmmMock_GetLoadStateCallCount(), 0);
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    EXPECT_EQ(SwmmMock_GetSaveStateCallCount(), 1);
+    EXPECT_EQ(SwmmMock_GetLoadStateCallCount(), 1);
+
+    // An edited model spins up again instead of restoring the old model's state
+    WriteBytes("model.inp", "[TITLE]\nHot start, edited\n");
+    int steps = SwmmMock_GetStepCallCount();
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    EXPECT_EQ(SwmmMock_GetLoadStateCallCount(), 1);
+    EXPECT_EQ(SwmmMock_GetSaveStateCallCount(), 2);
+    EXPECT_GT(SwmmMock_GetStepCallCount(), steps);
+    std::remove("model.inp");
+}
+
+// Mock outputs for step k of the realization: base + k / 4
+static void SetMockOutputs(double base, int step) {
+    SwmmMock_SetGetValueReturn(base + 0.25 * step);
+}
+
+// Replay `trace` against the bridge; the number of calls that differ from the recording
+static int ReplayTrace(const CallTraceReader& trace, double base) {
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    int mismatches = 0, step = 0;
+    double inargs[2] = {0}, outargs[2] = {0};
+    for (size_t i = 0; i < trace.GetCallCount(); i++) {
+        const CallTraceReader::Call& c = trace.GetCall(i);
+        for (int k = 0; k < c.inputs; k++) inargs[k] = c.inargs[k];
+        if (c.method == XF_CALCULATE) SetMockOutputs(base, step++);
+        int status;
+        SwmmGoldSimBridge(c.method, &status, inargs, outargs);
+        if (status != c.status || memcmp(outargs, c.outargs, (size_t)c.outputs * sizeof(double)) != 0) mismatches++;
+    }
+    return mismatches;
+}
+
+TEST(BridgeMockTests, CallTraceReplaysBitForBit) {
+    WriteBytes("model.inp", "[TITLE]\nCall trace\n");
+    {
+        std::ofstream f("SwmmGoldSimBridge.json");
+        f << R"({
+  "version": "1.0",
+  "logging_level": "OFF",
+  "plan_cache": false,
+  "call_trace": "bridge.gstrace",
+  "inputs": [
+    {"index": 0, "name": "ElapsedTime", "object_type": "SYSTEM", "property": "ELAPSEDTIME"},
+    {"index": 1, "name": "RG1", "object_type": "GAGE", "property": "RAINFALL"}
+  ],
+  "outputs": [
+    {"index": 0, "name": "S1", "object_type": "SUBCATCH", "property": "RUNOFF"}
+  ]
+})";
+    }
+    std::remove("bridge.gstrace");
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    int status;
+    double inargs[2] = {0}, outargs[2] = {0};
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);   // loads the new mapping
+    ASSERT_EQ(status, XF_SUCCESS);
+    for (int step = 0; step < 4; step++) {
+        inargs[0] = 60.0 * step;
+        inargs[1] = 0.5 * step;
+        SetMockOutputs(1.0, step);
+        SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);
+        ASSERT_EQ(status, XF_SUCCESS);
+    }
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    SwmmGoldSimBridge(XF_REP_ARGUMENTS, &status, inargs, outargs);
+    SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);   // not running: XF_FAILURE
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+
+    // Replay a copy: the bridge keeps recording to bridge.gstrace
+    WriteBytes("replay.gstrace", ReadBytes("bridge.gstrace"));
+    CallTraceReader trace;
+    std::string error;
+    ASSERT_TRUE(trace.Open("replay.gstrace", error));
+    EXPECT_FALSE(trace.IsTruncated());
+    EXPECT_EQ(trace.GetHeader().input_count, 2);
+    EXPECT_EQ(trace.GetHeader().output_count, 1);
+    ASSERT_EQ(trace.GetCallCount(), (size_t)9);
+    EXPECT_EQ(trace.GetCall(0).method, XF_INITIALIZE);
+    EXPECT_EQ(trace.GetCall(0).inputs, 0);
+    const CallTraceReader::Call& calc = trace.GetCall(3);
+    ASSERT_EQ(calc.inputs, 2);
+    ASSERT_EQ(calc.outputs, 1);
+    EXPECT_EQ(calc.inargs[1], 1.0);
+    EXPECT_EQ(calc.outargs[0], 1.5);
+    EXPECT_EQ(trace.GetCall(6).outargs[1], 1.0);   // XF_REP_ARGUMENTS: 2 inputs, 1 output
+    EXPECT_EQ(trace.GetCall(7).status, XF_FAILURE);
+    EXPECT_EQ(trace.GetCall(7).outputs, 0);
+
+    EXPECT_EQ(ReplayTrace(trace, 1.0), 0);
+    EXPECT_EQ(ReplayTrace(trace, 2.0), 4);   // every XF_CALCULATE that returned outputs
+    trace.Close();
+    std::remove("replay.gstrace");
+    std::remove("bridge.gstrace");
+    std::remove("model.inp");
+}
+
+TEST(BridgeMockTests, TimelineTracesCallsAndLookAheadSteps) {
+    WriteBytes("model.inp", "[TITLE]\nTimeline\n");
+    {
+        std::ofstream f("SwmmGoldSimBridge.json");
+        f << R"({
+  "version": "1.0",
+  "logging_level": "OFF",
+  "plan_cache": false,
+  "pipelined_stepping": true,
+  "timeline_file": "bridge_timeline.json",
+  "inputs": [
+    {"index": 0, "name": "ElapsedTime", "object_type": "SYSTEM", "property": "ELAPSEDTIME"},
+    {"index": 1, "name": "RG1", "object_type": "GAGE", "property": "RAINFALL"}
+  ],
+  "outputs": [
+    {"index": 0, "name": "S1", "object_type": "SUBCATCH", "property": "RUNOFF"}
+  ]
+})";
+    }
+    std::remove("bridge_timeline.json");
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    int status;
+    double inargs[2] = {0}, outargs[2] = {0};
+    for (int realization = 0; realization < 2; realization++) {
+        SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+        ASSERT_EQ(status, XF_SUCCESS);
+        for (int step = 0; step < 4; step++) {
+            inargs[0] = 60.0 * step;
+            SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);
+            ASSERT_EQ(status, XF_SUCCESS);
+        }
+        SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    }
+
+    // Appended at each XF_CLEANUP, starting with the XF_INITIALIZE that attached it
+    std::string json = ReadBytes("bridge_timeline.json");
+    EXPECT_EQ(json.find("[\n{\"name\":\"process_name\""), (size_t)0);
+    EXPECT_EQ(CountOf(json, "\"name\":\"process_name\""), 1);
+    EXPECT_EQ(CountOf(json, "\"name\":\"XF_INITIALIZE\""), 2);
+    EXPECT_EQ(CountOf(json, "\"name\":\"XF_CALCULATE\""), 8);
+    EXPECT_EQ(CountOf(json, "\"name\":\"XF_CLEANUP\""), 2);
+    EXPECT_EQ(CountOf(json, "\"name\":\"log_flush\""), 2);
+    EXPECT_EQ(CountOf(json, "\"name\":\"lookahead_wait\""), 6);
+    EXPECT_TRUE(CountOf(json, "\"name\":\"swmm_step\"") >= 6);
+    EXPECT_TRUE(CountOf(json, "\"name\":\"worker\"") >= 1);   // look-ahead steps on their own track
+    EXPECT_NE(json.find("\"name\":\"XF_INITIALIZE\",\"cat\":\"bridge\""), std::string::npos);
+    EXPECT_NE(json.find(",\"step\":3}"), std::string::npos);   // realizations count from process start
+    std::remove("bridge_timeline.json");
+    std::remove("model.inp");
+}
+
+int main() {
+    std::cout << "=== Bridge Mock Tests ===" << std::endl;
+    int result = RUN_ALL_TESTS();
+    SwmmLidStub_Cleanup();
+    return result;
+}
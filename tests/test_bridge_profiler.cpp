@@ -0,0 +1,87 @@
+//-----------------------------------------------------------------------------
+//   test_bridge_profiler.cpp
+//
+//   Unit tests for BridgeProfiler (per-phase latency histograms)
+//   Tests: bucket precision, percentiles, disabled mode, JSON summary
+//-----------------------------------------------------------------------------
+
+#include "../include/BridgeProfiler.h"
+#include "gtest_minimal.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+
+TEST(BridgeProfilerTests, BucketsCoverValueWithinThreePercent) {
+    const uint64_t values[] = { 0, 1, 63, 64, 65, 100, 1000, 12345, 999999, 123456789ULL, 1ULL << 40 };
+    for (uint64_t v : values) {
+        int idx = LatencyHistogram::BucketIndex(v);
+        EXPECT_TRUE(idx >= 0 && idx < LatencyHistogram::kBucketCount);
+        uint64_t upper = LatencyHistogram::BucketUpperBound(idx);
+        EXPECT_GE(upper, v);
+        EXPECT_LE((double)(upper - v), 0.032 * (double)v + 1.0);
+    }
+    EXPECT_EQ(LatencyHistogram::BucketIndex(~0ULL), LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(BridgeProfilerTests, PercentilesAndMax) {
+    LatencyHistogram h;
+    for (int i = 1; i <= 1000; i++) h.Record((uint64_t)i * 1000);  // 1..1000 us
+    EXPECT_EQ(h.GetCount(), 1000ULL);
+    EXPECT_EQ(h.GetMax(), 1000000ULL);
+    double p50 = (double)h.GetPercentile(0.50);
+    double p99 = (double)h.GetPercentile(0.99);
+    EXPECT_GE(p50, 500000.0);
+    EXPECT_LE(p50, 500000.0 * 1.032);
+    EXPECT_GE(p99, 990000.0);
+    EXPECT_LE(p99, 1000000.0);
+    EXPECT_EQ(h.GetPercentile(1.0), 1000000ULL);
+
+    h.Reset();
+    EXPECT_EQ(h.GetCount(), 0ULL);
+    EXPECT_EQ(h.GetPercentile(0.5), 0ULL);
+}
+
+TEST(BridgeProfilerTests, DisabledProfilerRecordsNothing) {
+    BridgeProfiler p;
+    EXPECT_FALSE(p.IsEnabled());
+    uint64_t t0 = p.Start();
+    EXPECT_EQ(t0, 0ULL);
+    p.Stop(PH_SWMM_STEP, t0);
+    EXPECT_EQ(p.GetPhase(PH_SWMM_STEP).GetCount(), 0ULL);
+
+    p.SetEnabled(true);
+    t0 = p.Start();
+    p.Stop(PH_SWMM_STEP, t0);
+    EXPECT_EQ(p.GetPhase(PH_SWMM_STEP).GetCount(), 1ULL);
+}
+
+TEST(BridgeProfilerTests, SummaryListsEveryPhase) {
+    const char* path = "test_profile_summary.json";
+    BridgeProfiler p;
+    p.SetEnabled(true);
+    p.CountRealization();
+    p.Record(PH_SWMM_STEP, 2000000);     // 2 ms in SWMM
+    p.Record(PH_OUTPUT_GATHER, 500000);  // 0.5 ms in the bridge
+    p.Record(PH_CALCULATE, 3000000);
+    EXPECT_TRUE(p.WriteSummary(path));
+
+    std::ifstream file(path);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    std::string json = ss.str();
+    file.close();
+    for (int k = 0; k < PH_COUNT; k++) {
+        std::string key = std::string("\"") + BridgeProfiler::PhaseName(k) + "\"";
+        EXPECT_TRUE(json.find(key) != std::string::npos);
+    }
+    EXPECT_TRUE(json.find("\"realizations\": 1") != std::string::npos);
+    EXPECT_TRUE(json.find("\"swmm_ms\": 2.000") != std::string::npos);
+    EXPECT_TRUE(json.find("\"bridge_ms\": 0.500") != std::string::npos);
+    EXPECT_TRUE(json.find("\"bridge_overhead_fraction\": 0.2000") != std::string::npos);
+    remove(path);
+}
+
+int main() {
+    std::cout << "=== BridgeProfiler Tests ===" << std::endl;
+    return RUN_ALL_TESTS();
+}
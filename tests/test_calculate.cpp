@@ -6,10 +6,17 @@
 //-----------------------------------------------------------------------------
 
 #include <iostream>
-#include <windows.h>
+#include <cstdio>
+#include <cstring>
+#include "../include/Platform.h"
 #include <cmath>
 
 // Function pointer type for the bridge function
+// Bridge under test; CMake passes the path of the mock-backed libgsswmm.so
+#ifndef BRIDGE_LIBRARY
+#define BRIDGE_LIBRARY "GSswmm.dll"
+#endif
+
 typedef void (*BridgeFunctionType)(int, int*, double*, double*);
 
 // GoldSim Method IDs
@@ -30,10 +37,10 @@ int main()
     std::cout << std::endl;
 
     // Load the DLL
-    HMODULE hDll = LoadLibraryA("GSswmm.dll");
+    HMODULE hDll = LoadLibraryA(BRIDGE_LIBRARY);
     if (!hDll)
     {
-        std::cerr << "ERROR: Failed to load GSswmm.dll" << std::endl;
+        std::cerr << "ERROR: Failed to load " BRIDGE_LIBRARY << std::endl;
         return 1;
     }
     std::cout << "[PASS] DLL loaded successfully" << std::endl;
@@ -256,7 +263,8 @@ int main()
         }
     }
     
-    std::cout << "  [INFO] Ran " << steps_run << " steps" << std::endl;
+    std::cout << "  [INFO] Ran " << steps_run << " steps"
+              << (ended_naturally ? " (simulation ended)" : " (step limit reached)") << std::endl;
     if (steps_run > 0)
     {
         std::cout << "  [PASS] Simulation ran successfully" << std::endl;
@@ -0,0 +1,185 @@
+//-----------------------------------------------------------------------------
+//   test_calculate_allocations.cpp
+//
+//   Zero-allocation guarantee for steady-state XF_CALCULATE: drives a bridge
+//   built with GSSWMM_ALLOC_TRACKING against the SWMM mock and fails if any
+//   XF_CALCULATE after the first step allocates, including the look-ahead
+//   steps run on the worker thread
+//   Tests: STEP coupling with LID outputs and DEBUG logging, pipelined
+//          stepping with aggregation, series recording, call trace and
+//          profiling, SYNC coupling, warm XF_INITIALIZE with and without
+//          project recycling, per-method counts
+//-----------------------------------------------------------------------------
+
+#include "../include/Platform.h"
+#include "../include/AllocTracker.h"
+#include "gtest_minimal.h"
+#include "swmm_mock.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#define XF_INITIALIZE       0
+#define XF_CALCULATE        1
+#define XF_REP_VERSION      2
+#define XF_REP_ARGUMENTS    3
+#define XF_CLEANUP          99
+
+#define XF_SUCCESS          0
+
+extern "C" void SwmmGoldSimBridge(int methodID, int* status, double* inargs, double* outargs);
+
+static const int kSteps = 500;
+
+// Three inputs (ElapsedTime, RG1, J1 inflow); `outputs` and `options` go into the JSON as is.
+// The bridge reloads its mapping when model.inp changes, so each test gives it a new title.
+static void WriteMapping(const char* title, const char* options, const char* outputs) {
+    {
+        std::ofstream f("model.inp");
+        f << "[TITLE]\n" << title << "\n";
+    }
+    std::ofstream f("SwmmGoldSimBridge.json");
+    f << "{\n  \"version\": \"1.0\",\n  \"plan_cache\": false,\n" << options << R"(
+  "inputs": [
+    {"index": 0, "name": "ElapsedTime", "object_type": "SYSTEM", "property": "ELAPSEDTIME"},
+    {"index": 1, "name": "RG1", "object_type": "GAGE", "property": "RAINFALL"},
+    {"index": 2, "name": "J1", "object_type": "NODE", "property": "LATFLOW"}
+  ],
+  "outputs": [
+)" << outputs << "\n  ]\n}\n";
+}
+
+static const char* kMixedOutputs = R"(    {"index": 0, "name": "S1", "object_type": "SUBCATCH", "property": "RUNOFF"},
+    {"index": 1, "name": "J1", "object_type": "NODE", "property": "DEPTH"},
+    {"index": 2, "name": "C1", "object_type": "LINK", "property": "FLOW"},
+    {"index": 3, "name": "S1/Planter", "object_type": "LID", "property": "STORAGE_VOLUME"},
+    {"index": 4, "name": "S1/Planter", "object_type": "LID", "property": "DRAIN_FLOW"})";
+
+static void ResetMock() {
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+    SwmmLidStub_Initialize(1);
+    SwmmLidStub_AddLidUnit(0, "Planter", 1.0);
+}
+
+static int64_t CalculateAllocations() { return AllocTracker::Get(AllocTracker::M_CALCULATE).allocs; }
+
+/**
+ * @brief Run one realization of kSteps XF_CALCULATE calls
+ * @return allocations charged to XF_CALCULATE after its first step, or -1 if a call failed
+ * @note Call 0 only reports the initial outputs and call 1 is the first step.
+ *       The count is read after XF_CLEANUP so an in-flight look-ahead step is included.
+ */
+static int64_t RunRealization(double elapsed_per_call) {
+    int status;
+    double inargs[3] = {0}, outargs[8] = {0};
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    if (status != XF_SUCCESS) return -1;
+    int64_t after_first_step = 0;
+    for (int step = 0; step < kSteps; step++) {
+        inargs[0] = elapsed_per_call * step;
+        inargs[1] = 0.01 * (step % 7);
+        inargs[2] = 0.5;
+        SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);
+        if (status != XF_SUCCESS) return -1;
+        if (step == 1) after_first_step = CalculateAllocations();
+    }
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    if (status != XF_SUCCESS) return -1;
+    return CalculateAllocations() - after_first_step;
+}
+
+TEST(CalculateAllocationTests, StepCouplingWithLidOutputsAndDebugLogging) {
+    ResetMock();
+    WriteMapping("STEP", R"(  "logging_level": "DEBUG",)", kMixedOutputs);
+    EXPECT_EQ(RunRealization(1.0), (int64_t)0);
+    std::remove("bridge_debug.log");
+}
+
+TEST(CalculateAllocationTests, PipelinedWithAggregationRecordingAndProfiling) {
+    ResetMock();
+    WriteMapping("Pipelined", R"(  "logging_level": "INFO",
+  "pipelined_stepping": true,
+  "profiling": true,
+  "series_file": "alloc.series",
+  "call_trace": "alloc.gstrace",)",
+                 R"(    {"index": 0, "name": "S1", "object_type": "SUBCATCH", "property": "RUNOFF", "aggregation": "MEAN"},
+    {"index": 1, "name": "J1", "object_type": "NODE", "property": "DEPTH", "aggregation": "MAX"},
+    {"index": 2, "name": "C1", "object_type": "LINK", "property": "FLOW", "aggregation": "INTEGRAL"},
+    {"index": 3, "name": "S1/Planter", "object_type": "LID", "property": "STORAGE_VOLUME"})");
+    EXPECT_EQ(RunRealization(1.0), (int64_t)0);
+    std::remove("alloc.series");
+    std::remove("alloc.gstrace");
+    std::remove("bridge_profile.json");
+    std::remove("bridge_debug.log");
+}
+
+TEST(CalculateAllocationTests, SyncCouplingStepsSeveralTimesPerCall) {
+    ResetMock();
+    WriteMapping("SYNC", R"(  "logging_level": "INFO",
+  "coupling_mode": "SYNC",
+  "elapsed_time_units": "DAYS",)",
+                 R"(    {"index": 0, "name": "S1", "object_type": "SUBCATCH", "property": "RUNOFF", "aggregation": "MEAN"},
+    {"index": 1, "name": "J1", "object_type": "NODE", "property": "DEPTH"})");
+    int64_t steps_before = g_mock_state.step_call_count;
+    EXPECT_EQ(RunRealization(900.0), (int64_t)0);   // the mock advances 300 "days" per swmm_step
+    EXPECT_GT(g_mock_state.step_call_count - steps_before, 2 * kSteps);
+    std::remove("bridge_debug.log");
+}
+
+TEST(CalculateAllocationTests, RecycledProjectAllocatesOnlyInInitialize) {
+    ResetMock();
+    WriteMapping("Recycled", R"(  "logging_level": "OFF",
+  "recycle_project": true,
+  "output_policy": "NONE",)",
+                 kMixedOutputs);
+    EXPECT_EQ(RunRealization(1.0), (int64_t)0);
+    AllocStats init = AllocTracker::Get(AllocTracker::M_INITIALIZE);
+    EXPECT_EQ(RunRealization(1.0), (int64_t)0);
+    EXPECT_EQ(RunRealization(1.0), (int64_t)0);
+    // Warm realizations reuse the project, the plan and its buffers
+    EXPECT_EQ(AllocTracker::Get(AllocTracker::M_INITIALIZE).allocs, init.allocs);
+
+    int status;
+    double inargs[3] = {0}, outargs[8] = {0};
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);   // recycling leaves the project open
+}
+
+TEST(CalculateAllocationTests, CountsCallsPerMethod) {
+    ResetMock();
+    WriteMapping("Counts", R"(  "logging_level": "OFF",)", kMixedOutputs);
+    AllocTracker::Reset();
+    int status;
+    double inargs[3] = {0}, outargs[8] = {0};
+    SwmmGoldSimBridge(XF_REP_VERSION, &status, inargs, outargs);
+    SwmmGoldSimBridge(XF_REP_ARGUMENTS, &status, inargs, outargs);
+    EXPECT_EQ(RunRealization(1.0), (int64_t)0);
+    EXPECT_EQ(AllocTracker::Get(AllocTracker::M_REP_VERSION).calls, (int64_t)1);
+    EXPECT_EQ(AllocTracker::Get(AllocTracker::M_REP_ARGUMENTS).calls, (int64_t)1);
+    EXPECT_EQ(AllocTracker::Get(AllocTracker::M_INITIALIZE).calls, (int64_t)1);
+    EXPECT_EQ(AllocTracker::Get(AllocTracker::M_CALCULATE).calls, (int64_t)kSteps);
+    EXPECT_EQ(AllocTracker::Get(AllocTracker::M_CLEANUP).calls, (int64_t)1);
+    // XF_INITIALIZE sees the new model.inp and reloads the mapping, which allocates
+    EXPECT_GT(AllocTracker::Get(AllocTracker::M_INITIALIZE).allocs, (int64_t)0);
+    EXPECT_GT(AllocTracker::Get(AllocTracker::M_INITIALIZE).bytes, (int64_t)0);
+
+    // The next realization reopens the model but keeps the resolved names and the plan
+    AllocStats init = AllocTracker::Get(AllocTracker::M_INITIALIZE);
+    EXPECT_EQ(RunRealization(1.0), (int64_t)0);
+    EXPECT_EQ(AllocTracker::Get(AllocTracker::M_INITIALIZE).allocs, init.allocs);
+
+    // Outside a bridge call nothing is counted
+    AllocStats before = AllocTracker::Get(AllocTracker::M_CALCULATE);
+    std::string* s = new std::string(1000, 'x');
+    delete s;
+    EXPECT_EQ(AllocTracker::Get(AllocTracker::M_CALCULATE).allocs, before.allocs);
+}
+
+int main() {
+    std::cout << "=== XF_CALCULATE Allocation Tests ===" << std::endl;
+    int result = RUN_ALL_TESTS();
+    SwmmLidStub_Cleanup();
+    std::remove("SwmmGoldSimBridge.json");
+    std::remove("model.inp");
+    return result;
+}
@@ -0,0 +1,155 @@
+//-----------------------------------------------------------------------------
+//   test_call_trace.cpp
+//
+//   Unit tests for CallTraceWriter and CallTraceReader (recorded bridge calls)
+//   Tests: round trip through and past the write buffer, error messages,
+//          interrupted files
+//-----------------------------------------------------------------------------
+
+#include "../include/CallTrace.h"
+#include "gtest_minimal.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static const char* kTrace = "test.gstrace";
+
+// Call k: inputs 100k + i, outputs -(100k + o)
+static void RecordCalculates(CallTraceWriter& w, int first, int count, int inputs, int outputs) {
+    std::vector<double> in(inputs), out(outputs);
+    for (int k = first; k < first + count; k++) {
+        for (int i = 0; i < inputs; i++) in[i] = 100.0 * k + i;
+        for (int o = 0; o < outputs; o++) out[o] = -(100.0 * k + o);
+        w.Record(1, 0, in.data(), inputs, out.data(), outputs, NULL);
+    }
+}
+
+TEST(CallTraceTests, RoundTripThroughBuffer) {
+    CallTraceWriter w;
+    std::string error;
+    ASSERT_TRUE(w.Open(kTrace, 0x1234, 0x5678, 3, 2, error));
+    double counts[2] = { 3.0, 2.0 };
+    w.Record(3, 0, NULL, 0, counts, 2, NULL);
+    w.Record(0, 0, NULL, 0, NULL, 0, NULL);
+    // About 2.5 write buffers of XF_CALCULATE calls
+    const int n = (int)(CallTraceWriter::kBufferBytes * 5 / 2 / (sizeof(CallTraceRecord) + 5 * sizeof(double)));
+    RecordCalculates(w, 0, n, 3, 2);
+    w.Record(99, 0, NULL, 0, NULL, 0, NULL);
+    ASSERT_TRUE(w.Flush(error));
+    EXPECT_EQ(w.GetCallCount(), (int64_t)n + 3);
+    w.Close();
+
+    CallTraceReader r;
+    ASSERT_TRUE(r.Open(kTrace, error));
+    EXPECT_FALSE(r.IsTruncated());
+    EXPECT_EQ(r.GetHeader().config_hash, (uint64_t)0x1234);
+    EXPECT_EQ(r.GetHeader().model_hash, (uint64_t)0x5678);
+    EXPECT_EQ(r.GetHeader().input_count, 3);
+    EXPECT_EQ(r.GetHeader().output_count, 2);
+    ASSERT_EQ(r.GetCallCount(), (size_t)n + 3);
+    EXPECT_EQ(r.GetCall(0).method, 3);
+    ASSERT_EQ(r.GetCall(0).outputs, 2);
+    EXPECT_EQ(r.GetCall(0).outargs[1], 2.0);
+    EXPECT_EQ(r.GetCall(1).inputs, 0);
+    EXPECT_EQ(r.GetCall(n + 2).method, 99);
+
+    int wrong = 0;
+    for (int k = 0; k < n; k++) {
+        const CallTraceReader::Call& c = r.GetCall((size_t)k + 2);
+        if (c.method != 1 || c.inputs != 3 || c.outputs != 2 || c.inargs[2] != 100.0 * k + 2 ||
+            c.outargs[1] != -(100.0 * k + 1))
+            wrong++;
+    }
+    EXPECT_EQ(wrong, 0);
+    r.Close();
+    std::remove(kTrace);
+}
+
+TEST(CallTraceTests, CallsWiderThanTheBuffer) {
+    const int wide = (int)(CallTraceWriter::kBufferBytes / sizeof(double)) + 10;
+    CallTraceWriter w;
+    std::string error;
+    ASSERT_TRUE(w.Open(kTrace, 1, 2, 1, wide, error));
+    RecordCalculates(w, 0, 1, 1, 4);
+    RecordCalculates(w, 1, 2, 1, wide);
+    RecordCalculates(w, 3, 1, 1, 4);
+    ASSERT_TRUE(w.Flush(error));
+    w.Close();
+
+    CallTraceReader r;
+    ASSERT_TRUE(r.Open(kTrace, error));
+    ASSERT_EQ(r.GetCallCount(), (size_t)4);
+    EXPECT_EQ(r.GetCall(2).outputs, wide);
+    EXPECT_EQ(r.GetCall(2).outargs[wide - 1], -(200.0 + wide - 1));
+    EXPECT_EQ(r.GetCall(3).inargs[0], 300.0);
+    r.Close();
+    std::remove(kTrace);
+}
+
+TEST(CallTraceTests, ErrorMessagesReplaceOutputs) {
+    CallTraceWriter w;
+    std::string error;
+    ASSERT_TRUE(w.Open(kTrace, 1, 2, 1, 1, error));
+    double in = 4.0;
+    w.Record(1, -1, &in, 1, NULL, 0, "swmm_step failed");   // 16 bytes, no padding
+    w.Record(0, -1, NULL, 0, NULL, 0, "Mapping file not found");
+    w.Record(1, 1, &in, 1, NULL, 0, NULL);
+    RecordCalculates(w, 7, 1, 1, 1);
+    ASSERT_TRUE(w.Flush(error));
+    w.Close();
+
+    CallTraceReader r;
+    ASSERT_TRUE(r.Open(kTrace, error));
+    ASSERT_EQ(r.GetCallCount(), (size_t)4);
+    const CallTraceReader::Call& step = r.GetCall(0);
+    EXPECT_EQ(step.status, -1);
+    EXPECT_EQ(step.inargs[0], 4.0);
+    EXPECT_EQ(std::string(step.message, (size_t)step.message_size), std::string("swmm_step failed"));
+    const CallTraceReader::Call& init = r.GetCall(1);
+    EXPECT_EQ(std::string(init.message, (size_t)init.message_size), std::string("Mapping file not found"));
+    EXPECT_EQ(r.GetCall(2).status, 1);
+    EXPECT_EQ(r.GetCall(2).message_size, 0);
+    EXPECT_EQ(r.GetCall(3).outargs[0], -700.0);   // still aligned after the padded message
+    r.Close();
+    std::remove(kTrace);
+}
+
+TEST(CallTraceTests, InterruptedFileReadsCompleteCalls) {
+    CallTraceWriter w;
+    std::string error;
+    ASSERT_TRUE(w.Open(kTrace, 1, 2, 2, 2, error));
+    RecordCalculates(w, 0, 10, 2, 2);
+    w.Close();   // Close() writes the buffer too
+
+    std::string bytes;
+    {
+        std::ifstream f(kTrace, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream f(kTrace, std::ios::binary);
+        f << bytes.substr(0, bytes.size() - sizeof(double));
+    }
+    CallTraceReader r;
+    ASSERT_TRUE(r.Open(kTrace, error));
+    EXPECT_TRUE(r.IsTruncated());
+    EXPECT_EQ(r.GetCallCount(), (size_t)9);
+    r.Close();
+
+    {
+        std::ofstream f(kTrace, std::ios::binary);
+        f << "not a call trace at all, just some text";
+    }
+    EXPECT_FALSE(r.Open(kTrace, error));
+    EXPECT_TRUE(error.find("Not a call trace") == 0);
+    std::remove(kTrace);
+    EXPECT_FALSE(r.Open(kTrace, error));
+}
+
+int main() {
+    std::cout << "=== CallTrace Tests ===" << std::endl;
+    return RUN_ALL_TESTS();
+}
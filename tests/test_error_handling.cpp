@@ -6,10 +6,18 @@
 //-----------------------------------------------------------------------------
 
 #include <iostream>
-#include <windows.h>
+#include <cstdio>
+#include <cstring>
+#include "../include/Platform.h"
+#include <fstream>
 #include <string>
 
 // Function pointer type for the bridge function
+// Bridge under test; CMake passes the path of the mock-backed libgsswmm.so
+#ifndef BRIDGE_LIBRARY
+#define BRIDGE_LIBRARY "GSswmm.dll"
+#endif
+
 typedef void (*BridgeFunctionType)(int, int*, double*, double*);
 
 // GoldSim Method IDs
@@ -30,10 +38,10 @@ int main()
     std::cout << std::endl;
 
     // Load the DLL
-    HMODULE hDll = LoadLibraryA("GSswmm.dll");
+    HMODULE hDll = LoadLibraryA(BRIDGE_LIBRARY);
     if (!hDll)
     {
-        std::cerr << "ERROR: Failed to load GSswmm.dll" << std::endl;
+        std::cerr << "ERROR: Failed to load " BRIDGE_LIBRARY << std::endl;
         return 1;
     }
     std::cout << "[PASS] DLL loaded successfully" << std::endl;
@@ -64,13 +72,13 @@ int main()
     
     // Note: The current implementation uses hardcoded file paths
     // We'll test by temporarily renaming the model.inp file if it exists
-    bool file_exists = (GetFileAttributesA("model.inp") != INVALID_FILE_ATTRIBUTES);
+    bool file_exists = std::ifstream("model.inp").good();
     bool renamed = false;
     
     if (file_exists)
     {
         // Rename the file temporarily
-        if (MoveFileA("model.inp", "model.inp.backup"))
+        if (std::rename("model.inp", "model.inp.backup") == 0)
         {
             renamed = true;
             std::cout << "  [INFO] Temporarily renamed model.inp to trigger error" << std::endl;
@@ -140,7 +148,7 @@ int main()
     // Restore the file if we renamed it
     if (renamed)
     {
-        MoveFileA("model.inp.backup", "model.inp");
+        std::rename("model.inp.backup", "model.inp");
         std::cout << "  [INFO] Restored model.inp" << std::endl;
     }
     std::cout << std::endl;
@@ -151,7 +159,7 @@ int main()
     
     if (file_exists)
     {
-        if (MoveFileA("model.inp", "model.inp.backup"))
+        if (std::rename("model.inp", "model.inp.backup") == 0)
         {
             renamed = true;
         }
@@ -171,7 +179,7 @@ int main()
     
     if (renamed)
     {
-        MoveFileA("model.inp.backup", "model.inp");
+        std::rename("model.inp.backup", "model.inp");
     }
     std::cout << std::endl;
 
@@ -181,7 +189,7 @@ int main()
     
     if (file_exists)
     {
-        if (MoveFileA("model.inp", "model.inp.backup"))
+        if (std::rename("model.inp", "model.inp.backup") == 0)
         {
             renamed = true;
         }
@@ -214,7 +222,7 @@ int main()
     
     if (renamed)
     {
-        MoveFileA("model.inp.backup", "model.inp");
+        std::rename("model.inp.backup", "model.inp");
     }
     std::cout << std::endl;
 
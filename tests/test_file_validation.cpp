@@ -6,10 +6,17 @@
 //-----------------------------------------------------------------------------
 
 #include <iostream>
-#include <windows.h>
+#include <cstdio>
+#include <cstring>
+#include "../include/Platform.h"
 #include <fstream>
 
 // Function pointer type for the bridge function
+// Bridge under test; CMake passes the path of the mock-backed libgsswmm.so
+#ifndef BRIDGE_LIBRARY
+#define BRIDGE_LIBRARY "GSswmm.dll"
+#endif
+
 typedef void (*BridgeFunctionType)(int, int*, double*, double*);
 
 // GoldSim Method IDs
@@ -99,10 +106,10 @@ int main()
     std::cout << std::endl;
 
     // Load the DLL
-    HMODULE hDll = LoadLibraryA("GSswmm.dll");
+    HMODULE hDll = LoadLibraryA(BRIDGE_LIBRARY);
     if (!hDll)
     {
-        std::cerr << "ERROR: Failed to load GSswmm.dll" << std::endl;
+        std::cerr << "ERROR: Failed to load " BRIDGE_LIBRARY << std::endl;
         std::cerr << "Make sure the DLL is built and in the same directory" << std::endl;
         return 1;
     }
@@ -137,7 +144,7 @@ int main()
     test_count++;
     
     // First, make sure model.inp doesn't exist
-    DeleteFileA("model.inp");
+    std::remove("model.inp");
     
     SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
     if (status == XF_FAILURE_WITH_MSG)
@@ -199,7 +206,7 @@ int main()
     test_count++;
     
     // Delete the file again
-    DeleteFileA("model.inp");
+    std::remove("model.inp");
     
     SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
     if (status == XF_FAILURE_WITH_MSG)
@@ -230,7 +237,7 @@ int main()
     std::cout << std::endl;
 
     // Clean up test file
-    DeleteFileA("model.inp");
+    std::remove("model.inp");
 
     // Clean up DLL
     FreeLibrary(hDll);
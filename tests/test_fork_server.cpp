@@ -0,0 +1,169 @@
+//-----------------------------------------------------------------------------
+//   test_fork_server.cpp
+//
+//   Unit tests for ForkServer (POSIX), and forked realizations of the bridge
+//   running against the SWMM mock
+//   Tests: exit codes, worker limit, shared memory, realizations forked from
+//          a primed bridge
+//-----------------------------------------------------------------------------
+
+#include "../include/ForkServer.h"
+#include "gtest_minimal.h"
+#include "swmm_mock.h"
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+#define XF_INITIALIZE       0
+#define XF_CALCULATE        1
+#define XF_REP_ARGUMENTS    3
+#define XF_CLEANUP          99
+#define XF_SUCCESS          0
+
+extern "C" void SwmmGoldSimBridge(int methodID, int* status, double* inargs, double* outargs);
+
+static int ExitWithTaskModulo(int task, void*) {
+    return task % 3;
+}
+
+TEST(ForkServerTests, ExitCodeIsTaskResult) {
+    ForkServer server;
+    EXPECT_EQ(server.Run(7, 3, ExitWithTaskModulo, NULL), 4);   // tasks 1, 2, 4, 5
+    for (int t = 0; t < 7; t++) EXPECT_EQ(server.GetExitCode(t), t % 3);
+    EXPECT_EQ(server.Run(0, 3, ExitWithTaskModulo, NULL), 0);
+}
+
+struct Concurrency {
+    int running;
+    int peak;
+};
+
+static int CountRunning(int, void* context) {
+    Concurrency* c = (Concurrency*)context;
+    int now = __atomic_add_fetch(&c->running, 1, __ATOMIC_SEQ_CST);
+    int peak = __atomic_load_n(&c->peak, __ATOMIC_SEQ_CST);
+    while (now > peak && !__atomic_compare_exchange_n(&c->peak, &peak, now, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {}
+    usleep(20000);
+    __atomic_sub_fetch(&c->running, 1, __ATOMIC_SEQ_CST);
+    return 0;
+}
+
+TEST(ForkServerTests, AtMostWorkersChildrenRunAtOnce) {
+    Concurrency* c = (Concurrency*)ForkServer::SharedAlloc(sizeof(Concurrency));
+    ASSERT_TRUE(c != NULL);
+    ForkServer server;
+    EXPECT_EQ(server.Run(9, 2, CountRunning, c), 0);
+    EXPECT_EQ(c->running, 0);
+    EXPECT_EQ(c->peak, 2);
+    EXPECT_TRUE(server.GetWallSeconds() >= 0.09);   // 5 rounds of 20 ms
+    ForkServer::SharedFree(c, sizeof(Concurrency));
+}
+
+static int WriteSquare(int task, void* context) {
+    ((double*)context)[task] = (double)task * task;
+    return 0;
+}
+
+TEST(ForkServerTests, ChildrenWriteSharedMemory) {
+    double* squares = (double*)ForkServer::SharedAlloc(16 * sizeof(double));
+    ASSERT_TRUE(squares != NULL);
+    EXPECT_EQ(squares[5], 0.0);   // zero-filled
+    ForkServer server;
+    EXPECT_EQ(server.Run(16, 4, WriteSquare, squares), 0);
+    int wrong = 0;
+    for (int t = 0; t < 16; t++) {
+        if (squares[t] != (double)t * t) wrong++;
+    }
+    EXPECT_EQ(wrong, 0);
+    ForkServer::SharedFree(squares, 16 * sizeof(double));
+}
+
+// What each forked realization saw of the mock it inherited
+struct RealizationResult {
+    int status;
+    int opens, starts, lookups;
+    double output;
+};
+
+static int RunForkedRealization(int task, void* context) {
+    RealizationResult& r = ((RealizationResult*)context)[task];
+    int status;
+    double inargs[2] = {0.0, 1.0}, outargs[1] = {0};
+    SwmmMock_SetGetValueReturn(10.0 + task);
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    r.status = status;
+    if (status == XF_SUCCESS) {
+        SwmmGoldSimBridge(XF_CALCULATE, &status, inargs, outargs);
+        r.status = status;
+        r.output = outargs[0];
+        SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    }
+    r.opens = SwmmMock_GetOpenCallCount();
+    r.starts = SwmmMock_GetStartCallCount();
+    r.lookups = SwmmMock_GetIndexCallCount() + SwmmMock_GetNameCallCount();
+    return r.status == XF_SUCCESS ? 0 : 1;
+}
+
+TEST(ForkServerTests, RealizationsForkedFromPrimedBridgeOnlyRestart) {
+    {
+        std::ofstream f("model.inp");
+        f << "[TITLE]\nForked realizations\n";
+    }
+    {
+        std::ofstream f("SwmmGoldSimBridge.json");
+        f << R"({
+  "version": "1.0",
+  "logging_level": "OFF",
+  "plan_cache": false,
+  "output_policy": "NONE",
+  "recycle_project": true,
+  "inputs": [
+    {"index": 0, "name": "ElapsedTime", "object_type": "SYSTEM", "property": "ELAPSEDTIME"},
+    {"index": 1, "name": "RG1", "object_type": "GAGE", "property": "RAINFALL"}
+  ],
+  "outputs": [
+    {"index": 0, "name": "S1", "object_type": "SUBCATCH", "property": "RUNOFF"}
+  ]
+})";
+    }
+    SwmmMock_Reset();
+    SwmmMock_SetSuccessMode();
+
+    // Prime: mapping, swmm_open and name resolution happen here, once
+    int status;
+    double inargs[2] = {0.0, 1.0}, outargs[2] = {0};
+    SwmmGoldSimBridge(XF_REP_ARGUMENTS, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    ASSERT_EQ(status, XF_SUCCESS);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    int lookups = SwmmMock_GetIndexCallCount() + SwmmMock_GetNameCallCount();
+    EXPECT_EQ(SwmmMock_GetOpenCallCount(), 1);
+
+    const int count = 6;
+    RealizationResult* results = (RealizationResult*)ForkServer::SharedAlloc(count * sizeof(RealizationResult));
+    ASSERT_TRUE(results != NULL);
+    ForkServer server;
+    EXPECT_EQ(server.Run(count, 3, RunForkedRealization, results), 0);
+    for (int t = 0; t < count; t++) {
+        EXPECT_EQ(results[t].status, XF_SUCCESS);
+        EXPECT_EQ(results[t].opens, 1);     // inherited project, not reopened
+        EXPECT_EQ(results[t].starts, 2);    // priming + own realization
+        EXPECT_EQ(results[t].lookups, lookups);
+        EXPECT_EQ(results[t].output, 10.0 + t);
+    }
+    // The parent's project is untouched by its children
+    EXPECT_EQ(SwmmMock_GetStartCallCount(), 1);
+    ForkServer::SharedFree(results, count * sizeof(RealizationResult));
+
+    SwmmGoldSimBridge(XF_INITIALIZE, &status, inargs, outargs);
+    EXPECT_EQ(status, XF_SUCCESS);
+    SwmmGoldSimBridge(XF_CLEANUP, &status, inargs, outargs);
+    std::remove("model.inp");
+    std::remove("SwmmGoldSimBridge.json");
+}
+
+int main() {
+    std::cout << "=== ForkServer Tests ===" << std::endl;
+    return RUN_ALL_TESTS();
+}
@@ -82,7 +82,7 @@ void test_load_valid_json() {
     
     // Verify input mappings
     const auto& inputs = loader.GetInputs();
-    ASSERT_EQ(inputs.size(), 2);
+    ASSERT_EQ(inputs.size(), (size_t)2);
     ASSERT_EQ(inputs[0].interface_index, 0);
     ASSERT_EQ(inputs[0].name, "ElapsedTime");
     ASSERT_EQ(inputs[0].object_type, "SYSTEM");
@@ -95,12 +95,12 @@ void test_load_valid_json() {
     
     // Verify output mappings
     const auto& outputs = loader.GetOutputs();
-    ASSERT_EQ(outputs.size(), 3);
+    ASSERT_EQ(outputs.size(), (size_t)3);
     ASSERT_EQ(outputs[0].interface_index, 0);
     ASSERT_EQ(outputs[0].name, "POND1");
     ASSERT_EQ(outputs[0].object_type, "STORAGE");
     ASSERT_EQ(outputs[0].property, "VOLUME");
-    ASSERT_EQ(outputs[0].swmm_index, 0);
+    ASSERT_EQ(outputs[0].swmm_index, -1);  // resolved by name at XF_INITIALIZE
     
     ASSERT_EQ(outputs[1].interface_index, 1);
     ASSERT_EQ(outputs[1].name, "OUT1");
@@ -160,10 +160,10 @@ void test_missing_required_field() {
     std::string testFile = "test_missing_field.json";
     std::string jsonContent = R"({
   "version": "1.0",
-  "input_count": 1,
-  "output_count": 1,
-  "inputs": [],
-  "outputs": []
+  "inp_file_hash": "test123",
+  "input_count": 0,
+  "output_count": 0,
+  "inputs": []
 })";
     
     createTestJsonFile(testFile, jsonContent);
@@ -174,7 +174,7 @@ void test_missing_required_field() {
     
     ASSERT_FALSE(result);
     ASSERT_FALSE(error.empty());
-    ASSERT_TRUE(error.find("inp_file_hash") != std::string::npos);
+    ASSERT_TRUE(error.find("outputs") != std::string::npos);
     
     std::remove(testFile.c_str());
     std::cout << "PASS: Missing required field" << std::endl;
@@ -228,12 +228,139 @@ void test_empty_file() {
     
     ASSERT_FALSE(result);
     ASSERT_FALSE(error.empty());
-    ASSERT_TRUE(error.find("empty") != std::string::npos);
+    ASSERT_TRUE(error.find("Empty") != std::string::npos);
     
     std::remove(testFile.c_str());
     std::cout << "PASS: Empty file" << std::endl;
 }
 
+//=============================================================================
+// Test: Optional per-output aggregation mode
+//=============================================================================
+void test_output_aggregation() {
+    std::string testFile = "test_aggregation.json";
+    std::string jsonContent = R"({
+  "version": "1.0",
+  "inputs": [
+    {"index": 0, "name": "ElapsedTime", "object_type": "SYSTEM", "property": "ELAPSEDTIME"}
+  ],
+  "outputs": [
+    {"index": 0, "name": "S1", "object_type": "SUBCATCH", "property": "RUNOFF", "aggregation": "MEAN"},
+    {"index": 1, "name": "POND1", "object_type": "STORAGE", "property": "VOLUME"},
+    {"index": 2, "name": "OUT1", "object_type": "OUTFALL", "property": "FLOW", "aggregation": "INTEGRAL"}
+  ]
+})";
+    
+    createTestJsonFile(testFile, jsonContent);
+    
+    MappingLoader loader;
+    std::string error;
+    bool result = loader.LoadFromFile(testFile, error);
+    
+    ASSERT_TRUE(result);
+    const auto& outputs = loader.GetOutputs();
+    ASSERT_EQ(outputs.size(), (size_t)3);
+    ASSERT_EQ(outputs[0].aggregation, "MEAN");
+    ASSERT_EQ(outputs[1].aggregation, "INSTANTANEOUS");
+    ASSERT_EQ(outputs[2].aggregation, "INTEGRAL");
+    ASSERT_EQ(outputs[2].property, "FLOW");
+    
+    std::remove(testFile.c_str());
+    std::cout << "PASS: Output aggregation" << std::endl;
+}
+
+//=============================================================================
+// Test: Optional run options and their defaults
+//=============================================================================
+void test_run_options() {
+    std::string testFile = "test_run_options.json";
+    std::string jsonContent = R"({
+  "version": "1.0",
+  "coupling_mode": "STEP",
+  "pipelined_stepping": true,
+  "hotstart_spinup_days": 30.5,
+  "inputs": [],
+  "outputs": []
+})";
+    
+    createTestJsonFile(testFile, jsonContent);
+    
+    MappingLoader loader;
+    std::string error;
+    ASSERT_TRUE(loader.LoadFromFile(testFile, error));
+    ASSERT_EQ(loader.GetCouplingMode(), "STEP");
+    ASSERT_TRUE(loader.GetPipelinedStepping());
+    ASSERT_EQ(loader.GetHotstartSpinupDays(), 30.5);
+    
+    createTestJsonFile(testFile, R"({"version": "1.0", "inputs": [], "outputs": []})");
+    ASSERT_TRUE(loader.LoadFromFile(testFile, error));
+    ASSERT_EQ(loader.GetElapsedTimeUnits(), "SECONDS");
+    ASSERT_FALSE(loader.GetPipelinedStepping());
+    ASSERT_EQ(loader.GetHotstartSpinupDays(), 0.0);
+    
+    std::remove(testFile.c_str());
+    std::cout << "PASS: Run options" << std::endl;
+}
+
+//=============================================================================
+// Test: Escapes, unknown nested values and brackets inside strings
+//=============================================================================
+void test_escapes_and_unknown_values() {
+    std::string testFile = "test_escapes.json";
+    std::string jsonContent = R"({
+  "version": "1.0",
+  "generator": {"tool": "generate_mapping.py", "args": ["--output", "{S1}", [1, 2]]},
+  "inputs": [
+    {"index": 0, "name": "ElapsedTime", "object_type": "SYSTEM", "property": "ELAPSEDTIME"}
+  ],
+  "outputs": [
+    {"comment": "braces } and ] in a string", "index": 0, "name": "Pond \"A\"\\\u00e9",
+     "object_type": "STORAGE", "property": "VOLUME", "extra": {"nested": [{}]}},
+    {"index": 1, "name": "S1/Rain\/Garden", "object_type": "LID", "property": "STORAGE_VOLUME"}
+  ],
+  "logging_level": "DEBUG"
+})";
+    
+    createTestJsonFile(testFile, jsonContent);
+    
+    MappingLoader loader;
+    std::string error;
+    ASSERT_TRUE(loader.LoadFromFile(testFile, error));
+    const auto& outputs = loader.GetOutputs();
+    ASSERT_EQ(outputs.size(), (size_t)2);
+    ASSERT_EQ(outputs[0].name, "Pond \"A\"\\\xC3\xA9");
+    ASSERT_EQ(outputs[0].property, "VOLUME");
+    ASSERT_EQ(outputs[1].interface_index, 1);
+    ASSERT_EQ(outputs[1].name, "S1/Rain/Garden");
+    ASSERT_EQ(loader.GetLoggingLevel(), "DEBUG");
+    
+    std::remove(testFile.c_str());
+    std::cout << "PASS: Escapes and unknown values" << std::endl;
+}
+
+//=============================================================================
+// Test: Syntax errors report the line, missing fields report the entry
+//=============================================================================
+void test_error_locations() {
+    std::string testFile = "test_error_locations.json";
+    createTestJsonFile(testFile, "{\n  \"version\": \"1.0\",\n  \"inputs\": [\n    {\"index\": 0 \"name\": \"x\"}\n  ]\n}");
+    
+    MappingLoader loader;
+    std::string error;
+    ASSERT_FALSE(loader.LoadFromFile(testFile, error));
+    ASSERT_TRUE(error.find("line 4") != std::string::npos);
+    
+    createTestJsonFile(testFile, R"({"version": "1.0", "inputs": [], "outputs": [
+      {"index": 0, "name": "S1", "object_type": "SUBCATCH", "property": "RUNOFF"},
+      {"index": 1, "name": "S2", "object_type": "SUBCATCH"}]})");
+    error.clear();
+    ASSERT_FALSE(loader.LoadFromFile(testFile, error));
+    ASSERT_TRUE(error.find("Missing: property (outputs[1])") != std::string::npos);
+    
+    std::remove(testFile.c_str());
+    std::cout << "PASS: Error locations" << std::endl;
+}
+
 //=============================================================================
 // Test: Load actual SwmmGoldSimBridge.json
 //=============================================================================
@@ -250,7 +377,6 @@ void test_load_actual_mapping_file() {
     ASSERT_TRUE(result);
     ASSERT_TRUE(error.empty());
     ASSERT_TRUE(loader.GetInputCount() >= 1); // At least elapsed time
-    ASSERT_FALSE(loader.GetHash().empty());
     
     std::cout << "PASS: Load actual mapping file" << std::endl;
     std::cout << "  Inputs: " << loader.GetInputCount() << std::endl;
@@ -270,8 +396,16 @@ int main() {
     test_missing_required_field();
     test_count_mismatch();
     test_empty_file();
+    test_output_aggregation();
+    test_run_options();
+    test_escapes_and_unknown_values();
+    test_error_locations();
     test_load_actual_mapping_file();
     
+    if (TestRegistry::Instance().GetFailureCount() > 0) {
+        std::cout << "\n" << TestRegistry::Instance().GetFailureCount() << " assertion(s) failed" << std::endl;
+        return 1;
+    }
     std::cout << "\nAll tests passed!" << std::endl;
     return 0;
 }
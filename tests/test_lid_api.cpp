@@ -129,7 +129,7 @@ TEST_F(LidApiTest, GetLidName_InvalidIndices) {
     
     swmm_getLidUName(9999, 0, name, sizeof(name));
     swmm_getError(errMsg, sizeof(errMsg));
-    EXPECT_GT(strlen(errMsg), 0);
+    EXPECT_GT(strlen(errMsg), (size_t)0);
 }
 
 /**
@@ -198,7 +198,7 @@ TEST_F(LidApiTest, GetStorageVolume_InvalidIndices) {
     EXPECT_EQ(volume, 0.0);
     
     swmm_getError(errMsg, sizeof(errMsg));
-    EXPECT_GT(strlen(errMsg), 0);
+    EXPECT_GT(strlen(errMsg), (size_t)0);
 }
 
 /**
@@ -265,7 +265,7 @@ TEST_F(LidApiTest, ErrorMessages_Retrievable) {
     
     // Retrieve error message
     swmm_getError(errMsg, sizeof(errMsg));
-    EXPECT_GT(strlen(errMsg), 0);
+    EXPECT_GT(strlen(errMsg), (size_t)0);
     EXPECT_NE(strstr(errMsg, "LID API Error"), nullptr);
 }
 
@@ -304,6 +304,68 @@ TEST(LidApiConsistencyTest, ReturnValueConventions) {
     SUCCEED();
 }
 
+// ============================================================================
+// Batched LID API Tests
+// ============================================================================
+
+/**
+ * Test: Total unit count sums all subcatchments
+ */
+TEST_F(LidApiTest, TotalCount_SumsAllSubcatchments) {
+    EXPECT_EQ(swmm_getLidUTotalCount(), 6);
+}
+
+/**
+ * Test: Batch query for a list of pairs matches the scalar getters
+ */
+TEST_F(LidApiTest, BatchStates_MatchesScalarGetters) {
+    SwmmLidStub_SetSurfaceOutflow(0, 1, 0.25);
+    
+    const int subcatch[] = { 4, 0, 3, 0 };
+    const int lid[]      = { 1, 1, 0, 0 };
+    double storage[4], outflow[4];
+    
+    int err = swmm_getLidUStates(4, subcatch, lid, storage, nullptr, outflow, nullptr, nullptr, nullptr);
+    EXPECT_EQ(err, 0);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_DOUBLE_EQ(storage[i], swmm_getLidUStorageVolume(subcatch[i], lid[i]));
+        EXPECT_DOUBLE_EQ(outflow[i], swmm_getLidUSurfaceOutflow(subcatch[i], lid[i]));
+    }
+    EXPECT_DOUBLE_EQ(outflow[1], 0.25);
+}
+
+/**
+ * Test: NULL index arrays return every unit in subcatchment order
+ */
+TEST_F(LidApiTest, BatchStates_AllUnitsInModelOrder) {
+    int total = swmm_getLidUTotalCount();
+    double storage[6];
+    
+    int err = swmm_getLidUStates(total, nullptr, nullptr, storage, nullptr, nullptr, nullptr, nullptr, nullptr);
+    EXPECT_EQ(err, 0);
+    EXPECT_DOUBLE_EQ(storage[0], 125.3);  // S1 InfilTrench
+    EXPECT_DOUBLE_EQ(storage[1], 45.7);   // S1 RainBarrels
+    EXPECT_DOUBLE_EQ(storage[2], 0.0);    // Swale3 Swale
+    EXPECT_DOUBLE_EQ(storage[3], 78.2);   // S4 Planters
+    EXPECT_DOUBLE_EQ(storage[4], 92.1);   // S5 PorousPave
+    EXPECT_DOUBLE_EQ(storage[5], 34.5);   // S5 GreenRoof
+}
+
+/**
+ * Test: Invalid pairs are zero-filled and reported, valid pairs still filled
+ */
+TEST_F(LidApiTest, BatchStates_InvalidPairZeroFilled) {
+    const int subcatch[] = { 0, 9999, 1 };
+    const int lid[]      = { 0, 0, 0 };
+    double storage[3] = { -1.0, -1.0, -1.0 };
+    
+    int err = swmm_getLidUStates(3, subcatch, lid, storage, nullptr, nullptr, nullptr, nullptr, nullptr);
+    EXPECT_NE(err, 0);
+    EXPECT_DOUBLE_EQ(storage[0], 125.3);
+    EXPECT_DOUBLE_EQ(storage[1], 0.0);
+    EXPECT_DOUBLE_EQ(storage[2], 0.0);   // S2 has no LID units
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -6,9 +6,16 @@
 //-----------------------------------------------------------------------------
 
 #include <iostream>
-#include <windows.h>
+#include <cstdio>
+#include <cstring>
+#include "../include/Platform.h"
 
 // Function pointer type for the bridge function
+// Bridge under test; CMake passes the path of the mock-backed libgsswmm.so
+#ifndef BRIDGE_LIBRARY
+#define BRIDGE_LIBRARY "GSswmm.dll"
+#endif
+
 typedef void (*BridgeFunctionType)(int, int*, double*, double*);
 
 // GoldSim Method IDs
@@ -29,10 +36,10 @@ int main()
     std::cout << std::endl;
 
     // Load the DLL
-    HMODULE hDll = LoadLibraryA("GSswmm.dll");
+    HMODULE hDll = LoadLibraryA(BRIDGE_LIBRARY);
     if (!hDll)
     {
-        std::cerr << "ERROR: Failed to load GSswmm.dll" << std::endl;
+        std::cerr << "ERROR: Failed to load " BRIDGE_LIBRARY << std::endl;
         std::cerr << "Make sure the DLL is built and in the same directory" << std::endl;
         return 1;
     }
@@ -62,14 +69,14 @@ int main()
     std::cout << "Test 1: XF_REP_VERSION" << std::endl;
     test_count++;
     SwmmGoldSimBridge(XF_REP_VERSION, &status, inargs, outargs);
-    if (status == XF_SUCCESS && outargs[0] == 4.00)
+    if (status == XF_SUCCESS && outargs[0] == 5.212)
     {
         std::cout << "  [PASS] Version = " << outargs[0] << ", Status = " << status << std::endl;
         pass_count++;
     }
     else
     {
-        std::cout << "  [FAIL] Expected version 4.00 and status 0, got version " 
+        std::cout << "  [FAIL] Expected version 5.212 and status 0, got version " 
                   << outargs[0] << " and status " << status << std::endl;
     }
     std::cout << std::endl;
@@ -0,0 +1,81 @@
+//-----------------------------------------------------------------------------
+//   test_name_index.cpp
+//
+//   Unit tests for NameIndex (element name hash table)
+//   Tests: lookup, case-insensitivity, duplicates, growth, near-miss suggestions
+//-----------------------------------------------------------------------------
+
+#include "../include/NameIndex.h"
+#include "gtest_minimal.h"
+#include <string>
+
+TEST(NameIndexTests, FindsAddedNames) {
+    NameIndex index;
+    EXPECT_EQ(index.Find("J1"), -1);
+    EXPECT_TRUE(index.Add("J1", 0));
+    EXPECT_TRUE(index.Add("J2", 1));
+    EXPECT_TRUE(index.Add("Outfall_1", 2));
+    EXPECT_EQ(index.GetCount(), 3);
+    EXPECT_EQ(index.Find("J1"), 0);
+    EXPECT_EQ(index.Find("J2"), 1);
+    EXPECT_EQ(index.Find("Outfall_1"), 2);
+    EXPECT_EQ(index.Find("J3"), -1);
+    EXPECT_EQ(index.Find(""), -1);
+    EXPECT_EQ(index.Find("J"), -1);
+    EXPECT_EQ(index.Find("J11"), -1);
+}
+
+TEST(NameIndexTests, IgnoresCaseLikeSwmm) {
+    NameIndex index;
+    index.Add("Pond_A", 4);
+    EXPECT_EQ(index.Find("POND_A"), 4);
+    EXPECT_EQ(index.Find("pond_a"), 4);
+
+    // The first index wins for names that differ only in case
+    EXPECT_FALSE(index.Add("POND_A", 9));
+    EXPECT_EQ(index.Find("Pond_A"), 4);
+    EXPECT_EQ(index.GetCount(), 1);
+}
+
+TEST(NameIndexTests, GrowsToManyNames) {
+    NameIndex index;
+    const int n = 100000;
+    index.Reserve(n / 4);   // less than needed: Add must still grow
+    for (int i = 0; i < n; i++) EXPECT_TRUE(index.Add(("N" + std::to_string(i)).c_str(), i));
+    EXPECT_EQ(index.GetCount(), n);
+    int wrong = 0;
+    for (int i = 0; i < n; i++) {
+        if (index.Find("n" + std::to_string(i)) != i) wrong++;
+    }
+    EXPECT_EQ(wrong, 0);
+    EXPECT_EQ(index.Find("N" + std::to_string(n)), -1);
+
+    index.Clear();
+    EXPECT_EQ(index.GetCount(), 0);
+    EXPECT_EQ(index.Find("N1"), -1);
+}
+
+TEST(NameIndexTests, SuggestsNearMisses) {
+    NameIndex index;
+    index.Add("OUT1", 0);
+    index.Add("StorageUnit", 1);
+    index.Add("Junction_12", 2);
+    index.Add("J1", 3);
+
+    EXPECT_STREQ(index.Suggest("OUT2").c_str(), "OUT1");
+    EXPECT_STREQ(index.Suggest("StorgeUnit").c_str(), "StorageUnit");
+    EXPECT_STREQ(index.Suggest("junction_21").c_str(), "Junction_12");
+    EXPECT_STREQ(index.Suggest("J2").c_str(), "J1");
+
+    // Too far from anything in the model
+    EXPECT_STREQ(index.Suggest("Pump7").c_str(), "");
+    EXPECT_STREQ(index.Suggest("CompletelyDifferent").c_str(), "");
+
+    NameIndex empty;
+    EXPECT_STREQ(empty.Suggest("OUT1").c_str(), "");
+}
+
+int main() {
+    std::cout << "=== NameIndex Tests ===" << std::endl;
+    return RUN_ALL_TESTS();
+}
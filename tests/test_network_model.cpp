@@ -0,0 +1,247 @@
+//-----------------------------------------------------------------------------
+//   test_network_model.cpp
+//
+//   Unit tests for the synthetic network generator in swmm_test_models.h
+//   Tests: tree layout and depth, element references in the .inp file,
+//          looped networks, rainfall patterns, matching mapping file
+//-----------------------------------------------------------------------------
+
+#include "../include/MappingLoader.h"
+#include "gtest_minimal.h"
+#include "swmm_test_models.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using SwmmTestModels::NetworkLayout;
+using SwmmTestModels::NetworkSpec;
+
+typedef std::vector<std::string> Row;
+
+// Section name -> rows of whitespace-separated tokens, comments skipped
+static std::map<std::string, std::vector<Row>> ReadSections(const char* path) {
+    std::map<std::string, std::vector<Row>> sections;
+    std::ifstream file(path);
+    std::string line, section;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == ';') continue;
+        if (line[0] == '[') {
+            section = line.substr(1, line.find(']') - 1);
+            sections[section];
+            continue;
+        }
+        std::stringstream ss(line);
+        Row row;
+        std::string token;
+        while (ss >> token) row.push_back(token);
+        if (!row.empty()) sections[section].push_back(row);
+    }
+    return sections;
+}
+
+static std::set<std::string> Names(const std::vector<Row>& rows) {
+    std::set<std::string> names;
+    for (const Row& r : rows) names.insert(r[0]);
+    return names;
+}
+
+TEST(NetworkModelTests, TreeFitsRequestedDepth) {
+    const int sizes[] = { 1, 10, 1000, 100000 };
+    const int depths[] = { 1, 3, 8 };
+    for (int n : sizes) {
+        for (int depth : depths) {
+            NetworkSpec spec(n);
+            spec.depth = depth;
+            NetworkLayout net(spec);
+            int deepest = 0, top = 0, bad_parent = 0;
+            for (int k = 0; k < n; k++) {
+                deepest = std::max(deepest, net.level[k]);
+                if (net.parent[k] < 0) top++;
+                if (net.parent[k] >= k) bad_parent++;
+            }
+            EXPECT_TRUE(deepest <= depth);
+            EXPECT_EQ(bad_parent, 0);
+            EXPECT_EQ(top, std::min(n, net.branching));
+            if (depth > 1 && n > net.branching) EXPECT_TRUE(deepest > 1);
+        }
+    }
+    NetworkSpec spec(100000);
+    spec.depth = 8;
+    EXPECT_EQ(NetworkLayout(spec).branching, 5);   // 5 + 25 + ... + 5^8 >= 100000 > 4 + ... + 4^8
+}
+
+TEST(NetworkModelTests, EveryReferenceNamesAnElement) {
+    NetworkSpec spec(500);
+    spec.depth = 4;
+    spec.rain_gages = 3;
+    SwmmTestModels::TestFixture fixture("network_refs");
+    ASSERT_TRUE(fixture.CreateNetwork(spec));
+    auto sec = ReadSections(fixture.GetModelPath());
+
+    std::set<std::string> nodes = Names(sec["JUNCTIONS"]), storage = Names(sec["STORAGE"]);
+    nodes.insert(storage.begin(), storage.end());
+    nodes.insert("OF1");
+    EXPECT_EQ((int)nodes.size(), 501);
+    EXPECT_EQ((int)storage.size(), 50);
+
+    // 500 subcatchments, each with subareas and infiltration, draining to an existing node
+    EXPECT_EQ((int)sec["SUBCATCHMENTS"].size(), 500);
+    EXPECT_EQ((int)sec["SUBAREAS"].size(), 500);
+    EXPECT_EQ((int)sec["INFILTRATION"].size(), 500);
+    std::set<std::string> gages = Names(sec["RAINGAGES"]);
+    EXPECT_EQ((int)gages.size(), 3);
+    int bad = 0;
+    for (const Row& r : sec["SUBCATCHMENTS"]) {
+        if (!nodes.count(r[2]) || !gages.count(r[1])) bad++;
+    }
+    EXPECT_EQ(bad, 0);
+
+    // One link per node, all ending at existing nodes; conduits, orifices and weirs have cross sections
+    const char* link_sections[] = { "CONDUITS", "PUMPS", "ORIFICES", "WEIRS" };
+    int links = 0;
+    std::set<std::string> needs_xsection;
+    for (const char* s : link_sections) {
+        for (const Row& r : sec[s]) {
+            links++;
+            if (!nodes.count(r[1]) || !nodes.count(r[2]) || r[1] == r[2]) bad++;
+            if (std::string(s) != "PUMPS") needs_xsection.insert(r[0]);
+        }
+    }
+    EXPECT_EQ(bad, 0);
+    EXPECT_EQ(links, 500);
+    EXPECT_TRUE(Names(sec["XSECTIONS"]) == needs_xsection);
+    EXPECT_TRUE(!sec["PUMPS"].empty() && !sec["ORIFICES"].empty() && !sec["WEIRS"].empty());
+
+    // LID units reference the defined control and existing subcatchments
+    std::set<std::string> subcatch = Names(sec["SUBCATCHMENTS"]);
+    EXPECT_EQ((int)sec["LID_USAGE"].size(), 100);
+    for (const Row& r : sec["LID_USAGE"]) {
+        if (!subcatch.count(r[0]) || r[1] != "BioCell") bad++;
+    }
+    EXPECT_EQ(bad, 0);
+    EXPECT_EQ(sec["OPTIONS"][2][1], std::string("DYNWAVE"));
+}
+
+TEST(NetworkModelTests, LoopedNetworkCrossConnectsLevels) {
+    NetworkSpec spec(300);
+    spec.depth = 3;
+    spec.routing = "KINWAVE";
+    SwmmTestModels::TestFixture fixture("network_loops");
+    ASSERT_TRUE(fixture.CreateNetwork(spec));
+    auto sec = ReadSections(fixture.GetModelPath());
+    EXPECT_EQ(sec["OPTIONS"][2][1], std::string("KINWAVE"));
+    for (const Row& r : sec["CONDUITS"]) EXPECT_TRUE(r[0][0] == 'C');
+
+    spec.looped = true;
+    ASSERT_TRUE(fixture.CreateNetwork(spec));
+    sec = ReadSections(fixture.GetModelPath());
+    EXPECT_EQ(sec["OPTIONS"][2][1], std::string("DYNWAVE"));   // loops need dynamic wave
+    NetworkLayout net(spec);
+    int cross = 0, wrong_level = 0;
+    for (const Row& r : sec["CONDUITS"]) {
+        if (r[0][0] != 'X') continue;
+        cross++;
+        int k = std::stoi(r[0].substr(1));
+        if (net.level[k] != net.level[k + 1] || r[2] != net.NodeName(k + 1)) wrong_level++;
+    }
+    EXPECT_EQ(cross, (int)net.cross.size());
+    EXPECT_TRUE(cross >= 20);
+    EXPECT_EQ(wrong_level, 0);
+}
+
+TEST(NetworkModelTests, RainPatternsShapeEachGage) {
+    NetworkSpec spec(20);
+    spec.rain_gages = 2;
+    spec.duration_hours = 4.0;
+    SwmmTestModels::TestFixture fixture("network_rain");
+
+    // Series rows are "TSg h:mm value"; 4 hours in 5-minute steps is 49 rows per gage
+    auto series = [&](const char* name) {
+        std::vector<double> v;
+        auto sec = ReadSections(fixture.GetModelPath());
+        for (const Row& r : sec["TIMESERIES"]) {
+            if (r[0] == name) v.push_back(std::stod(r[2]));
+        }
+        return v;
+    };
+
+    spec.rain = SwmmTestModels::RAIN_BLOCK;
+    ASSERT_TRUE(fixture.CreateNetwork(spec));
+    std::vector<double> block = series("TS1");
+    ASSERT_EQ((int)block.size(), 49);
+    EXPECT_EQ(block[0], 1.0);
+    EXPECT_EQ(block[23], 1.0);
+    EXPECT_EQ(block[24], 0.0);   // storm is the first 2 hours
+
+    spec.rain = SwmmTestModels::RAIN_TRIANGLE;
+    ASSERT_TRUE(fixture.CreateNetwork(spec));
+    std::vector<double> tri = series("TS1");
+    EXPECT_EQ(tri[0], 0.0);
+    EXPECT_EQ(tri[8], 2.0);      // peak at 40 min
+    EXPECT_TRUE(series("TS2") == tri);
+
+    spec.rain = SwmmTestModels::RAIN_MOVING;
+    ASSERT_TRUE(fixture.CreateNetwork(spec));
+    std::vector<double> first = series("TS1"), second = series("TS2");
+    EXPECT_EQ(first[8], 2.0);
+    EXPECT_EQ(second[6], 0.0);   // starts 30 minutes later
+    EXPECT_TRUE(second[7] > 0.0);
+    EXPECT_EQ(second[14], 2.0);
+}
+
+TEST(NetworkModelTests, MappingMatchesModel) {
+    NetworkSpec spec(200);
+    spec.looped = true;
+    spec.map_controls = true;
+    SwmmTestModels::TestFixture fixture("network_map");
+    ASSERT_TRUE(fixture.CreateNetwork(spec));
+    ASSERT_TRUE(SwmmTestModels::CreateNetworkMapping("network_map.json", spec));
+    auto sec = ReadSections(fixture.GetModelPath());
+
+    MappingLoader mapping;
+    std::string error;
+    ASSERT_TRUE(mapping.LoadFromFile("network_map.json", error));
+    NetworkLayout net(spec);
+    int controls = (int)(sec["PUMPS"].size() + sec["ORIFICES"].size() + sec["WEIRS"].size());
+    int lids = (int)sec["LID_USAGE"].size();
+    EXPECT_EQ(mapping.GetInputCount(), 1 + spec.rain_gages + controls);
+    EXPECT_EQ(mapping.GetOutputCount(), 200 + 201 + 200 + (int)net.cross.size() + lids);
+
+    // Every mapped element exists in the section its object type implies
+    std::map<std::string, std::set<std::string>> by_type;
+    by_type["GAGE"] = Names(sec["RAINGAGES"]);
+    by_type["SUBCATCH"] = Names(sec["SUBCATCHMENTS"]);
+    by_type["JUNCTION"] = Names(sec["JUNCTIONS"]);
+    by_type["STORAGE"] = Names(sec["STORAGE"]);
+    by_type["OUTFALL"] = Names(sec["OUTFALLS"]);
+    by_type["CONDUIT"] = Names(sec["CONDUITS"]);
+    by_type["PUMP"] = Names(sec["PUMPS"]);
+    by_type["ORIFICE"] = Names(sec["ORIFICES"]);
+    by_type["WEIR"] = Names(sec["WEIRS"]);
+    for (const Row& r : sec["LID_USAGE"]) by_type["LID"].insert(r[0] + "/" + r[1]);
+    by_type["SYSTEM"].insert("ElapsedTime");
+
+    int missing = 0;
+    for (const auto& in : mapping.GetInputs()) {
+        if (!by_type[in.object_type].count(in.name)) missing++;
+    }
+    for (const auto& out : mapping.GetOutputs()) {
+        if (!by_type[out.object_type].count(out.name)) missing++;
+    }
+    EXPECT_EQ(missing, 0);
+
+    spec.map_nodes = spec.map_links = spec.map_lid = spec.map_controls = false;
+    ASSERT_TRUE(SwmmTestModels::CreateNetworkMapping("network_map.json", spec));
+    ASSERT_TRUE(mapping.LoadFromFile("network_map.json", error));
+    EXPECT_EQ(mapping.GetInputCount(), 1 + spec.rain_gages);
+    EXPECT_EQ(mapping.GetOutputCount(), 200);
+    std::remove("network_map.json");
+}
+
+int main() {
+    std::cout << "=== Network Model Generator Tests ===" << std::endl;
+    return RUN_ALL_TESTS();
+}
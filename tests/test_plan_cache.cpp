@@ -0,0 +1,168 @@
+//-----------------------------------------------------------------------------
+//   test_plan_cache.cpp
+//
+//   Unit tests for PlanCache (compiled mapping file)
+//   Tests: round trip, hash and format checks, truncation, file hashing
+//-----------------------------------------------------------------------------
+
+#include "../include/PlanCache.h"
+#include "gtest_minimal.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+static const char* kPlan = "test.plan";
+
+// Zeroed first so members added later are empty, not uninitialized
+static PlanSettings MakeSettings() {
+    PlanSettings s;
+    memset(&s, 0, sizeof(s));
+    s.log_level = 3;
+    s.coupling_mode = 1;
+    s.pipelined = 0;
+    s.profiling = 1;
+    s.elapsed_to_days = 1.0 / 1440.0;
+    s.spinup_days = 2.5;
+    s.output_policy = 1;
+    strcpy(s.report_file, "/dev/shm/run.rpt");
+    return s;
+}
+
+static void MakeRecords(std::vector<PlanRecord>& in, std::vector<PlanRecord>& out) {
+    PlanRecord elapsed = { 0, 100, -1, 0, -1, 0, 0 };
+    PlanRecord rain = { 1, 0, 0, 0, -1, 0, 0 };
+    PlanRecord runoff = { 0, 1, 104, 7, -1, 0, 1 };
+    PlanRecord lid = { 1, 1, -1, 3, 2, 1, 4 };
+    in = { elapsed, rain };
+    out = { runoff, lid };
+}
+
+static void WriteFile(const char* path, const std::string& text) {
+    std::ofstream f(path, std::ios::binary);
+    f << text;
+}
+
+TEST(PlanCacheTests, RoundTrip) {
+    std::vector<PlanRecord> in, out;
+    MakeRecords(in, out);
+    std::string error;
+    ASSERT_TRUE(PlanCache::Save(kPlan, 11, 22, MakeSettings(), in, out, error));
+
+    PlanCache cache;
+    std::string reason;
+    ASSERT_TRUE(cache.Load(kPlan, 11, 22, reason));
+    ASSERT_EQ(cache.GetInputCount(), 2);
+    ASSERT_EQ(cache.GetOutputCount(), 2);
+    EXPECT_EQ(cache.GetSettings().log_level, 3);
+    EXPECT_EQ(cache.GetSettings().coupling_mode, 1);
+    EXPECT_EQ(cache.GetSettings().profiling, 1);
+    EXPECT_DOUBLE_EQ(cache.GetSettings().elapsed_to_days, 1.0 / 1440.0);
+    EXPECT_DOUBLE_EQ(cache.GetSettings().spinup_days, 2.5);
+    EXPECT_EQ(cache.GetSettings().output_policy, 1);
+    EXPECT_STREQ(cache.GetSettings().report_file, "/dev/shm/run.rpt");
+    EXPECT_STREQ(cache.GetSettings().output_file, "");
+    EXPECT_EQ(cache.GetInputs()[0].prop_enum, -1);
+    EXPECT_EQ(cache.GetInputs()[1].iface_idx, 1);
+    EXPECT_EQ(cache.GetOutputs()[0].obj_type, 1);
+    EXPECT_EQ(cache.GetOutputs()[0].swmm_idx, 7);
+    EXPECT_EQ(cache.GetOutputs()[0].aggregation, 1);
+    EXPECT_EQ(cache.GetOutputs()[1].lid_idx, 2);
+    EXPECT_EQ(cache.GetOutputs()[1].accessor, 1);
+    cache.Close();
+
+    // Saving again replaces the mapped-and-closed file in place
+    out.pop_back();
+    ASSERT_TRUE(PlanCache::Save(kPlan, 11, 22, MakeSettings(), in, out, error));
+    ASSERT_TRUE(cache.Load(kPlan, 11, 22, reason));
+    EXPECT_EQ(cache.GetOutputCount(), 1);
+    cache.Close();
+    std::remove(kPlan);
+}
+
+TEST(PlanCacheTests, RejectsChangedHashes) {
+    std::vector<PlanRecord> in, out;
+    MakeRecords(in, out);
+    std::string error, reason;
+    ASSERT_TRUE(PlanCache::Save(kPlan, 11, 22, MakeSettings(), in, out, error));
+
+    PlanCache cache;
+    EXPECT_FALSE(cache.Load(kPlan, 12, 22, reason));
+    EXPECT_STREQ(reason.c_str(), "mapping file changed");
+    EXPECT_FALSE(cache.Load(kPlan, 11, 23, reason));
+    EXPECT_STREQ(reason.c_str(), "model file changed");
+    EXPECT_TRUE(cache.Load(kPlan, 11, 22, reason));
+    cache.Close();
+    std::remove(kPlan);
+}
+
+TEST(PlanCacheTests, RejectsMissingCorruptAndTruncatedFiles) {
+    PlanCache cache;
+    std::string reason, error;
+    std::remove(kPlan);
+    EXPECT_FALSE(cache.Load(kPlan, 11, 22, reason));
+    EXPECT_STREQ(reason.c_str(), "no plan file");
+
+    WriteFile(kPlan, "");
+    EXPECT_FALSE(cache.Load(kPlan, 11, 22, reason));
+
+    WriteFile(kPlan, std::string(200, 'x'));
+    EXPECT_FALSE(cache.Load(kPlan, 11, 22, reason));
+    EXPECT_STREQ(reason.c_str(), "not a plan file");
+
+    // Drop the last record
+    std::vector<PlanRecord> in, out;
+    MakeRecords(in, out);
+    ASSERT_TRUE(PlanCache::Save(kPlan, 11, 22, MakeSettings(), in, out, error));
+    std::string bytes;
+    {
+        std::ifstream f(kPlan, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    WriteFile(kPlan, bytes.substr(0, bytes.size() - sizeof(PlanRecord)));
+    EXPECT_FALSE(cache.Load(kPlan, 11, 22, reason));
+    EXPECT_STREQ(reason.c_str(), "truncated plan file");
+
+    // A different format version
+    bytes[4] = (char)(bytes[4] + 1);
+    WriteFile(kPlan, bytes);
+    EXPECT_FALSE(cache.Load(kPlan, 11, 22, reason));
+    EXPECT_STREQ(reason.c_str(), "written by a different bridge version");
+    std::remove(kPlan);
+}
+
+TEST(PlanCacheTests, FileHashTracksContents) {
+    const char* path = "hash_me.inp";
+    uint64_t a = 0, b = 0, c = 0, d = 0;
+    WriteFile(path, "[TITLE]\nModel A\n");
+    ASSERT_TRUE(PlanCache::HashFile(path, a));
+    ASSERT_TRUE(PlanCache::HashFile(path, b));
+    EXPECT_EQ(a, b);
+
+    WriteFile(path, "[TITLE]\nModel B\n");
+    ASSERT_TRUE(PlanCache::HashFile(path, c));
+    EXPECT_NE(a, c);
+
+    // Trailing zero bytes still change the hash
+    WriteFile(path, std::string("[TITLE]\nModel A\n") + std::string(8, '\0'));
+    ASSERT_TRUE(PlanCache::HashFile(path, d));
+    EXPECT_NE(a, d);
+
+    // Larger than one read buffer
+    std::string big(200000, 'q');
+    WriteFile(path, big);
+    ASSERT_TRUE(PlanCache::HashFile(path, a));
+    big[150000] = 'r';
+    WriteFile(path, big);
+    ASSERT_TRUE(PlanCache::HashFile(path, b));
+    EXPECT_NE(a, b);
+
+    std::remove(path);
+    EXPECT_FALSE(PlanCache::HashFile(path, a));
+}
+
+int main() {
+    std::cout << "=== PlanCache Tests ===" << std::endl;
+    return RUN_ALL_TESTS();
+}
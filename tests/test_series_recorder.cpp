@@ -0,0 +1,183 @@
+//-----------------------------------------------------------------------------
+//   test_series_recorder.cpp
+//
+//   Unit tests for SeriesRecorder and SeriesReader (columnar output series)
+//   Tests: round trip across chunks, realization segments, decimation,
+//          interrupted files, chunk sizing
+//-----------------------------------------------------------------------------
+
+#include "../include/SeriesRecorder.h"
+#include "../include/SeriesReader.h"
+#include "gtest_minimal.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static const char* kSeries = "test.series";
+
+// Row r: time r, inputs 100r + i, outputs -(100r + o)
+static void RecordRows(SeriesRecorder& rec, int first, int count, int inputs, int outputs) {
+    std::vector<double> in(inputs), out(outputs);
+    for (int r = first; r < first + count; r++) {
+        for (int i = 0; i < inputs; i++) in[i] = 100.0 * r + i;
+        for (int o = 0; o < outputs; o++) out[o] = -(100.0 * r + o);
+        rec.Record((double)r, in.data(), out.data());
+    }
+}
+
+TEST(SeriesRecorderTests, RoundTripAcrossChunks) {
+    SeriesRecorder rec;
+    std::string error;
+    ASSERT_TRUE(rec.Begin(kSeries, 2, 3, 1, error));
+    const int chunk = rec.GetChunkRows();
+    const int n = chunk * 2 + chunk / 2;
+    RecordRows(rec, 0, n, 2, 3);
+    ASSERT_TRUE(rec.End(error));
+    EXPECT_EQ(rec.GetRowCount(), (int64_t)n);
+
+    SeriesReader reader;
+    ASSERT_TRUE(reader.Open(kSeries, error));
+    EXPECT_EQ(reader.GetInputCount(), 2);
+    EXPECT_EQ(reader.GetOutputCount(), 3);
+    EXPECT_FALSE(reader.IsTruncated());
+    ASSERT_EQ(reader.GetRealizationCount(), 1);
+    EXPECT_EQ(reader.GetRowCount(0), (int64_t)n);
+
+    std::vector<SeriesReader::Span> spans;
+    reader.GetColumn(0, reader.OutputColumn(2), spans);
+    ASSERT_EQ((int)spans.size(), 3);
+    EXPECT_EQ(spans[1].first_step, (int64_t)chunk);
+    EXPECT_EQ(spans[2].rows, chunk / 2);
+    EXPECT_EQ(spans[1].values[0], -(100.0 * chunk + 2));
+
+    std::vector<double> time, input1, output0;
+    reader.ReadColumn(0, SeriesReader::TimeColumn(), time);
+    reader.ReadColumn(0, reader.InputColumn(1), input1);
+    reader.ReadColumn(0, reader.OutputColumn(0), output0);
+    ASSERT_EQ((int)time.size(), n);
+    int wrong = 0;
+    for (int r = 0; r < n; r++) {
+        if (time[r] != r || input1[r] != 100.0 * r + 1 || output0[r] != -100.0 * r) wrong++;
+    }
+    EXPECT_EQ(wrong, 0);
+    reader.Close();
+    std::remove(kSeries);
+}
+
+TEST(SeriesRecorderTests, RealizationsAppendAsSegments) {
+    SeriesRecorder rec;
+    std::string error;
+    ASSERT_TRUE(rec.Begin(kSeries, 1, 1, 1, error));
+    RecordRows(rec, 0, 10, 1, 1);
+    ASSERT_TRUE(rec.End(error));
+    ASSERT_TRUE(rec.Begin(kSeries, 1, 1, 1, error));   // records nothing
+    ASSERT_TRUE(rec.End(error));
+    ASSERT_TRUE(rec.Begin(kSeries, 1, 1, 1, error));
+    EXPECT_EQ(rec.GetRealization(), 2);
+    RecordRows(rec, 50, 5, 1, 1);
+    ASSERT_TRUE(rec.End(error));
+
+    SeriesReader reader;
+    ASSERT_TRUE(reader.Open(kSeries, error));
+    ASSERT_EQ(reader.GetRealizationCount(), 3);
+    EXPECT_EQ(reader.GetRowCount(0), 10);
+    EXPECT_EQ(reader.GetRowCount(1), 0);
+    EXPECT_EQ(reader.GetRowCount(2), 5);
+    std::vector<double> time;
+    reader.ReadColumn(2, SeriesReader::TimeColumn(), time);
+    ASSERT_EQ((int)time.size(), 5);
+    EXPECT_EQ(time[0], 50.0);
+    reader.Close();
+
+    // A different interface starts a new file
+    ASSERT_TRUE(rec.Begin(kSeries, 1, 2, 1, error));
+    RecordRows(rec, 0, 3, 1, 2);
+    ASSERT_TRUE(rec.End(error));
+    ASSERT_TRUE(reader.Open(kSeries, error));
+    EXPECT_EQ(reader.GetRealizationCount(), 1);
+    EXPECT_EQ(reader.GetOutputCount(), 2);
+    reader.Close();
+    std::remove(kSeries);
+}
+
+TEST(SeriesRecorderTests, DecimationKeepsEveryNthCall) {
+    SeriesRecorder rec;
+    std::string error;
+    ASSERT_TRUE(rec.Begin(kSeries, 0, 1, 3, error));
+    RecordRows(rec, 0, 10, 0, 1);
+    ASSERT_TRUE(rec.End(error));
+
+    SeriesReader reader;
+    ASSERT_TRUE(reader.Open(kSeries, error));
+    EXPECT_EQ(reader.GetDecimation(), 3);
+    std::vector<double> time;
+    reader.ReadColumn(0, SeriesReader::TimeColumn(), time);
+    ASSERT_EQ((int)time.size(), 4);
+    EXPECT_EQ(time[1], 3.0);
+    EXPECT_EQ(time[3], 9.0);
+    reader.Close();
+    std::remove(kSeries);
+}
+
+TEST(SeriesRecorderTests, InterruptedFileReadsCompleteChunks) {
+    SeriesRecorder rec;
+    std::string error;
+    ASSERT_TRUE(rec.Begin(kSeries, 1, 1, 1, error));
+    const int chunk = rec.GetChunkRows();
+    RecordRows(rec, 0, chunk + 7, 1, 1);
+    ASSERT_TRUE(rec.End(error));
+
+    std::string bytes;
+    {
+        std::ifstream f(kSeries, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream f(kSeries, std::ios::binary);
+        f << bytes.substr(0, bytes.size() - sizeof(double));
+    }
+    SeriesReader reader;
+    ASSERT_TRUE(reader.Open(kSeries, error));
+    EXPECT_TRUE(reader.IsTruncated());
+    EXPECT_EQ(reader.GetRowCount(0), (int64_t)chunk);
+    reader.Close();
+
+    {
+        std::ofstream f(kSeries, std::ios::binary);
+        f << "not a series file at all, just some text";
+    }
+    EXPECT_FALSE(reader.Open(kSeries, error));
+    EXPECT_TRUE(error.find("Not a series file") == 0);
+    std::remove(kSeries);
+    EXPECT_FALSE(reader.Open(kSeries, error));
+}
+
+TEST(SeriesRecorderTests, WideInterfacesUseShortChunks) {
+    SeriesRecorder rec;
+    std::string error;
+    ASSERT_TRUE(rec.Begin(kSeries, 1, 100000, 1, error));
+    EXPECT_EQ(rec.GetChunkRows(), SeriesRecorder::kMinChunkRows);
+    RecordRows(rec, 0, 40, 1, 100000);
+    ASSERT_TRUE(rec.End(error));
+
+    SeriesReader reader;
+    ASSERT_TRUE(reader.Open(kSeries, error));
+    std::vector<double> last;
+    reader.ReadColumn(0, reader.OutputColumn(99999), last);
+    ASSERT_EQ((int)last.size(), 40);
+    EXPECT_EQ(last[39], -(100.0 * 39 + 99999));
+    reader.Close();
+    std::remove(kSeries);
+
+    ASSERT_TRUE(rec.Begin(kSeries, 1, 1, 1, error));
+    EXPECT_EQ(rec.GetChunkRows(), SeriesRecorder::kMaxChunkRows);
+    ASSERT_TRUE(rec.End(error));
+    std::remove(kSeries);
+}
+
+int main() {
+    std::cout << "=== SeriesRecorder Tests ===" << std::endl;
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,83 @@
+//-----------------------------------------------------------------------------
+//   test_step_worker.cpp
+//
+//   Unit tests for StepWorker (look-ahead stepping thread)
+//   Tests: job result, overlap with the caller, restart after Stop
+//-----------------------------------------------------------------------------
+
+#include "../include/StepWorker.h"
+#include "gtest_minimal.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+static std::atomic<int> s_runs(0);
+static std::thread::id s_job_thread;
+
+static int CountingJob() {
+    s_job_thread = std::this_thread::get_id();
+    return ++s_runs;
+}
+
+// Latch between the caller and LatchedJob: the job starts, then waits for the
+// caller's work to finish before it returns
+static std::atomic<bool> s_job_started(false);
+static std::atomic<bool> s_caller_done(false);
+
+static int LatchedJob() {
+    s_job_started = true;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!s_caller_done) {
+        if (std::chrono::steady_clock::now() > deadline) return -1;   // caller was blocked by Submit()
+        std::this_thread::yield();
+    }
+    return -7;
+}
+
+TEST(StepWorkerTests, WaitReturnsJobResult) {
+    StepWorker worker;
+    worker.Start();
+    s_runs = 0;
+    worker.Submit(CountingJob);
+    EXPECT_EQ(worker.Wait(), 1);
+    worker.Submit(CountingJob);
+    EXPECT_EQ(worker.Wait(), 2);
+    EXPECT_TRUE(s_job_thread != std::this_thread::get_id());
+    EXPECT_FALSE(worker.IsBusy());
+    worker.Stop();
+    EXPECT_FALSE(worker.IsRunning());
+}
+
+TEST(StepWorkerTests, JobOverlapsCaller) {
+    StepWorker worker;
+    worker.Start();
+    s_job_started = false;
+    s_caller_done = false;
+    worker.Submit(LatchedJob);
+    while (!s_job_started) std::this_thread::yield();
+    EXPECT_TRUE(worker.IsBusy());   // the caller's own work runs while the job is in flight
+    s_caller_done = true;
+    EXPECT_EQ(worker.Wait(), -7);   // the job only finished after the caller's work
+    worker.Stop();
+}
+
+TEST(StepWorkerTests, StopWaitsForInFlightJobAndRestarts) {
+    StepWorker worker;
+    worker.Start();
+    s_runs = 0;
+    worker.Submit(CountingJob);
+    worker.Stop();
+    EXPECT_EQ(s_runs.load(), 1);
+    EXPECT_EQ(worker.Wait(), 1);
+
+    worker.Start();
+    EXPECT_TRUE(worker.IsRunning());
+    worker.Submit(CountingJob);
+    EXPECT_EQ(worker.Wait(), 2);
+    worker.Stop();
+}
+
+int main() {
+    std::cout << "=== StepWorker Tests ===" << std::endl;
+    return RUN_ALL_TESTS();
+}
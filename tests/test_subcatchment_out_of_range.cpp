@@ -7,10 +7,17 @@
 //-----------------------------------------------------------------------------
 
 #include <iostream>
-#include <windows.h>
+#include <cstdio>
+#include <cstring>
+#include "../include/Platform.h"
 #include <fstream>
 
 // Function pointer types
+// Bridge under test; CMake passes the path of the mock-backed libgsswmm.so
+#ifndef BRIDGE_LIBRARY
+#define BRIDGE_LIBRARY "GSswmm.dll"
+#endif
+
 typedef void (*BridgeFunctionType)(int, int*, double*, double*);
 typedef void (*SetSubcatchIndexType)(int);
 
@@ -118,10 +125,10 @@ int main()
     std::cout << std::endl;
 
     // Load the DLL
-    HMODULE hDll = LoadLibraryA("GSswmm.dll");
+    HMODULE hDll = LoadLibraryA(BRIDGE_LIBRARY);
     if (!hDll)
     {
-        std::cerr << "ERROR: Failed to load GSswmm.dll" << std::endl;
+        std::cerr << "ERROR: Failed to load " BRIDGE_LIBRARY << std::endl;
         std::cerr << "Make sure the DLL is built and in the same directory" << std::endl;
         return 1;
     }
@@ -313,7 +320,7 @@ int main()
     }
 
     // Clean up test file
-    DeleteFileA("model.inp");
+    std::remove("model.inp");
 
     // Clean up DLL
     FreeLibrary(hDll);
@@ -0,0 +1,259 @@
+//-----------------------------------------------------------------------------
+//   test_swmm_out_reader.cpp
+//
+//   Unit tests for SwmmOutReader (memory-mapped SWMM .out files)
+//   Tests: header and names, strided series, parallel extraction,
+//          statistics, pollutant variables, rejected files
+//-----------------------------------------------------------------------------
+
+#include "../include/SwmmOutReader.h"
+#include "gtest_minimal.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static const char* kOut = "test.out";
+
+// Writes a file laid out the way SWMM 5 does. Value of variable v of
+// element i of type t in period p: 1000t + 100i + v + p/4.
+struct OutWriter {
+    std::string bytes;
+    void Int(int32_t v) { bytes.append((const char*)&v, sizeof(v)); }
+    void Float(float v) { bytes.append((const char*)&v, sizeof(v)); }
+    void Double(double v) { bytes.append((const char*)&v, sizeof(v)); }
+    void Str(const std::string& s) { Int((int32_t)s.size()); bytes += s; }
+};
+
+static float Value(int t, int i, int v, int p) {
+    return 1000.0f * t + 100.0f * i + v + p / 4.0f;
+}
+
+static void WriteOut(int periods, int subcatch, int nodes, int links, bool pollutant) {
+    const int counts[] = { subcatch, nodes, links, 1 };
+    std::vector<int> codes[] = { { 0, 4 }, { 0, 3, 4, 5 }, { 0, 1, 2 }, { 1, 4, 11 } };
+    if (pollutant) {
+        codes[0].push_back(8);
+        codes[1].push_back(6);
+        codes[2].push_back(5);
+    }
+    OutWriter w;
+    w.Int(516114522);
+    w.Int(51015);
+    w.Int(0);
+    w.Int(subcatch);
+    w.Int(nodes);
+    w.Int(links);
+    w.Int(pollutant ? 1 : 0);
+
+    int32_t id_pos = (int32_t)w.bytes.size();
+    for (int i = 0; i < subcatch; i++) w.Str("S" + std::to_string(i + 1));
+    for (int i = 0; i < nodes; i++) w.Str(i == nodes - 1 ? "OUTFALL_1" : "J" + std::to_string(i + 1));
+    for (int i = 0; i < links; i++) w.Str("C" + std::to_string(i + 1));
+    if (pollutant) {
+        w.Str("TSS");
+        w.Int(0);
+    }
+
+    int32_t prop_pos = (int32_t)w.bytes.size();
+    const int props[] = { 1, 3, 5 };
+    for (int t = 0; t < 3; t++) {
+        w.Int(props[t]);
+        for (int k = 0; k < props[t]; k++) w.Int(k);
+        for (int k = 0; k < props[t] * counts[t]; k++) w.Float(1.5f);
+    }
+    for (int t = 0; t < 4; t++) {
+        w.Int((int32_t)codes[t].size());
+        for (int c : codes[t]) w.Int(c);
+    }
+    w.Double(40000.0);
+    w.Int(300);
+
+    int32_t results_pos = (int32_t)w.bytes.size();
+    for (int p = 0; p < periods; p++) {
+        w.Double(40000.0 + p * 300.0 / 86400.0);
+        for (int t = 0; t < 4; t++) {
+            for (int i = 0; i < counts[t]; i++) {
+                for (int v = 0; v < (int)codes[t].size(); v++) w.Float(Value(t, i, v, p));
+            }
+        }
+    }
+    w.Int(id_pos);
+    w.Int(prop_pos);
+    w.Int(results_pos);
+    w.Int(periods);
+    w.Int(0);
+    w.Int(516114522);
+
+    std::ofstream f(kOut, std::ios::binary);
+    f << w.bytes;
+}
+
+TEST(SwmmOutReaderTests, DecodesHeaderAndNames) {
+    WriteOut(10, 2, 3, 2, false);
+    SwmmOutReader out;
+    std::string error;
+    ASSERT_TRUE(out.Open(kOut, error));
+    EXPECT_EQ(out.GetVersion(), 51015);
+    EXPECT_EQ(out.GetPeriodCount(), 10);
+    EXPECT_EQ(out.GetReportStep(), 300);
+    EXPECT_EQ(out.GetStartDate(), 40000.0);
+    EXPECT_EQ(out.GetCount(OUT_NODE), 3);
+    EXPECT_EQ(out.GetName(OUT_LINK, 1), std::string("C2"));
+    EXPECT_EQ(out.FindElement(OUT_NODE, "OUTFALL_1"), 2);
+    EXPECT_EQ(out.FindElement(OUT_NODE, "J9"), -1);
+    EXPECT_EQ(out.GetVariableCount(OUT_SYSTEM), 3);
+    EXPECT_EQ(out.GetVariableName(OUT_NODE, 2), std::string("TOTAL_INFLOW"));
+
+    // Bridge type and property names resolve to the SWMM variable
+    EXPECT_EQ(SwmmOutReader::TypeFromName("outfall"), (int)OUT_NODE);
+    EXPECT_EQ(SwmmOutReader::TypeFromName("PUMP"), (int)OUT_LINK);
+    EXPECT_EQ(SwmmOutReader::TypeFromName("GAGE"), -1);
+    EXPECT_EQ(out.FindVariable(OUT_NODE, "FLOW"), 2);
+    EXPECT_EQ(out.FindVariable(OUT_NODE, "latflow"), 1);
+    EXPECT_EQ(out.FindVariable(OUT_LINK, "FLOW"), 0);
+    EXPECT_EQ(out.FindVariable(OUT_LINK, "CAPACITY"), -1);   // not reported
+    out.Close();
+    std::remove(kOut);
+}
+
+TEST(SwmmOutReaderTests, SeriesIsStridedViewOfEachPeriod) {
+    WriteOut(50, 2, 3, 2, false);
+    SwmmOutReader out;
+    std::string error;
+    ASSERT_TRUE(out.Open(kOut, error));
+    SwmmOutReader::Series s;
+    ASSERT_TRUE(out.GetSeries(OUT_NODE, 2, 3, s));
+    EXPECT_EQ(s.count, 50);
+    int wrong = 0;
+    for (int p = 0; p < s.count; p++) {
+        if (s[p] != Value(OUT_NODE, 2, 3, p)) wrong++;
+    }
+    EXPECT_EQ(wrong, 0);
+    ASSERT_TRUE(out.GetSeries(OUT_SYSTEM, 0, 2, s));
+    EXPECT_EQ(s[7], Value(OUT_SYSTEM, 0, 2, 7));
+    EXPECT_EQ(out.GetPeriodDate(2), 40000.0 + 600.0 / 86400.0);
+
+    EXPECT_FALSE(out.GetSeries(OUT_NODE, 3, 0, s));
+    EXPECT_FALSE(out.GetSeries(OUT_LINK, 0, 3, s));
+    out.Close();
+    std::remove(kOut);
+}
+
+TEST(SwmmOutReaderTests, ParallelExtractMatchesSeries) {
+    WriteOut(1001, 3, 20, 15, false);
+    SwmmOutReader out;
+    std::string error;
+    ASSERT_TRUE(out.Open(kOut, error));
+    std::vector<SwmmOutReader::Request> requests;
+    for (int i = 0; i < 20; i++) requests.push_back({ OUT_NODE, i, i % 4 });
+    for (int i = 0; i < 15; i++) requests.push_back({ OUT_LINK, i, 0 });
+    requests.push_back({ OUT_SUBCATCH, 2, 1 });
+
+    std::vector<std::vector<float>> serial, parallel;
+    ASSERT_TRUE(out.Extract(requests, serial, 1));
+    ASSERT_TRUE(out.Extract(requests, parallel, 7));
+    ASSERT_EQ(parallel.size(), requests.size());
+    int wrong = 0;
+    for (size_t r = 0; r < requests.size(); r++) {
+        SwmmOutReader::Series s;
+        out.GetSeries(requests[r].type, requests[r].index, requests[r].variable, s);
+        for (int p = 0; p < s.count; p++) {
+            if (parallel[r][p] != s[p] || serial[r][p] != s[p]) wrong++;
+        }
+    }
+    EXPECT_EQ(wrong, 0);
+
+    requests.push_back({ OUT_LINK, 15, 0 });
+    EXPECT_FALSE(out.Extract(requests, parallel, 4));
+    out.Close();
+    std::remove(kOut);
+}
+
+TEST(SwmmOutReaderTests, SummarizeGivesExtremesMeanAndIntegral) {
+    WriteOut(8, 1, 1, 1, false);
+    SwmmOutReader out;
+    std::string error;
+    ASSERT_TRUE(out.Open(kOut, error));
+    SwmmOutReader::Series s;
+    ASSERT_TRUE(out.GetSeries(OUT_LINK, 0, 0, s));
+    SwmmOutReader::Stats st = SwmmOutReader::Summarize(s, out.GetReportStep());
+    // Values 2000 + p/4 for p = 0..7
+    EXPECT_EQ(st.count, 8);
+    EXPECT_EQ(st.min, 2000.0);
+    EXPECT_EQ(st.max, 2001.75);
+    EXPECT_EQ(st.argmax, 7);
+    EXPECT_EQ(st.mean, 2000.875);
+    EXPECT_EQ(st.integral, 16007.0 * 300.0);
+    out.Close();
+    std::remove(kOut);
+}
+
+TEST(SwmmOutReaderTests, PollutantsAreNamedVariables) {
+    WriteOut(4, 2, 2, 2, true);
+    SwmmOutReader out;
+    std::string error;
+    ASSERT_TRUE(out.Open(kOut, error));
+    EXPECT_EQ(out.GetVariableName(OUT_LINK, 3), std::string("TSS"));
+    EXPECT_EQ(out.FindVariable(OUT_SUBCATCH, "tss"), 2);
+    SwmmOutReader::Series s;
+    ASSERT_TRUE(out.GetSeries(OUT_NODE, 1, out.FindVariable(OUT_NODE, "TSS"), s));
+    EXPECT_EQ(s[3], Value(OUT_NODE, 1, 4, 3));
+    out.Close();
+    std::remove(kOut);
+}
+
+TEST(SwmmOutReaderTests, RejectsIncompleteAndForeignFiles) {
+    WriteOut(20, 1, 2, 1, false);
+    std::string bytes;
+    {
+        std::ifstream f(kOut, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    SwmmOutReader out;
+    std::string error;
+
+    // A run that stopped early has no closing records
+    {
+        std::ofstream f(kOut, std::ios::binary);
+        f << bytes.substr(0, bytes.size() - 100);
+    }
+    EXPECT_FALSE(out.Open(kOut, error));
+    EXPECT_TRUE(error.find("Not a SWMM output file") == 0);
+
+    // Period count larger than the results section
+    std::string bad = bytes;
+    int32_t periods = 21;
+    memcpy(&bad[bad.size() - 12], &periods, sizeof(periods));
+    {
+        std::ofstream f(kOut, std::ios::binary);
+        f << bad;
+    }
+    error.clear();
+    EXPECT_FALSE(out.Open(kOut, error));
+    EXPECT_TRUE(error.find("shorter than its period count") != std::string::npos);
+
+    // SWMM error code in the closing records
+    bad = bytes;
+    int32_t code = 200;
+    memcpy(&bad[bad.size() - 8], &code, sizeof(code));
+    {
+        std::ofstream f(kOut, std::ios::binary);
+        f << bad;
+    }
+    error.clear();
+    EXPECT_FALSE(out.Open(kOut, error));
+    EXPECT_TRUE(error.find("error 200") != std::string::npos);
+    EXPECT_EQ(out.GetPeriodCount(), 0);
+
+    std::remove(kOut);
+    error.clear();
+    EXPECT_FALSE(out.Open(kOut, error));
+    EXPECT_TRUE(error.find("Cannot open") == 0);
+}
+
+int main() {
+    std::cout << "=== SwmmOutReader Tests ===" << std::endl;
+    return RUN_ALL_TESTS();
+}
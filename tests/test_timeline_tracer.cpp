@@ -0,0 +1,150 @@
+//-----------------------------------------------------------------------------
+//   test_timeline_tracer.cpp
+//
+//   Unit tests for TimelineTracer (Chrome/Perfetto trace-event timeline)
+//   Tests: spans and their tags, threads, appending writes, dropped spans,
+//          profiler phases
+//-----------------------------------------------------------------------------
+
+#include "../include/TimelineTracer.h"
+#include "../include/BridgeProfiler.h"
+#include "gtest_minimal.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+static const char* kTimeline = "test_timeline.json";
+
+static std::string ReadFile(const char* path) {
+    std::ifstream f(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+static int CountOf(const std::string& text, const std::string& what) {
+    int n = 0;
+    for (size_t pos = text.find(what); pos != std::string::npos; pos = text.find(what, pos + 1)) n++;
+    return n;
+}
+
+TEST(TimelineTracerTests, SpansCarryRealizationAndStep) {
+    std::remove(kTimeline);
+    TimelineTracer t;
+    uint64_t t0 = BridgeProfiler::Now();
+    t.Span("before", t0, t0 + 1000);
+    t.BeginRealization();
+    t.Span("setup", t0 + 1000, t0 + 2000);
+    t.NextStep();
+    t.NextStep();
+    t.Span("swmm_step", t0 + 2000, t0 + 4500);
+    EXPECT_EQ(t.GetRealization(), 0);
+    EXPECT_EQ(t.GetStep(), (int64_t)1);
+
+    std::string error;
+    ASSERT_TRUE(t.Write(kTimeline, error));
+    EXPECT_EQ(t.GetWrittenCount(), (int64_t)3);
+    EXPECT_EQ(t.GetDroppedCount(), (int64_t)0);
+    std::string json = ReadFile(kTimeline);
+    EXPECT_EQ(json.find("[\n{\"name\":\"process_name\""), (size_t)0);
+    EXPECT_EQ(CountOf(json, "\"ph\":\"X\""), 3);
+    EXPECT_NE(json.find("\"name\":\"before\",\"cat\":\"bridge\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{}"), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"realization\":0}"), std::string::npos);
+    EXPECT_NE(json.find("\"dur\":2.500,"), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"realization\":0,\"step\":1}"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"GoldSim calls\""), std::string::npos);
+    std::remove(kTimeline);
+}
+
+TEST(TimelineTracerTests, EachThreadGetsItsOwnTrack) {
+    std::remove(kTimeline);
+    TimelineTracer t;
+    t.BeginRealization();
+    uint64_t t0 = BridgeProfiler::Now();
+    for (int i = 0; i < 10; i++) t.Span("main", t0, t0 + 10);
+    std::thread worker([&]() {
+        for (int i = 0; i < TimelineTracer::kChunkEvents + 5; i++) t.Span("lookahead", t0, t0 + 10);
+    });
+    worker.join();
+
+    std::string error;
+    ASSERT_TRUE(t.Write(kTimeline, error));
+    EXPECT_EQ(t.GetWrittenCount(), (int64_t)(10 + TimelineTracer::kChunkEvents + 5));
+    std::string json = ReadFile(kTimeline);
+    EXPECT_EQ(CountOf(json, "\"name\":\"thread_name\""), 2);
+    EXPECT_EQ(CountOf(json, "\"name\":\"worker\""), 1);
+    EXPECT_EQ(CountOf(json, "\"name\":\"lookahead\""), TimelineTracer::kChunkEvents + 5);
+    std::remove(kTimeline);
+}
+
+TEST(TimelineTracerTests, LaterWritesAppend) {
+    std::remove(kTimeline);
+    TimelineTracer t;
+    uint64_t t0 = BridgeProfiler::Now();
+    std::string error;
+    t.BeginRealization();
+    t.Span("first", t0, t0 + 10);
+    ASSERT_TRUE(t.Write(kTimeline, error));
+    t.BeginRealization();
+    t.Span("second", t0, t0 + 10);
+    t.Span("second", t0, t0 + 10);
+    ASSERT_TRUE(t.Write(kTimeline, error));
+    EXPECT_EQ(t.GetWrittenCount(), (int64_t)2);   // only what was buffered since the last write
+    ASSERT_TRUE(t.Write(kTimeline, error));
+    EXPECT_EQ(t.GetWrittenCount(), (int64_t)0);
+
+    std::string json = ReadFile(kTimeline);
+    EXPECT_EQ(CountOf(json, "\"name\":\"process_name\""), 1);
+    EXPECT_EQ(CountOf(json, "\"name\":\"first\""), 1);
+    EXPECT_EQ(CountOf(json, "\"name\":\"second\""), 2);
+    EXPECT_NE(json.find("\"args\":{\"realization\":1}"), std::string::npos);
+    std::remove(kTimeline);
+
+    EXPECT_FALSE(t.Write("no_such_dir/timeline.json", error));
+    EXPECT_TRUE(error.find("Cannot open") == 0);
+}
+
+TEST(TimelineTracerTests, FullBufferCountsDroppedSpans) {
+    std::remove(kTimeline);
+    TimelineTracer t(32);
+    uint64_t t0 = BridgeProfiler::Now();
+    for (int i = 0; i < 32 + 7; i++) t.Span("s", t0, t0 + 1);
+    std::string error;
+    ASSERT_TRUE(t.Write(kTimeline, error));
+    EXPECT_EQ(t.GetWrittenCount(), (int64_t)32);
+    EXPECT_EQ(t.GetDroppedCount(), (int64_t)7);
+    std::string json = ReadFile(kTimeline);
+    EXPECT_NE(json.find("\"name\":\"spans dropped\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"count\":7}"), std::string::npos);
+    std::remove(kTimeline);
+}
+
+TEST(TimelineTracerTests, ProfilerPhasesBecomeSpans) {
+    std::remove(kTimeline);
+    TimelineTracer t;
+    BridgeProfiler p;
+    uint64_t before = p.Start();   // nothing attached: no clock read, not traced
+    EXPECT_EQ(before, (uint64_t)0);
+    p.SetTimeline(&t);
+    p.Stop(PH_SWMM_STEP, before);
+    uint64_t s = p.Start();
+    p.Stop(PH_SWMM_STEP, s);
+    p.Stop(PH_CALCULATE, s);        // traced by the bridge as the XF_CALCULATE span
+    p.Stop(PH_LOGGING, s);          // part of the enclosing span, not one span per Log()
+    p.Span("log_flush", s);
+    EXPECT_EQ(p.GetPhase(PH_SWMM_STEP).GetCount(), (uint64_t)0);   // histograms stay off
+
+    std::string error;
+    ASSERT_TRUE(t.Write(kTimeline, error));
+    EXPECT_EQ(t.GetWrittenCount(), (int64_t)2);
+    std::string json = ReadFile(kTimeline);
+    EXPECT_EQ(CountOf(json, "\"name\":\"swmm_step\""), 1);
+    EXPECT_EQ(CountOf(json, "\"name\":\"log_flush\""), 1);
+    std::remove(kTimeline);
+}
+
+int main() {
+    std::cout << "=== TimelineTracer Tests ===" << std::endl;
+    return RUN_ALL_TESTS();
+}